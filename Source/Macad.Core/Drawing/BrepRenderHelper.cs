@@ -1,8 +1,7 @@
 ﻿using System;
-using System.Collections.Generic;
-using System.Linq;
 using Macad.Common;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Drawing
 {
@@ -20,88 +19,37 @@ namespace Macad.Core.Drawing
 
         public static bool RenderFaces(IDrawingRenderer renderer, TopoDS_Shape brepShape)
         {
-            var res = true;
-
             renderer.BeginPath();
 
-            var faces = brepShape.Faces();
-            if (faces.Count == 0)
-            {
-                // Drawings may only contain lines, not faces
-                res = RenderEdges(renderer, brepShape.Edges(), null);
-            }
-            else
-            {
-                foreach (var face in faces)
-                {
-
-                    var outerWire = BRepTools.OuterWire(face);
-                    if (outerWire == null)
-                        continue;
-
-                    res &= RenderEdges(renderer, outerWire.Edges(), face);
-
-                    var wires = face.Wires();
-                    foreach (var wire in wires)
-                    {
-                        if (wire.IsEqual(outerWire))
-                            continue;
-                        res &= RenderEdges(renderer, wire.Edges(), face);
-                    }
-
-                }
-            }
+            // Faces, wires and edges are traversed and ordered natively in one call
+            using var paths = DrawingPaths.Build(brepShape, 0.0001);
+            var res = RenderPaths(renderer, paths);
 
             renderer.EndPath();
 
             return res;
         }
-        
+
         //--------------------------------------------------------------------------------------------------
 
-        public static bool RenderEdges(IDrawingRenderer renderer, List<TopoDS_Edge> edges, TopoDS_Face face)
+        public static bool RenderPaths(IDrawingRenderer renderer, DrawingPaths paths)
         {
             var res = true;
 
-            // Order edges
-            var order = new ShapeAnalysis_WireOrder(true, 0.0001);
-            foreach (var edge in edges)
+            var chainCurveStart = paths.ChainCurveStart;
+            var chainIsOrdered = paths.ChainIsOrdered;
+            for (int chain = 0; chain < paths.ChainCount; chain++)
             {
-                var first = BRep_Tool.Pnt(TopExp.FirstVertex(edge));
-                var last = BRep_Tool.Pnt(TopExp.LastVertex(edge));
-                if (edge.Orientation() == TopAbs_Orientation.TopAbs_FORWARD)
-                    order.Add(first.Coord, last.Coord);
-                else
-                    order.Add(last.Coord, first.Coord);
-            }
-            order.Perform(true);
+                if (chainIsOrdered[chain])
+                    renderer.BeginPathSegment();
 
-            if (order.IsDone())
-            {
-                order.SetChains(0.0001);
-                for (int chain = 1; chain <= order.NbChains(); chain++)
+                for (int curve = chainCurveStart[chain]; curve < chainCurveStart[chain + 1]; curve++)
                 {
-                    int startIndex = 0, endIndex = 0;
-                    order.Chain(chain, ref startIndex, ref endIndex);
-                    if(startIndex > endIndex)
-                        continue;
+                    res &= _RenderPathCurve(renderer, paths, curve);
+                }
 
-                    // Process ordered edges
-                    renderer.BeginPathSegment();
-                    for (int index = startIndex; index <= endIndex; index++)
-                    {
-                        int orderIndex = order.Ordered(index);
-                        int originalIndex = Math.Abs(orderIndex) - 1; // order index is 1-based
-                        res &= RenderEdge(renderer, edges[originalIndex], orderIndex < 0, face);
-                    }
+                if (chainIsOrdered[chain])
                     renderer.EndPathSegment();
-                }
-            }
-            else
-            {
-                // Cannot sort, just pump out all edges
-                foreach (var edge in edges)
-                    res &= RenderEdge(renderer, edge, false, face);
             }
 
             return res;
@@ -109,42 +57,34 @@ namespace Macad.Core.Drawing
 
         //--------------------------------------------------------------------------------------------------
 
-        public static bool RenderEdge(IDrawingRenderer renderer, TopoDS_Edge edge, bool reverse, TopoDS_Face face)
+        static bool _RenderPathCurve(IDrawingRenderer renderer, DrawingPaths paths, int index)
         {
-            var res = true;
-
-            reverse ^= edge.Orientation() == TopAbs_Orientation.TopAbs_REVERSED;
+            var data = paths.CurveData;
+            int offset = index * DrawingPaths.DataStride;
+            double first = data[offset];
+            double last = data[offset + 1];
+            bool reverse = paths.CurveReversed[index];
 
-            double first = 0, last = 0;
-            if (face != null)
+            switch (paths.CurveTypes[index])
             {
-                var curve = BRep_Tool.CurveOnSurface(edge, new Geom_Plane(Ax3.XOY), new TopLoc_Location(),  ref first, ref last);
-                if (curve == null)
+                case DrawingCurveType.Missing:
                     return false;
 
-                res &= RenderCurve(renderer, curve, first, last, reverse);
-            }
-            else
-            {
-                if (!(edge.TShape() is BRep_TEdge tedge))
-                    return res;
-
-                var curves = tedge.CurvesList();
-                if(reverse)
-                {
-                    curves.Reverse();
-                }
+                case DrawingCurveType.Line:
+                    var start = new Pnt2d(data[offset + 2], data[offset + 3]);
+                    var end = new Pnt2d(data[offset + 4], data[offset + 5]);
+                    renderer.Line(reverse ? end : start, reverse ? start : end);
+                    return true;
 
-                foreach (var curveOnSurface in curves.OfType<BRep_CurveOnSurface>())
-                {
-                    var curve = curveOnSurface.PCurve();
-                    first = curveOnSurface.First();
-                    last = curveOnSurface.Last();
-                    res &= RenderCurve(renderer, curve, first, last, reverse);
-                }
+                case DrawingCurveType.Circle:
+                    if (renderer.Capabilities.CircleAsCurve)
+                        break;
+                    var center = new Pnt2d(data[offset + 2], data[offset + 3]);
+                    _RenderCircle(renderer, center, data[offset + 4], data[offset + 5], data[offset + 6] > 0, first, last, reverse);
+                    return true;
             }
 
-            return res;
+            return RenderCurve(renderer, paths.Curve(index), first, last, reverse);
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -204,11 +144,16 @@ namespace Macad.Core.Drawing
                 return false;
             }
 
-            var center = circle.Location();
-            var radius = circle.Radius();
             double rotation = circle.XAxis().Direction.Angle(Dir2d.DX);
+            _RenderCircle(renderer, circle.Location(), circle.Radius(), rotation, circle.Position().Sense() > 0, first, last, reverse);
+            return true;
+        }
 
-            if (circle.Position().Sense() > 0)
+        //--------------------------------------------------------------------------------------------------
+
+        static void _RenderCircle(IDrawingRenderer renderer, Pnt2d center, double radius, double rotation, bool isDirect, double first, double last, bool reverse)
+        {
+            if (isDirect)
             {
                 first = Maths.DoublePI - first;
                 last = Maths.DoublePI - last;
@@ -220,8 +165,6 @@ namespace Macad.Core.Drawing
             }
 
             renderer.Circle(center, radius, first - rotation, last - rotation);
-
-            return true;
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -100,12 +100,35 @@ namespace Macad.Core.Drawing
         
         //--------------------------------------------------------------------------------------------------
 
+        // Merges connected pieces of the same line or circle, removes duplicate edges and orders the
+        // edges into chains, which reduces the size of the exported drawing.
+        [SerializeMember]
+        public bool MergeEdges
+        {
+            get { return _MergeEdges; }
+            set
+            {
+                if (_MergeEdges != value)
+                {
+                    SaveUndo();
+                    _MergeEdges = value;
+                    _Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool _MergeEdges;
         bool _UseTriangulation;
         HlrEdgeTypes _IncludedEdgeTypes;
         Ax3 _Projection;
         IBrepSource[] _Sources;
         TopoDS_Shape[] _Shapes;
 
+        const double _MergeTolerance = 0.0001;
+
         //--------------------------------------------------------------------------------------------------
 
         public static HlrDrawing Create(Ax3 projection, HlrEdgeTypes includedEdges, params IBrepSource[] sources)
@@ -161,10 +184,19 @@ namespace Macad.Core.Drawing
             hlrAlgo.Update();
 
             // Fetch layer
-            _CreateLayerShape(LayerType.Outline,       HlrEdgeTypes.VisibleOutline, HlrEdgeTypes.VisibleSharp, hlrAlgo, aabb);
-            _CreateLayerShape(LayerType.Inline,        HlrEdgeTypes.VisibleSmooth,  HlrEdgeTypes.VisibleSewn,  hlrAlgo, aabb);
-            _CreateLayerShape(LayerType.HiddenOutline, HlrEdgeTypes.HiddenOutline,  HlrEdgeTypes.HiddenSharp,  hlrAlgo, aabb);
-            _CreateLayerShape(LayerType.HiddenInline,  HlrEdgeTypes.HiddenSmooth,   HlrEdgeTypes.HiddenSewn,   hlrAlgo, aabb);
+            var optimizer = _MergeEdges ? new HlrEdgeOptimizer(_MergeTolerance) : null;
+            _CreateLayerShape(LayerType.Outline,       HlrEdgeTypes.VisibleOutline, HlrEdgeTypes.VisibleSharp, hlrAlgo, optimizer, aabb);
+            _CreateLayerShape(LayerType.Inline,        HlrEdgeTypes.VisibleSmooth,  HlrEdgeTypes.VisibleSewn,  hlrAlgo, optimizer, aabb);
+            _CreateLayerShape(LayerType.HiddenOutline, HlrEdgeTypes.HiddenOutline,  HlrEdgeTypes.HiddenSharp,  hlrAlgo, optimizer, aabb);
+            _CreateLayerShape(LayerType.HiddenInline,  HlrEdgeTypes.HiddenSmooth,   HlrEdgeTypes.HiddenSewn,   hlrAlgo, optimizer, aabb);
+
+            if (optimizer != null)
+            {
+                Messages.Trace($"HLR edges reduced from {optimizer.InputEdgeCount} to {optimizer.OutputEdgeCount}: "
+                               + $"{optimizer.MergedLineCount} line and {optimizer.MergedArcCount} arc pieces merged, "
+                               + $"{optimizer.DuplicateCount} duplicates removed, {optimizer.ChainCount} chains.");
+                optimizer.Dispose();
+            }
             
             Extents = aabb;
 
@@ -173,7 +205,7 @@ namespace Macad.Core.Drawing
 
         //--------------------------------------------------------------------------------------------------
 
-        void _CreateLayerShape(LayerType layerType, HlrEdgeTypes edgeType1, HlrEdgeTypes edgeType2, HlrBRepAlgoBase hlrAlgo, Bnd_Box2d aabb)
+        void _CreateLayerShape(LayerType layerType, HlrEdgeTypes edgeType1, HlrEdgeTypes edgeType2, HlrBRepAlgoBase hlrAlgo, HlrEdgeOptimizer optimizer, Bnd_Box2d aabb)
         {
             TopoDS_Shape shape = null;
             var shape1 = _IncludedEdgeTypes.Has(edgeType1) ? hlrAlgo.GetResult(edgeType1) : null;
@@ -201,6 +233,11 @@ namespace Macad.Core.Drawing
             if (shape == null) 
                 return;
 
+            if (optimizer != null)
+            {
+                shape = optimizer.Optimize(shape);
+            }
+
             _Shapes[(int) layerType] = shape;
 
             // Update bounding rect
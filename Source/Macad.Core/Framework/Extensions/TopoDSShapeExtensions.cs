@@ -2,6 +2,7 @@
 using System.Diagnostics;
 using System.Linq;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core
 {
@@ -9,20 +10,17 @@ namespace Macad.Core
     {
         public static List<TopoDS_CompSolid> CompSolids(this TopoDS_Shape shape, bool distinct = true)
         {
-            var compSolids = new List<TopoDS_CompSolid>();
+            if (distinct)
+            {
+                return new List<TopoDS_CompSolid>(TopoDSHelper.CompSolids(shape));
+            }
 
+            var compSolids = new List<TopoDS_CompSolid>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_COMPSOLID, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var compSolid = TopoDS.CompSolid(exp.Current());
+                compSolids.Add(TopoDS.CompSolid(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    if (compSolids.Any(e => e.IsSame(compSolid)))
-                        continue;
-                }
-                compSolids.Add(compSolid);
             }
             return compSolids;
         }
@@ -31,20 +29,17 @@ namespace Macad.Core
 
         public static List<TopoDS_Solid> Solids(this TopoDS_Shape shape, bool distinct = true)
         {
-            var solids = new List<TopoDS_Solid>();
+            if (distinct)
+            {
+                return new List<TopoDS_Solid>(TopoDSHelper.Solids(shape));
+            }
 
+            var solids = new List<TopoDS_Solid>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_SOLID, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var solid = TopoDS.Solid(exp.Current());
+                solids.Add(TopoDS.Solid(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    if (solids.Any(e => e.IsSame(solid)))
-                        continue;
-                }
-                solids.Add(solid);
             }
             return solids;
         }
@@ -53,20 +48,17 @@ namespace Macad.Core
 
         public static List<TopoDS_Shell> Shells(this TopoDS_Shape shape, bool distinct = true)
         {
-            var shells = new List<TopoDS_Shell>();
+            if (distinct)
+            {
+                return new List<TopoDS_Shell>(TopoDSHelper.Shells(shape));
+            }
 
+            var shells = new List<TopoDS_Shell>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_SHELL, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var shell = TopoDS.Shell(exp.Current());
+                shells.Add(TopoDS.Shell(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    if (shells.Any(e => e.IsSame(shell)))
-                        continue;
-                }
-                shells.Add(shell);
             }
             return shells;
         }
@@ -76,32 +68,18 @@ namespace Macad.Core
         public static List<TopoDS_Face> Faces(this TopoDS_Shape shape, bool distinct = true)
         {
             Debug.Assert(shape != null);
-            
-            var faces = new List<TopoDS_Face>();
 
+            if (distinct)
+            {
+                return new List<TopoDS_Face>(TopoDSHelper.Faces(shape));
+            }
+
+            var faces = new List<TopoDS_Face>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_FACE, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var face = TopoDS.Face(exp.Current());
+                faces.Add(TopoDS.Face(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    var otherIndex = faces.FindIndex(e => e.IsSame(face));
-                    if (otherIndex >= 0)
-                    {
-                        if (faces[otherIndex].Orientation() == TopAbs_Orientation.TopAbs_REVERSED
-                            && face.Orientation() == TopAbs_Orientation.TopAbs_FORWARD)
-                        {
-                            // Replace with forward face, this is prefered
-                            faces[otherIndex] = face;
-                        }
-
-                        // Edge already present or replaced, skip adding
-                        continue;
-                    }
-                }
-                faces.Add(face);
             }
             return faces;
         }
@@ -110,32 +88,17 @@ namespace Macad.Core
 
         public static List<TopoDS_Wire> Wires(this TopoDS_Shape shape, bool distinct = true)
         {
-            var wires = new List<TopoDS_Wire>();
+            if (distinct)
+            {
+                return new List<TopoDS_Wire>(TopoDSHelper.Wires(shape));
+            }
 
+            var wires = new List<TopoDS_Wire>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_WIRE, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var wire = TopoDS.Wire(exp.Current());
+                wires.Add(TopoDS.Wire(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    var otherEdgeIndex = wires.FindIndex(e => e.IsSame(wire));
-                    if (otherEdgeIndex >= 0)
-                    {
-                        if (wires[otherEdgeIndex].Orientation() == TopAbs_Orientation.TopAbs_REVERSED
-                            && wire.Orientation() == TopAbs_Orientation.TopAbs_FORWARD)
-                        {
-                            // Replace with forward wire, this is prefered
-                            wires[otherEdgeIndex] = wire;
-                        }
-
-                        // Edge already present or replaced, skip adding
-                        continue;
-                    }
-                }
-
-                wires.Add(wire);
             }
             return wires;
         }
@@ -144,32 +107,17 @@ namespace Macad.Core
 
         public static List<TopoDS_Edge> Edges(this TopoDS_Shape shape, bool distinct = true)
         {
-            var edges = new List<TopoDS_Edge>();
+            if (distinct)
+            {
+                return new List<TopoDS_Edge>(TopoDSHelper.Edges(shape));
+            }
 
+            var edges = new List<TopoDS_Edge>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var edge = TopoDS.Edge(exp.Current());
+                edges.Add(TopoDS.Edge(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    var otherEdgeIndex = edges.FindIndex(e => e.IsSame(edge));
-                    if (otherEdgeIndex >= 0)
-                    {
-                        if (edges[otherEdgeIndex].Orientation() == TopAbs_Orientation.TopAbs_REVERSED
-                            && edge.Orientation() == TopAbs_Orientation.TopAbs_FORWARD)
-                        {
-                            // Replace with forward edge, this is prefered
-                            edges[otherEdgeIndex] = edge;
-                        }
-
-                        // Edge already present or replaced, skip adding
-                        continue;
-                    }
-                }
-
-                edges.Add(edge);
             }
             return edges;
         }
@@ -178,24 +126,21 @@ namespace Macad.Core
 
         public static List<TopoDS_Vertex> Vertices(this TopoDS_Shape shape, bool distinct = true)
         {
-            var faces = new List<TopoDS_Vertex>();
+            if (distinct)
+            {
+                return new List<TopoDS_Vertex>(TopoDSHelper.Vertices(shape));
+            }
 
+            var vertices = new List<TopoDS_Vertex>();
             var exp = new TopExp_Explorer(shape, TopAbs_ShapeEnum.TopAbs_VERTEX, TopAbs_ShapeEnum.TopAbs_SHAPE);
             while (exp.More())
             {
-                var vertex = TopoDS.Vertex(exp.Current());
+                vertices.Add(TopoDS.Vertex(exp.Current()));
                 exp.Next();
-
-                if (distinct)
-                {
-                    if (faces.Any(e => e.IsSame(vertex)))
-                        continue;
-                }
-                faces.Add(vertex);
             }
-            return faces;
+            return vertices;
         }
-        
+
         //--------------------------------------------------------------------------------------------------
 
         public static Pnt CenterOfMass(this TopoDS_Shape shape)
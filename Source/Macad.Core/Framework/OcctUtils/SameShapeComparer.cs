@@ -0,0 +1,30 @@
+﻿using System.Collections.Generic;
+using Macad.Occt;
+
+namespace Macad.Core
+{
+    // Compares shapes like TopoDS_Shape.IsSame, by TShape and location, the orientation is ignored.
+    public sealed class SameShapeComparer : IEqualityComparer<TopoDS_Shape>
+    {
+        public static readonly SameShapeComparer Instance = new SameShapeComparer();
+
+        //--------------------------------------------------------------------------------------------------
+
+        public bool Equals(TopoDS_Shape x, TopoDS_Shape y)
+        {
+            if (ReferenceEquals(x, y))
+                return true;
+            if (x == null || y == null)
+                return false;
+            return x.IsSame(y);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        public int GetHashCode(TopoDS_Shape shape)
+        {
+            // The native hash code does not include the orientation
+            return shape.HashCode(int.MaxValue);
+        }
+    }
+}
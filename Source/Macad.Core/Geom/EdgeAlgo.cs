@@ -2,6 +2,7 @@
 using System.Linq;
 using Macad.Common;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Geom
 {
@@ -86,18 +87,13 @@ namespace Macad.Core.Geom
         /// </summary>
         public static (TopoDS_Face smallestFace, TopoDS_Face largestFace) FindSmallestAndLargestAdjacentFaces(TopoDS_Shape shape, TopoDS_Edge edgeShape)
         {
-            // Create a Map of Edge and connected Faces
-            var mapOfEdgesToFaces = new TopTools_IndexedDataMapOfShapeListOfShape(1);
-            TopExp.MapShapesAndAncestors(shape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_FACE, mapOfEdgesToFaces);
-
             var faceDict = new Dictionary<TopoDS_Face, double>();
 
-            var faces = mapOfEdgesToFaces.FindFromKey(edgeShape).ToList();
-            foreach (var face in faces)
+            foreach (var face in GetAdjacentFaces(shape, edgeShape))
             {
                 var gprops = new GProp_GProps();
                 BRepGProp.SurfaceProperties(face, gprops, false);
-                faceDict.Add(face.ToFace(), gprops.Mass());
+                faceDict[face] = gprops.Mass();
             }
 
             if (!faceDict.Any())
@@ -123,18 +119,35 @@ namespace Macad.Core.Geom
         /// </summary>
         public static (TopoDS_Face face1, TopoDS_Face face2) FindAdjacentFaces(TopoDS_Shape shape, TopoDS_Edge edgeShape)
         {
-            // Create a Map of Edge and connected Faces
-            var mapOfEdgesToFaces = new TopTools_IndexedDataMapOfShapeListOfShape(1);
-            TopExp.MapShapesAndAncestors(shape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_FACE, mapOfEdgesToFaces);
-
-            var faces = mapOfEdgesToFaces.FindFromKey(edgeShape).ToList();
-            var face1 = faces.Count > 0 ? faces[0].ToFace() : null;
-            var face2 = faces.Count > 1 ? faces[1].ToFace() : null;
+            var faces = GetAdjacentFaces(shape, edgeShape);
+            var face1 = faces.Count > 0 ? faces[0] : null;
+            var face2 = faces.Count > 1 ? faces[1] : null;
             return (face1, face2);
         }
 
         //--------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Returns all faces of the shape using the edge, empty if the edge is not part of the shape.
+        /// A face is returned once per occurrence of the edge, twice for a seam edge.
+        /// </summary>
+        public static List<TopoDS_Face> GetAdjacentFaces(TopoDS_Shape shape, TopoDS_Edge edgeShape)
+        {
+            var faces = new List<TopoDS_Face>();
+            var topology = TopologyIndex.Get(shape);
+            var edgeIndex = topology.IndexOfEdge(edgeShape);
+            if (edgeIndex < 0)
+                return faces;
+
+            for (int i = 0; i < topology.EdgeFaceCount(edgeIndex); i++)
+            {
+                faces.Add(topology.Face(topology.EdgeFace(edgeIndex, i)));
+            }
+            return faces;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         public static TopoDS_Vertex FindSharedVertex(TopoDS_Edge edge1, TopoDS_Edge edge2)
         {
             var vertices1 = edge1.Vertices();
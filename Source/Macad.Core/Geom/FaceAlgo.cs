@@ -5,6 +5,7 @@ using Macad.Core.Shapes;
 using Macad.Common;
 using Macad.Core.Topology;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Geom
 {
@@ -79,22 +80,25 @@ namespace Macad.Core.Geom
         {
             var list = new Dictionary<TopoDS_Face, TopoDS_Edge>();
 
-            // Get map of all faces with their ancestors
-            var faceMap = new TopTools_IndexedDataMapOfShapeListOfShape(50);
-            TopExp.MapShapesAndAncestors(shape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_FACE, faceMap);
+            var topology = TopologyIndex.Get(shape);
+            var faceIndex = topology.IndexOfFace(face);
+            if (faceIndex < 0)
+                return list;
 
+            var foundFaces = new HashSet<int> { faceIndex };
             foreach (var edge in face.Edges())
             {
-                var faceList = faceMap.FindFromKey(edge).ToList();
-                foreach (var connectedFace in faceList)
-                {
-                    if(connectedFace.IsSame(face))
-                        continue;
+                var edgeIndex = topology.IndexOfEdge(edge);
+                if (edgeIndex < 0)
+                    continue;
 
-                    if(list.Keys.Any(f => connectedFace.IsSame(f)))
+                for (int i = 0; i < topology.EdgeFaceCount(edgeIndex); i++)
+                {
+                    var connectedFaceIndex = topology.EdgeFace(edgeIndex, i);
+                    if (!foundFaces.Add(connectedFaceIndex))
                         continue;
 
-                    list.Add(connectedFace.ToFace(), edge);
+                    list.Add(topology.Face(connectedFaceIndex), edge);
                 }
             }
 
@@ -105,23 +109,27 @@ namespace Macad.Core.Geom
 
         public static TopoDS_Face FindConnectedFace(TopoDS_Shape shape, TopoDS_Face face, TopoDS_Edge sharedEdge)
         {
-            // Get map of all faces with their ancestors
-            var faceMap = new TopTools_IndexedDataMapOfShapeListOfShape(50);
-            TopExp.MapShapesAndAncestors(shape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_FACE, faceMap);
+            var topology = TopologyIndex.Get(shape);
+            var faceIndex = topology.IndexOfFace(face);
+            var edgeIndex = topology.IndexOfEdge(sharedEdge);
+            if (faceIndex < 0 || edgeIndex < 0)
+                return null;
 
-            foreach (var edge in face.Edges())
+            // The edge must bound the face
+            var edgeCount = topology.EdgeFaceCount(edgeIndex);
+            var isSharedEdge = false;
+            for (int i = 0; i < edgeCount; i++)
             {
-                if (edge.IsSame(sharedEdge))
-                {
-                    var faceList = faceMap.FindFromKey(edge).ToList();
-                    foreach (var connectedFace in faceList)
-                    {
-                        if (connectedFace.IsSame(face))
-                            continue;
+                isSharedEdge |= topology.EdgeFace(edgeIndex, i) == faceIndex;
+            }
+            if (!isSharedEdge)
+                return null;
 
-                        return connectedFace.ToFace();
-                    }
-                }
+            for (int i = 0; i < edgeCount; i++)
+            {
+                var connectedFaceIndex = topology.EdgeFace(edgeIndex, i);
+                if (connectedFaceIndex != faceIndex)
+                    return topology.Face(connectedFaceIndex);
             }
             return null;
         }
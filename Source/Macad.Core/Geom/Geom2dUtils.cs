@@ -129,13 +129,8 @@ namespace Macad.Core.Geom
         {
             // Copy control points
             var poleCount = controlPoints.Length;
-            var poles = new TColgp_Array1OfPnt2d(1, poleCount);
-            var weightsCol = weights != null ? new TColStd_Array1OfReal(1, poleCount) : null;
-            for (int i = 0; i < poleCount; i++)
-            {
-                poles.SetValue(i + 1, controlPoints[i]);
-                weightsCol?.SetValue(i + 1, weights[i] );
-            }
+            var poles = new TColgp_Array1OfPnt2d(controlPoints);
+            var weightsCol = weights != null ? new TColStd_Array1OfReal(weights, 0, poleCount) : null;
 
             // Count multiplicities and compact knot list
             var knotList = new List<double>();
@@ -156,14 +151,8 @@ namespace Macad.Core.Geom
             }
 
             // Copy knots and multiplicities
-            var knotCount = knotList.Count;
-            var knotsCol = new TColStd_Array1OfReal(1, knotCount);
-            var multsCol = new TColStd_Array1OfInteger(1, knotCount);
-            for (int i = 0; i < knotCount; i++)
-            {
-                knotsCol.SetValue(i + 1, knotList[i]);
-                multsCol.SetValue(i + 1, multList[i]);
-            }
+            var knotsCol = new TColStd_Array1OfReal(knotList.ToArray());
+            var multsCol = new TColStd_Array1OfInteger(multList.ToArray());
 
             // Create spline
             var spline = weightsCol != null 
@@ -26,6 +26,21 @@ namespace Macad.Core.Geom
 
         //--------------------------------------------------------------------------------------------------
 
+        public enum SliceMethod
+        {
+            /// <summary>
+            /// One boolean operation per cutting plane. This is the default, the slice topology
+            /// is the one all existing references are based on.
+            /// </summary>
+            PerPlane,
+            /// <summary>
+            /// One boolean operation with all cutting planes, the shared setup is done only once.
+            /// </summary>
+            AllPlanes
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         #endregion
 
         #region Properties
@@ -35,6 +50,7 @@ namespace Macad.Core.Geom
         public int SliceCount { get; }
         public Dir SliceDirection { get; private set; }
         public double SliceThickness { get; private set; }
+        public SliceMethod Method { get; set; } = SliceMethod.PerPlane;
 
         public Slice[] Slices
         {
@@ -130,13 +146,37 @@ namespace Macad.Core.Geom
 
         bool _CreateSlices()
         {
-            var sliceInterval = SliceThickness / SliceCount;
+            return Method == SliceMethod.AllPlanes ? _CreateSlicesAllPlanes() : _CreateSlicesPerPlane();
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        Pln _GetCutPlane(int sliceIndex, out TopoDS_Face cutPlaneFace)
+        {
+            var sliceOffset = SliceThickness / SliceCount * (sliceIndex + 0.5);
+            var cutPlane = _RefPlane.Translated(SliceDirection.ToVec().Multiplied(sliceOffset));
+            cutPlaneFace = new TopoDS_Face();
+            new BRep_Builder().MakeFace(cutPlaneFace, new Geom_Plane(cutPlane), 1e-7);
+            return cutPlane;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        Slice _MakeSlice(TopoDS_Shape bodySpaceShape, Pln cutPlane)
+        {
+            // Move to origin
+            var transform = new Trsf(Ax3.XOY, cutPlane.Position);
+            var transformer = new BRepBuilderAPI_Transform(bodySpaceShape, transform, true);
+            return new Slice(transformer.Shape(), cutPlane);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool _CreateSlicesPerPlane()
+        {
             for (int sliceIndex = 0; sliceIndex < SliceCount; sliceIndex++)
             {
-                var sliceOffset = sliceInterval * (sliceIndex + 0.5);
-                var cutPlane = _RefPlane.Translated(SliceDirection.ToVec().Multiplied(sliceOffset));
-                var cutPlaneFace = new TopoDS_Face();
-                new BRep_Builder().MakeFace(cutPlaneFace, new Geom_Plane(cutPlane), 1e-7);
+                var cutPlane = _GetCutPlane(sliceIndex, out var cutPlaneFace);
 
                 // Create contour
                 var common = new BRepAlgoAPI_Common(SourceShape, cutPlaneFace);
@@ -145,16 +185,52 @@ namespace Macad.Core.Geom
                     Messages.Error("Cannot create contour face from shape.");
                     return false;
                 }
-                var bodySpaceShape = common.Shape();
 
-                // Move to origin
-                var transform = new Trsf(Ax3.XOY, cutPlane.Position);
-                var transformer = new BRepBuilderAPI_Transform(bodySpaceShape, transform, true);
-                var shape = transformer.Shape();
+                _Slices[sliceIndex] = _MakeSlice(common.Shape(), cutPlane);
+            }
 
-                var slice = new Slice(shape, cutPlane);
+            return true;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool _CreateSlicesAllPlanes()
+        {
+            var cutPlanes = new Pln[SliceCount];
+            var cutPlaneFaces = new TopoDS_Face[SliceCount];
+            var tools = new TopTools_ListOfShape();
+            for (int sliceIndex = 0; sliceIndex < SliceCount; sliceIndex++)
+            {
+                cutPlanes[sliceIndex] = _GetCutPlane(sliceIndex, out cutPlaneFaces[sliceIndex]);
+                tools.Append(cutPlaneFaces[sliceIndex]);
+            }
+
+            // Create contours of all planes at once
+            var arguments = new TopTools_ListOfShape();
+            arguments.Append(SourceShape);
+
+            var common = new BRepAlgoAPI_Common();
+            common.SetArguments(arguments);
+            common.SetTools(tools);
+            common.Build();
+            if (!common.IsDone())
+            {
+                Messages.Error("Cannot create contour faces from shape.");
+                return false;
+            }
+
+            // Split by plane, the faces of each plane are the splits of its face
+            var builder = new BRep_Builder();
+            for (int sliceIndex = 0; sliceIndex < SliceCount; sliceIndex++)
+            {
+                var bodySpaceShape = new TopoDS_Compound();
+                builder.MakeCompound(bodySpaceShape);
+                foreach (var face in common.Modified(cutPlaneFaces[sliceIndex]).ToList())
+                {
+                    builder.Add(bodySpaceShape, face);
+                }
 
-                _Slices[sliceIndex] = slice;
+                _Slices[sliceIndex] = _MakeSlice(bodySpaceShape, cutPlanes[sliceIndex]);
             }
 
             return true;
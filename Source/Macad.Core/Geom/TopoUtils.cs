@@ -4,6 +4,7 @@ using System.Net;
 using Macad.Common;
 using Macad.Core.Topology;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Geom
 {
@@ -129,11 +130,17 @@ namespace Macad.Core.Geom
 
         public static List<TopoDS_Shape> FindEdgesByVertex(TopoDS_Shape shape, TopoDS_Vertex vertex)
         {
-            // Get map of all faces with their ancestors
-            var edgeMap = new TopTools_IndexedDataMapOfShapeListOfShape(4);
-            TopExp.MapShapesAndAncestors(shape, TopAbs_ShapeEnum.TopAbs_VERTEX, TopAbs_ShapeEnum.TopAbs_EDGE, edgeMap);
+            var edges = new List<TopoDS_Shape>();
+            var topology = TopologyIndex.Get(shape);
+            var vertexIndex = topology.IndexOfVertex(vertex);
+            if (vertexIndex < 0)
+                return edges;
 
-            return edgeMap.FindFromKey(vertex).ToList();
+            for (int i = 0; i < topology.VertexEdgeCount(vertexIndex); i++)
+            {
+                edges.Add(topology.Edge(topology.VertexEdge(vertexIndex, i)));
+            }
+            return edges;
         }
 
         //--------------------------------------------------------------------------------------------------
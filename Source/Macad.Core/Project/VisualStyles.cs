@@ -53,6 +53,7 @@ namespace Macad.Core
         public static readonly Quantity_Color BallMarker = Quantity_NameOfColor.Quantity_NOC_YELLOW.ToColor();
         public static readonly Quantity_Color AttributeMarkerBackground = new Color(0.2f, 0.3f, 0.6f).ToQuantityColor();
         public static readonly Quantity_Color AttributeMarkerSelection = new Color(0.7f, 0.3f, 0.3f).ToQuantityColor();
+        public static readonly Quantity_Color AttributeMarkerFailed = new Color(0.9f, 0.5f, 0.1f).ToQuantityColor();
         public static readonly Quantity_Color SketchEditorSegments = Quantity_NameOfColor.Quantity_NOC_WHITE.ToColor();
         public static readonly Quantity_Color SketchEditorHighlight = Quantity_NameOfColor.Quantity_NOC_GOLDENROD2.ToColor();
         public static readonly Quantity_Color SketchEditorSelection = Quantity_NameOfColor.Quantity_NOC_RED.ToColor();
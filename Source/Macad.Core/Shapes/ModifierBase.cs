@@ -1,11 +1,11 @@
 ﻿using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
-using System.Runtime.InteropServices;
 using Macad.Core.Geom;
 using Macad.Core.Topology;
 using Macad.Common.Serialization;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Shapes
 {
@@ -331,7 +331,11 @@ namespace Macad.Core.Shapes
 
         #region Subshapes
 
-        readonly Dictionary<TopoDS_Shape, List<TopoDS_Shape>> _ModifiedShapes = new Dictionary<TopoDS_Shape, List<TopoDS_Shape>>();
+        readonly Dictionary<TopoDS_Shape, List<TopoDS_Shape>> _ModifiedShapes = new Dictionary<TopoDS_Shape, List<TopoDS_Shape>>(SameShapeComparer.Instance);
+
+        // Originals of every modified shape, in the order they were added. Used to find
+        // the original of a shape which is modified again without searching all lists.
+        readonly Dictionary<TopoDS_Shape, List<TopoDS_Shape>> _ModifiedShapeOrigins = new Dictionary<TopoDS_Shape, List<TopoDS_Shape>>(SameShapeComparer.Instance);
 
         //--------------------------------------------------------------------------------------------------
 
@@ -341,24 +345,27 @@ namespace Macad.Core.Shapes
                 return;
 
             // Was the original already modified?
-            var kvpModif = _ModifiedShapes.FirstOrDefault(kvp => kvp.Value.Any(s => s.IsSame(original)));
-            if (kvpModif.Key != null)
+            if (_ModifiedShapeOrigins.TryGetValue(original, out var origins))
             {
-                kvpModif.Value.RemoveAt(kvpModif.Value.IndexOfSame(original));
-                kvpModif.Value.AddRange(shapes);
+                var origin = origins[0];
+                var modifiedShapes = _ModifiedShapes[origin];
+                modifiedShapes.RemoveAt(modifiedShapes.IndexOfSame(original));
+                _RemoveModifiedShapeOrigin(original, origin);
+                modifiedShapes.AddRange(shapes);
+                _AddModifiedShapeOrigins(shapes, origin);
                 return;
             }
 
             // Now add
-            var realKey = _ModifiedShapes.Keys.FirstOrDefault(s => s.IsSame(original));
-            if (realKey != null)
+            if (_ModifiedShapes.TryGetValue(original, out var existingShapes))
             {
-                _ModifiedShapes[realKey].AddRange(shapes);
+                existingShapes.AddRange(shapes);
             }
             else
             {
                 _ModifiedShapes.Add(original, shapes);
             }
+            _AddModifiedShapeOrigins(shapes, original);
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -368,17 +375,46 @@ namespace Macad.Core.Shapes
             if (original == null)
                 return;
 
-            var kvpModif = _ModifiedShapes.FirstOrDefault(kvp => kvp.Value.Any(s => s.IsSame(original)));
-            if (kvpModif.Key != null)
+            if (_ModifiedShapeOrigins.TryGetValue(original, out var origins))
             {
-                if (kvpModif.Value.Count == 1)
+                var origin = origins[0];
+                var modifiedShapes = _ModifiedShapes[origin];
+                if (modifiedShapes.Count == 1)
                 {
-                    _ModifiedShapes.Remove(kvpModif.Key);
+                    _ModifiedShapes.Remove(origin);
                 }
                 else
                 {
-                    kvpModif.Value.RemoveAt(kvpModif.Value.IndexOfSame(original));
+                    modifiedShapes.RemoveAt(modifiedShapes.IndexOfSame(original));
+                }
+                _RemoveModifiedShapeOrigin(original, origin);
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _AddModifiedShapeOrigins(List<TopoDS_Shape> shapes, TopoDS_Shape origin)
+        {
+            foreach (var shape in shapes)
+            {
+                if (!_ModifiedShapeOrigins.TryGetValue(shape, out var origins))
+                {
+                    origins = new List<TopoDS_Shape>(1);
+                    _ModifiedShapeOrigins.Add(shape, origins);
                 }
+                origins.Add(origin);
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _RemoveModifiedShapeOrigin(TopoDS_Shape shape, TopoDS_Shape origin)
+        {
+            var origins = _ModifiedShapeOrigins[shape];
+            origins.RemoveAt(origins.IndexOfSame(origin));
+            if (origins.Count == 0)
+            {
+                _ModifiedShapeOrigins.Remove(shape);
             }
         }
 
@@ -386,39 +422,50 @@ namespace Macad.Core.Shapes
 
         protected void UpdateModifiedSubshapes(TopoDS_Shape sourceShape, BRepBuilderAPI_MakeShape makeShape)
         {
-            __Process(sourceShape.Faces());
-            __Process(sourceShape.Edges());
-            __Process(sourceShape.Vertices());
+            UpdateModifiedSubshapes(new[] { sourceShape }, makeShape);
+        }
 
-            //-----
+        //--------------------------------------------------------------------------------------------------
 
-            void __Process(IEnumerable<TopoDS_Shape> shapes)
+        protected void UpdateModifiedSubshapes(IEnumerable<TopoDS_Shape> sourceShapes, BRepBuilderAPI_MakeShape makeShape)
+        {
+            // The history of all subshapes is collected in one call, only changed subshapes get wrappers
+            using var history = ShapeHistory.Collect(makeShape, sourceShapes);
+
+            var modifiedStart = history.ModifiedStart;
+            var modified = history.Modified;
+            var generatedStart = history.GeneratedStart;
+            var generated = history.Generated;
+            var deleted = history.Deleted;
+            int deletedIndex = 0;
+
+            for (int input = 0; input < history.InputCount; input++)
             {
-                foreach (var shape in shapes)
+                if (modifiedStart[input] == modifiedStart[input + 1])
                 {
-                    var modList = makeShape.Modified(shape);
-                    if (modList.Size() == 0)
-                    {
-                        // Delete check can result in exception
-                        try
-                        {
-                            if (makeShape.IsDeleted(shape))
-                            {
-                                RemoveModifiedSubshape(shape);
-                            }
-                        }
-                        catch(SEHException)
-                        {
-                            // That means that the makeShape has this shape not in list,
-                            // so it is NOT deleted and NOT modified
-                        }
-                    }
-                    else
+                    if (deletedIndex < deleted.Length && deleted[deletedIndex] == input)
                     {
-                        AddModifiedSubshape(shape, modList.ToList());
-                        AddModifiedSubshape(shape, makeShape.Generated(shape).ToList());
+                        RemoveModifiedSubshape(history.Input(input));
+                        deletedIndex++;
                     }
+                    continue;
+                }
+
+                var shape = history.Input(input);
+                AddModifiedSubshape(shape, __GetResults(modified, modifiedStart[input], modifiedStart[input + 1]));
+                AddModifiedSubshape(shape, __GetResults(generated, generatedStart[input], generatedStart[input + 1]));
+            }
+
+            //-----
+
+            List<TopoDS_Shape> __GetResults(int[] indices, int start, int end)
+            {
+                var shapes = new List<TopoDS_Shape>(end - start);
+                for (int i = start; i < end; i++)
+                {
+                    shapes.Add(history.Result(indices[i]));
                 }
+                return shapes;
             }
         }
 
@@ -460,6 +507,7 @@ namespace Macad.Core.Shapes
         protected override void ClearSubshapeLists()
         {
             _ModifiedShapes.Clear();
+            _ModifiedShapeOrigins.Clear();
             base.ClearSubshapeLists();
         }
 
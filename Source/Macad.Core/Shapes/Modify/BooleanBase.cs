@@ -1,7 +1,19 @@
-﻿using Macad.Occt;
+﻿using Macad.Common.Serialization;
+using Macad.Occt;
 
 namespace Macad.Core.Shapes
 {
+    // Same values as BOPAlgo_GlueEnum
+    public enum BooleanGlueMode
+    {
+        Off = 0,
+        Shift = 1,
+        Full = 2
+    }
+
+    //--------------------------------------------------------------------------------------------------
+
+    [SerializeType]
     public abstract class BooleanBase : ModifierBase
     {
         public override ShapeType ShapeType
@@ -11,6 +23,110 @@ namespace Macad.Core.Shapes
 
         //--------------------------------------------------------------------------------------------------
 
+        #region Options
+
+        // The options override the global BooleanParameterSet, if set
+
+        [SerializeMember]
+        public bool? RunParallel
+        {
+            get { return _RunParallel; }
+            set
+            {
+                if (_RunParallel != value)
+                {
+                    SaveUndo();
+                    _RunParallel = value;
+                    Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [SerializeMember]
+        public double? FuzzyValue
+        {
+            get { return _FuzzyValue; }
+            set
+            {
+                if (_FuzzyValue != value)
+                {
+                    SaveUndo();
+                    _FuzzyValue = value;
+                    Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [SerializeMember]
+        public BooleanGlueMode? GlueMode
+        {
+            get { return _GlueMode; }
+            set
+            {
+                if (_GlueMode != value)
+                {
+                    SaveUndo();
+                    _GlueMode = value;
+                    Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [SerializeMember]
+        public bool? NonDestructive
+        {
+            get { return _NonDestructive; }
+            set
+            {
+                if (_NonDestructive != value)
+                {
+                    SaveUndo();
+                    _NonDestructive = value;
+                    Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [SerializeMember]
+        public bool? UseOBB
+        {
+            get { return _UseOBB; }
+            set
+            {
+                if (_UseOBB != value)
+                {
+                    SaveUndo();
+                    _UseOBB = value;
+                    Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool? _RunParallel;
+        double? _FuzzyValue;
+        BooleanGlueMode? _GlueMode;
+        bool? _NonDestructive;
+        bool? _UseOBB;
+
+        //--------------------------------------------------------------------------------------------------
+
+        #endregion
+
         #region Make
 
         protected override bool MakeInternal(MakeFlags flags)
@@ -42,6 +158,7 @@ namespace Macad.Core.Shapes
             }
 
             var algo = CreateAlgoApi();
+            _ApplyOptions(algo);
             algo.SetArguments(shapeListArgs);
             algo.SetTools(shapeListTools);
             algo.Build();
@@ -55,9 +172,9 @@ namespace Macad.Core.Shapes
             if (resultShape == null)
                 return false;
 
-            UpdateModifiedSubshapes(shapeA, algo);
-            foreach (var shapeB in shapeListTools.ToList())
-                UpdateModifiedSubshapes(shapeB, algo);
+            var sourceShapes = shapeListTools.ToList();
+            sourceShapes.Insert(0, shapeA);
+            UpdateModifiedSubshapes(sourceShapes, algo);
 
             BRep = resultShape;
 
@@ -71,6 +188,19 @@ namespace Macad.Core.Shapes
             return null;
         }
 
+        //--------------------------------------------------------------------------------------------------
+
+        void _ApplyOptions(BRepAlgoAPI_BooleanOperation algo)
+        {
+            var parameters = CoreContext.Current.Parameters.Get<BooleanParameterSet>();
+
+            algo.SetRunParallel(RunParallel ?? parameters.RunParallel);
+            algo.SetFuzzyValue(FuzzyValue ?? parameters.FuzzyValue);
+            algo.SetNonDestructive(NonDestructive ?? parameters.NonDestructive);
+            algo.SetUseOBB(UseOBB ?? parameters.UseOBB);
+            algo.SetGlue((BOPAlgo_GlueEnum)(GlueMode ?? parameters.GlueMode));
+        }
+
         #endregion
 
     }
@@ -0,0 +1,24 @@
+﻿using Macad.Common;
+
+namespace Macad.Core.Shapes
+{
+    public class BooleanParameterSet : OverridableParameterSet
+    {
+        public bool            RunParallel    { get => GetValue<bool>();            set => SetValue(value); }
+        public double          FuzzyValue     { get => GetValue<double>();          set => SetValue(value); }
+        public BooleanGlueMode GlueMode       { get => GetValue<BooleanGlueMode>(); set => SetValue(value); }
+        public bool            NonDestructive { get => GetValue<bool>();            set => SetValue(value); }
+        public bool            UseOBB         { get => GetValue<bool>();            set => SetValue(value); }
+
+        //--------------------------------------------------------------------------------------------------
+
+        public BooleanParameterSet()
+        {
+            SetDefaultValue(nameof(RunParallel),    false);
+            SetDefaultValue(nameof(FuzzyValue),     0.0);
+            SetDefaultValue(nameof(GlueMode),       BooleanGlueMode.Off);
+            SetDefaultValue(nameof(NonDestructive), false);
+            SetDefaultValue(nameof(UseOBB),         false);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 ﻿using System.Collections.Generic;
 using System.Linq;
 using Macad.Common.Serialization;
+using Macad.Core.Geom;
 using Macad.Occt;
 
 namespace Macad.Core.Shapes
@@ -153,13 +154,10 @@ namespace Macad.Core.Shapes
         public IEnumerable<TopoDS_Edge> FindValidEdges(TopoDS_Shape sourceShape)
         {
             var analysis = new ShapeAnalysis_Edge();
-            var mapOfEdgesToFaces = new TopTools_IndexedDataMapOfShapeListOfShape(1);
-            TopExp.MapShapesAndAncestors(sourceShape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_FACE, mapOfEdgesToFaces);
-
             foreach (var edge in sourceShape.Edges())
             {
                 var valid = true;
-                var faces = mapOfEdgesToFaces.FindFromKey(edge).ToList();
+                var faces = EdgeAlgo.GetAdjacentFaces(sourceShape, edge);
 
                 // Check if we have no face
                 if (faces.Count == 0)
@@ -186,17 +184,13 @@ namespace Macad.Core.Shapes
         {
             var dict = new Dictionary<TopoDS_Edge, TopoDS_Face> ();
 
-            // Create a Map of Edges and connected Faces
-            var mapOfEdgesToFaces = new TopTools_IndexedDataMapOfShapeListOfShape(1);
-            TopExp.MapShapesAndAncestors(sourceShape, TopAbs_ShapeEnum.TopAbs_EDGE, TopAbs_ShapeEnum.TopAbs_FACE, mapOfEdgesToFaces);
-
             foreach (var edge in edges)
             {
                 if (dict.ContainsKey(edge))
                     continue;
 
                 TopoDS_Face face = null;
-                var faces = mapOfEdgesToFaces.FindFromKey(edge).ToList();
+                var faces = EdgeAlgo.GetAdjacentFaces(sourceShape, edge);
                 if (faces.Count == 0)
                 {
                     continue;
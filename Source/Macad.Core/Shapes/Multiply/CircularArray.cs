@@ -6,6 +6,7 @@ using Macad.Core.Topology;
 using Macad.Common;
 using Macad.Common.Serialization;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Shapes
 {
@@ -305,11 +306,8 @@ namespace Macad.Core.Shapes
             Ax3 axis = _CalculateSolidAxis();
             var (interval, offset) = _CalculateParameters();
 
-            // Build Transformed Shapes
-            TopoDS_Compound resultShape = new TopoDS_Compound();
-            var builder = new TopoDS_Builder();
-            builder.MakeCompound(resultShape);
-
+            // Build Transforms
+            var transforms = new Trsf[Quantity];
             for (var index = 0; index < Quantity; index++)
             {
                 var angle = (interval * index + offset).ToRad();
@@ -324,14 +322,15 @@ namespace Macad.Core.Shapes
                     // Rotation transform
                     transform.SetRotation(axis.Axis, angle);
                 }
+                transforms[index] = transform;
+            }
 
-                var makeTransform = new BRepBuilderAPI_Transform(sourceBRep, transform);
-                if (!makeTransform.IsDone())
-                {
-                    Messages.Error("Failed transforming shape.");
-                    return false;
-                }
-                builder.Add(resultShape, makeTransform.Shape());
+            // Build Transformed Shapes
+            var resultShape = ShapeArrayBuilder.MakeCompound(sourceBRep, transforms);
+            if (resultShape == null)
+            {
+                Messages.Error("Failed transforming shape.");
+                return false;
             }
 
             // Finalize
@@ -6,6 +6,7 @@ using Macad.Core.Topology;
 using Macad.Common;
 using Macad.Common.Serialization;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Shapes
 {
@@ -460,11 +461,8 @@ namespace Macad.Core.Shapes
                     break;
             }
 
-            // Build Transformed Shapes
-            TopoDS_Compound resultShape = new TopoDS_Compound();
-            var builder = new TopoDS_Builder();
-            builder.MakeCompound(resultShape);
-
+            // Build Transforms
+            var transforms = new List<Trsf>((int)(Quantity1 * Quantity2));
             for (var index1 = 0; index1 < Quantity1; index1++)
             {
                 for (var index2 = 0; index2 < Quantity2; index2++)
@@ -477,16 +475,18 @@ namespace Macad.Core.Shapes
 
                     var transform = new Trsf();
                     transform.SetTranslation(interval1 * index1 + interval2 * index2 + offset);
-                    var makeTransform = new BRepBuilderAPI_Transform(sourceBRep, transform);
-                    if (!makeTransform.IsDone())
-                    {
-                        Messages.Error("Failed transforming shape.");
-                        return false;
-                    }
-                    builder.Add(resultShape, makeTransform.Shape());
+                    transforms.Add(transform);
                 }
             }
 
+            // Build Transformed Shapes
+            var resultShape = ShapeArrayBuilder.MakeCompound(sourceBRep, transforms.ToArray());
+            if (resultShape == null)
+            {
+                Messages.Error("Failed transforming shape.");
+                return false;
+            }
+
             // Finalize
             BRep = resultShape;
             return true;
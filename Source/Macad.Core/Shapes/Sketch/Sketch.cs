@@ -4,6 +4,7 @@ using System.Diagnostics;
 using System.Linq;
 using Macad.Common.Serialization;
 using Macad.Occt;
+using Macad.Occt.Helper;
 
 namespace Macad.Core.Shapes
 {
@@ -65,6 +66,7 @@ namespace Macad.Core.Shapes
                 {
                     SaveUndo(ElementType.Point);
                     _Points = value;
+                    InvalidatePointIndex();
                     Invalidate();
                     RaisePropertyChanged();
                 }
@@ -106,6 +108,44 @@ namespace Macad.Core.Shapes
 
         //--------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Constraints found to be in conflict by the last constraint analysis, empty if none.
+        /// </summary>
+        public IReadOnlyList<SketchConstraint> FailedConstraints
+        {
+            get { return _FailedConstraints; }
+            private set
+            {
+                if (_FailedConstraints != value)
+                {
+                    _FailedConstraints = value;
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        /// <summary>
+        /// Spatial index of all points for snapping and picking. It is updated along with
+        /// the element functions of the sketch and rebuilt on demand after bulk changes.
+        /// </summary>
+        public PointIndex2d PointIndex
+        {
+            get
+            {
+                _PointIndex ??= new PointIndex2d();
+                if (!_PointIndexValid || _PointIndex.Count != _Points.Count)
+                {
+                    _PointIndex.Build(_Points);
+                    _PointIndexValid = true;
+                }
+                return _PointIndex;
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         #endregion
 
         #region Initialization
@@ -123,6 +163,9 @@ namespace Macad.Core.Shapes
         Dictionary<int, Pnt2d> _Points = new Dictionary<int, Pnt2d>();
         List<SketchConstraint> _Constraints = new List<SketchConstraint>();
         bool _ConstraintSolverFailed;
+        IReadOnlyList<SketchConstraint> _FailedConstraints = Array.Empty<SketchConstraint>();
+        PointIndex2d _PointIndex;
+        bool _PointIndexValid;
 
         //--------------------------------------------------------------------------------------------------
 
@@ -135,6 +178,7 @@ namespace Macad.Core.Shapes
             SaveUndo(ElementType.Point);
             var index = Points.Keys.Any() ? Points.Keys.Max() + 1 : 0;
             Points.Add(index, point);
+            _PointIndex?.Set(index, point);
             RaisePropertyChanged(nameof(Points));
             OnElementsChanged(ElementType.Point);
             return index;
@@ -190,6 +234,7 @@ namespace Macad.Core.Shapes
             }
 
             Points.Remove(replace);
+            _PointIndex?.Remove(replace);
             segmentsToRemove?.ForEach(seg => DeleteSegment(seg));
 
             Invalidate();
@@ -215,6 +260,7 @@ namespace Macad.Core.Shapes
 
             SaveUndo(ElementType.Point);
             Points[index] = pnt2d;
+            _PointIndex?.Set(index, pnt2d);
 
             RaisePropertyChanged(nameof(Points));
 
@@ -249,6 +295,7 @@ namespace Macad.Core.Shapes
                 }
             }
             _Points.Remove(point);
+            _PointIndex?.Remove(point);
 
             var deletedPoints = DeleteOrphanedPoints(false);
             deletedPoints.Add(point);
@@ -522,6 +569,7 @@ namespace Macad.Core.Shapes
                 foreach (var pointIndex in pointsToDelete)
                 {
                     _Points.Remove(pointIndex);
+                    _PointIndex?.Remove(pointIndex);
                 }
 
                 if (doPropertyChangeCalls)
@@ -551,6 +599,7 @@ namespace Macad.Core.Shapes
             {
                 _Points.Remove(pointIndex);
             }
+            _PointIndex?.Clear();
             
             OnElementsChanged(ElementType.Segment | ElementType.Point | ElementType.Constraint);
 
@@ -559,6 +608,16 @@ namespace Macad.Core.Shapes
 
         //--------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Must be called after the points dictionary has been modified directly.
+        /// </summary>
+        public void InvalidatePointIndex()
+        {
+            _PointIndexValid = false;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         public delegate void SketchElementChange(Sketch sketch, ElementType types);
 
         public event SketchElementChange ElementsChanged;
@@ -620,11 +679,31 @@ namespace Macad.Core.Shapes
             if (Constraints.Count == 0)
             {
                 ConstraintSolverFailed = false;
+                if (FailedConstraints.Count > 0)
+                    FailedConstraints = Array.Empty<SketchConstraint>();
                 return true;
             }
 
+            if (precise)
+            {
+                // Conflicts are found much faster by analysis than by letting the solver run out of iterations.
+                // Only verified conflicts are reported, dependent constraints which may still be implied are not.
+                var analysis = SketchConstraintSolver.Analyze(this);
+                if (analysis.HasConflicts)
+                {
+                    FailedConstraints = analysis.ConflictingConstraints;
+                    Messages.Error($"Sketch constraints failed to solve, {analysis.ConflictingConstraints.Count} constraint(s) are in conflict.");
+                    ConstraintSolverFailed = true;
+                    return false;
+                }
+                if (FailedConstraints.Count > 0)
+                    FailedConstraints = Array.Empty<SketchConstraint>();
+            }
+
             if (SketchConstraintSolver.Solve(this, precise))
             {
+                if (FailedConstraints.Count > 0)
+                    FailedConstraints = Array.Empty<SketchConstraint>();
                 Invalidate();
                 RaisePropertyChanged("Points");
                 OnElementsChanged(ElementType.Point);
@@ -644,92 +723,165 @@ namespace Macad.Core.Shapes
 
         //--------------------------------------------------------------------------------------------------
 
+        // Edge of a segment together with the point keys and positions it has been built from
+        sealed class CachedEdge
+        {
+            internal readonly SketchSegment Segment;
+            internal readonly int[] PointKeys;
+            internal readonly Pnt2d[] PointValues;
+            internal readonly int StartPoint;
+            internal readonly int EndPoint;
+            internal readonly TopoDS_Edge Edge;
+
+            internal CachedEdge(SketchSegment segment, Dictionary<int, Pnt2d> points, TopoDS_Edge edge)
+            {
+                Segment = segment;
+                PointKeys = (int[])segment.Points.Clone();
+                PointValues = PointKeys.Select(key => points[key]).ToArray();
+                StartPoint = segment.StartPoint;
+                EndPoint = segment.EndPoint;
+                Edge = edge;
+            }
+
+            internal bool IsValidFor(SketchSegment segment, Dictionary<int, Pnt2d> points)
+            {
+                if (segment != Segment || segment.Points.Length != PointKeys.Length)
+                    return false;
+
+                for (int i = 0; i < PointKeys.Length; i++)
+                {
+                    if (segment.Points[i] != PointKeys[i]
+                        || !points.TryGetValue(PointKeys[i], out var point)
+                        || point.X != PointValues[i].X || point.Y != PointValues[i].Y)
+                        return false;
+                }
+                return true;
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        sealed class CachedWire
+        {
+            internal TopoDS_Wire Wire;
+            internal List<int> Segments;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        Dictionary<int, CachedEdge> _EdgeCache = new();
+        List<CachedWire> _WireCache = new();
+
+        //--------------------------------------------------------------------------------------------------
+
         protected override bool MakeInternal(MakeFlags flags)
         {
             if (!Segments.Any() || !Points.Any())
             {
+                _EdgeCache.Clear();
+                _WireCache.Clear();
                 var makeVertex = new BRepBuilderAPI_MakeVertex(Pnt.Origin);
                 BRep = makeVertex.Vertex();
                 HasErrors = false;
                 return base.MakeInternal(flags);
             }
 
-            // Create edges
-            var freeSegmentEdges = new Dictionary<SketchSegment, TopoDS_Edge>();
+            // Create edges, only for segments which have been added or changed, or whose points have been moved
+            var edgeCache = new Dictionary<int, CachedEdge>(_Segments.Count);
+            var segmentOrder = new Dictionary<int, int>(_Segments.Count);
             foreach (var segmentKvp in _Segments)
             {
                 var segment = segmentKvp.Value;
                 if(segment.IsAuxilliary)
                     continue;
 
+                if (_EdgeCache.TryGetValue(segmentKvp.Key, out var cachedEdge) && cachedEdge.IsValidFor(segment, _Points))
+                {
+                    segmentOrder.Add(segmentKvp.Key, segmentOrder.Count);
+                    edgeCache.Add(segmentKvp.Key, cachedEdge);
+                    continue;
+                }
+
                 var segEdge = segment.MakeEdge(_Points);
                 if (segEdge == null)
                 {
                     Messages.Warning($"The segment {segmentKvp.Key} of type {segment.GetType().Name} failed creating an edge.");
                     continue;
                 }
-                freeSegmentEdges.Add(segment, segEdge);
+                segmentOrder.Add(segmentKvp.Key, segmentOrder.Count);
+                edgeCache.Add(segmentKvp.Key, new CachedEdge(segment, _Points, segEdge));
                 AddNamedSubshape("seg", segEdge, segmentKvp.Key);
             }
 
-            // Create wires
-            var wires = new List<TopoDS_Wire>();
-            while (freeSegmentEdges.Any())
+            // Points at the ends of added, changed or removed edges
+            var changedSegments = new HashSet<int>();
+            var changedPoints = new HashSet<int>();
+            foreach (var edgeKvp in _EdgeCache)
             {
-                var nextSegmentEdge = freeSegmentEdges.First();
-                var frontSegment = nextSegmentEdge.Key;
-                freeSegmentEdges.Remove(nextSegmentEdge.Key);
-
-                var makeWire = new BRepBuilderAPI_MakeWire(nextSegmentEdge.Value);
-
-                if ((frontSegment.StartPoint != -1) || (frontSegment.EndPoint != -1))
+                if (!edgeCache.TryGetValue(edgeKvp.Key, out var newEdge) || newEdge != edgeKvp.Value)
                 {
-                    var backSegment = frontSegment;
-                    while (freeSegmentEdges.Any())
-                    {
-                        nextSegmentEdge = freeSegmentEdges.FirstOrDefault(kvp => kvp.Key.IsConnected(frontSegment));
-                        if (nextSegmentEdge.Value != null)
-                        {
-                            frontSegment = nextSegmentEdge.Key;
-                        }
-                        else
-                        {
-                            nextSegmentEdge = freeSegmentEdges.FirstOrDefault(kvp => kvp.Key.IsConnected(backSegment));
-                            if (nextSegmentEdge.Value != null)
-                            {
-                                backSegment = nextSegmentEdge.Key;
-                            }
-                            else
-                            {
-                                // disconnected segment
-                                break;
-                            }
-                        }
-
-                        makeWire.Add(nextSegmentEdge.Value);
-                        freeSegmentEdges.Remove(nextSegmentEdge.Key);
-                    }
+                    changedSegments.Add(edgeKvp.Key);
+                    changedPoints.Add(edgeKvp.Value.StartPoint);
+                    changedPoints.Add(edgeKvp.Value.EndPoint);
                 }
-
-                // Get wire shape
-                var wire = makeWire.Wire();
-                if (wire == null)
+            }
+            foreach (var edgeKvp in edgeCache)
+            {
+                if (!_EdgeCache.TryGetValue(edgeKvp.Key, out var oldEdge) || oldEdge != edgeKvp.Value)
                 {
-                    Messages.Error("Error when creating a wire.");
-                    return false;
+                    changedSegments.Add(edgeKvp.Key);
+                    changedPoints.Add(edgeKvp.Value.StartPoint);
+                    changedPoints.Add(edgeKvp.Value.EndPoint);
                 }
+            }
+            changedPoints.Remove(-1);
+            _EdgeCache = edgeCache;
 
-                wires.Add(wire);
+            // Keep the wires which are not touched by any change
+            var wireCache = new List<CachedWire>(_WireCache.Count);
+            var wiredSegments = new HashSet<int>();
+            foreach (var cachedWire in _WireCache)
+            {
+                if (cachedWire.Segments.Any(key => changedSegments.Contains(key)
+                                                   || changedPoints.Contains(edgeCache[key].StartPoint)
+                                                   || changedPoints.Contains(edgeCache[key].EndPoint)))
+                    continue;
+
+                wireCache.Add(cachedWire);
+                wiredSegments.UnionWith(cachedWire.Segments);
+            }
+
+            // Create wires for all other edges, connected edges are chained by their shared points
+            var freeSegments = segmentOrder.Keys.Where(key => !wiredSegments.Contains(key)).ToArray();
+            var wires = WireBuilder.MakeWires(freeSegments.Select(key => edgeCache[key].Edge).ToArray(),
+                                              freeSegments.Select(key => edgeCache[key].StartPoint).ToArray(),
+                                              freeSegments.Select(key => edgeCache[key].EndPoint).ToArray(),
+                                              out var edgeWires);
+            if (wires.Any(wire => wire == null))
+            {
+                _WireCache.Clear();
+                Messages.Error("Error when creating a wire.");
+                return false;
             }
 
+            var newWires = wires.Select(wire => new CachedWire { Wire = wire, Segments = new List<int>() }).ToArray();
+            for (int i = 0; i < freeSegments.Length; i++)
+            {
+                newWires[edgeWires[i]].Segments.Add(freeSegments[i]);
+            }
+            wireCache.AddRange(newWires);
+
+            // Order the wires by their first segment, as a complete rebuild does
+            _WireCache = wireCache.OrderBy(cachedWire => cachedWire.Segments.Min(key => segmentOrder[key])).ToList();
+
             // Create resulting shape
             var builder = new TopoDS_Builder();
             var shape = new TopoDS_Compound();
             builder.MakeCompound(shape);
 
-            foreach (var wire in wires)
+            foreach (var cachedWire in _WireCache)
             {
-                builder.Add(shape, wire);
+                builder.Add(shape, cachedWire.Wire);
             }
 
             BRep = shape;
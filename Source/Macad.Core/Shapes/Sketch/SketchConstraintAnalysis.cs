@@ -0,0 +1,35 @@
+﻿using System.Collections.Generic;
+
+namespace Macad.Core.Shapes
+{
+    /// <summary>
+    /// Remaining degrees of freedom and problematic constraints of a sketch, see <see cref="SketchConstraintSolver.Analyze"/>.
+    /// </summary>
+    public sealed class SketchConstraintAnalysis
+    {
+        /// <summary>
+        /// Number of independent movements left, including auxiliary values like free radii.
+        /// </summary>
+        public int Freedom { get; internal set; }
+
+        /// <summary>
+        /// Degrees of freedom of every point, by point index.
+        /// </summary>
+        public Dictionary<int, int> PointFreedom { get; } = new();
+
+        /// <summary>
+        /// Constraints which are already implied by the constraints before them.
+        /// </summary>
+        public List<SketchConstraint> RedundantConstraints { get; } = new();
+
+        /// <summary>
+        /// Constraints which cannot be satisfied together with the constraints before them.
+        /// </summary>
+        public List<SketchConstraint> ConflictingConstraints { get; } = new();
+
+        public bool HasConflicts
+        {
+            get { return ConflictingConstraints.Count > 0; }
+        }
+    }
+}
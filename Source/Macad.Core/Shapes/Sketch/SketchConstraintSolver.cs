@@ -1,29 +1,59 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
 using System.Linq;
 using Macad.Occt;
 using Macad.SketchSolve;
 
 namespace Macad.Core.Shapes
 {
-    public class SketchConstraintSolver
+    public class SketchConstraintSolver : IDisposable
     {
         Dictionary<int, int> _PointMap;
         int _MaxPointKey;
         List<Constraint> _Constraints;
+        List<SketchConstraint> _ConstraintOwners;
         Dictionary<int, Pnt2d> _Points;
-        List<Parameter> _Parameters;
+        List<double> _Values;
+        List<Usage> _Usages;
+        List<int> _PointKeys;
+        List<Parameter> _SessionParameters;
+        SolverSession _Session;
 
         //--------------------------------------------------------------------------------------------------
 
-        Result _Solve(Dictionary<int, Pnt2d> points, Dictionary<int, SketchSegment> segments, List<SketchConstraint> constraints, bool precise)
+        Result _Solve(Dictionary<int, Pnt2d> points, Dictionary<int, SketchSegment> segments, List<SketchConstraint> constraints, bool precise, Algorithm algorithm, out Statistics statistics)
         {
-            if (points.Count == 0 || constraints.Count == 0)
+            statistics = default;
+            if (!_Build(points, segments, constraints))
                 return Result.Success;
 
+            // Try to solve
+            _Pack(out var values, out var usage, out var constraintTable);
+            var result = Solver.Solve(values, usage, constraintTable, precise, algorithm, out statistics);
+
+            // Copy back points
+            if (result == Result.Success)
+            {
+                _CopyBackPoints(points, values);
+            }
+
+            return result;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool _Build(Dictionary<int, Pnt2d> points, Dictionary<int, SketchSegment> segments, List<SketchConstraint> constraints)
+        {
+            if (points.Count == 0 || constraints.Count == 0)
+                return false;
+
             // Init with estimated counts
-            _Parameters = new List<Parameter>();
+            _Values = new List<double>(points.Count * 2);
+            _Usages = new List<Usage>(points.Count * 2);
+            _PointKeys = new List<int>(points.Count * 2);
             _PointMap = new Dictionary<int, int>(points.Count);
             _Constraints = new List<Constraint>(constraints.Count * 2);
+            _ConstraintOwners = new List<SketchConstraint>(constraints.Count * 2);
             _Points = points;
             _MaxPointKey = _Points.Keys.Max();
 
@@ -35,30 +65,62 @@ namespace Macad.Core.Shapes
                     Messages.Warning($"The constraint {constraints.IndexOf(sketchConstraint)} of type {sketchConstraint.GetType().Name} " +
                                      "has invalid parameters. It will be ignored.");
                 }
+
+                // Remember which sketch constraint has created the solver constraints
+                while (_ConstraintOwners.Count < _Constraints.Count)
+                {
+                    _ConstraintOwners.Add(sketchConstraint);
+                }
             }
 
-            // Try to solve
-            var result = Solver.Solve(_Parameters, _Constraints, precise);
+            return true;
+        }
 
-            // Copy back points
-            if (result == Result.Success)
+        //--------------------------------------------------------------------------------------------------
+
+        // Packs values and constraints into flat arrays, the solver works on them in place
+        void _Pack(out double[] values, out byte[] usage, out int[] constraintTable)
+        {
+            values = _Values.ToArray();
+            usage = new byte[_Usages.Count];
+            for (int i = 0; i < usage.Length; i++)
             {
-                for (var index = 0; index < _Parameters.Count; index++)
-                {
-                    var param = _Parameters[index];
-                    if (param.PointKey < 0)
-                        continue;
+                usage[i] = (byte)_Usages[i];
+            }
+            constraintTable = new int[_Constraints.Count * Constraint.PackedSize];
+            for (int i = 0; i < _Constraints.Count; i++)
+            {
+                _Constraints[i].Pack(constraintTable, i);
+            }
+        }
 
-                    if (param.Usage == Usage.Variable)
-                    {
-                        points[param.PointKey] = new Pnt2d(_Parameters[index].Value, _Parameters[index + 1].Value);
-                    }
+        //--------------------------------------------------------------------------------------------------
+
+        void _CopyBackPoints(Dictionary<int, Pnt2d> points, IList<double> values)
+        {
+            for (var index = 0; index < _PointKeys.Count; index++)
+            {
+                var pointKey = _PointKeys[index];
+                if (pointKey < 0)
+                    continue;
 
-                    index++; // Skip second value of every point
+                if (_Usages[index] == Usage.Variable)
+                {
+                    points[pointKey] = new Pnt2d(values[index], values[index + 1]);
                 }
+
+                index++; // Skip second value of every point
             }
+        }
 
-            return result;
+        //--------------------------------------------------------------------------------------------------
+
+        int _AddValue(double value, Usage usage, int pointKey)
+        {
+            _Values.Add(value);
+            _Usages.Add(usage);
+            _PointKeys.Add(pointKey);
+            return _Values.Count - 1;
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -66,33 +128,171 @@ namespace Macad.Core.Shapes
         public static bool Solve(Sketch sketch, bool precise)
         {
             var solver = new SketchConstraintSolver();
-            var result = solver._Solve(sketch.Points, sketch.Segments, sketch.Constraints, precise) == Result.Success;
+            var result = solver._Solve(sketch.Points, sketch.Segments, sketch.Constraints, precise, Algorithm.Bfgs, out _) == Result.Success;
+            sketch.InvalidatePointIndex();
             //Debug.WriteLine("Sketch constraints " + (result ? "solved successful." : "have no solution."));
             return result;
         }
 
         //--------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Solves the sketch with the given algorithm and reports how much work the solver has done.
+        /// </summary>
+        public static bool Solve(Sketch sketch, bool precise, Algorithm algorithm, out Statistics statistics)
+        {
+            var solver = new SketchConstraintSolver();
+            var result = solver._Solve(sketch.Points, sketch.Segments, sketch.Constraints, precise, algorithm, out statistics) == Result.Success;
+            sketch.InvalidatePointIndex();
+            return result;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         public static bool Solve(Sketch sketch, Dictionary<int, Pnt2d> tempPoints, bool precise)
         {
             var solver = new SketchConstraintSolver();
-            var result = solver._Solve(tempPoints, sketch.Segments, sketch.Constraints, precise) == Result.Success;
+            var result = solver._Solve(tempPoints, sketch.Segments, sketch.Constraints, precise, Algorithm.Bfgs, out _) == Result.Success;
             //Debug.WriteLine("Sketch constraints " + (result ? "solved successful." : "have no solution."));
             return result;
         }
 
         //--------------------------------------------------------------------------------------------------
 
+        /// <summary>
+        /// Analyzes the constraints of the sketch at the current point positions without solving them.
+        /// Conflicting constraints are found quickly, while a solve would only fail after its maximum iterations.
+        /// Interactive solves skip it, since it is evaluated at the current point positions every time.
+        /// </summary>
+        public static SketchConstraintAnalysis Analyze(Sketch sketch)
+        {
+            var analysis = new SketchConstraintAnalysis();
+            var solver = new SketchConstraintSolver();
+            if (solver._Build(sketch.Points, sketch.Segments, sketch.Constraints))
+            {
+                var pointKeys = solver._PointMap.Keys.Where(sketch.Points.ContainsKey).ToArray();
+                var pointValues = new int[pointKeys.Length * 2];
+                for (int i = 0; i < pointKeys.Length; i++)
+                {
+                    pointValues[i * 2] = solver._PointMap[pointKeys[i]];
+                    pointValues[i * 2 + 1] = pointValues[i * 2] + 1;
+                }
+
+                solver._Pack(out var values, out var usage, out var constraintTable);
+                var result = Solver.Analyze(values, usage, constraintTable, pointValues);
+
+                analysis.Freedom = result.Freedom;
+                for (int i = 0; i < pointKeys.Length; i++)
+                {
+                    analysis.PointFreedom[pointKeys[i]] = result.PointFreedom[i];
+                }
+                foreach (var index in result.ConflictingConstraints)
+                {
+                    var owner = solver._ConstraintOwners[index];
+                    if (!analysis.ConflictingConstraints.Contains(owner))
+                        analysis.ConflictingConstraints.Add(owner);
+                }
+                foreach (var index in result.RedundantConstraints)
+                {
+                    var owner = solver._ConstraintOwners[index];
+                    if (!analysis.ConflictingConstraints.Contains(owner) && !analysis.RedundantConstraints.Contains(owner))
+                        analysis.RedundantConstraints.Add(owner);
+                }
+            }
+
+            // Points without any constraint can move freely
+            foreach (var pointKey in sketch.Points.Keys)
+            {
+                if (analysis.PointFreedom.ContainsKey(pointKey))
+                    continue;
+                analysis.PointFreedom[pointKey] = 2;
+                analysis.Freedom += 2;
+            }
+
+            return analysis;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        #region Session
+
+        /// <summary>
+        /// Creates a solver which keeps the constraint system loaded for repeated solving,
+        /// e.g. while points are dragged. The session must be disposed when it is no longer used.
+        /// </summary>
+        public static SketchConstraintSolver CreateSession(Sketch sketch, Dictionary<int, Pnt2d> points)
+        {
+            var solver = new SketchConstraintSolver();
+            if (solver._Build(points, sketch.Segments, sketch.Constraints))
+            {
+                solver._SessionParameters = new List<Parameter>(solver._Values.Count);
+                for (int i = 0; i < solver._Values.Count; i++)
+                {
+                    solver._SessionParameters.Add(new Parameter
+                    {
+                        Value = solver._Values[i],
+                        Usage = solver._Usages[i],
+                        PointKey = solver._PointKeys[i]
+                    });
+                }
+                solver._Session = new SolverSession(solver._SessionParameters, solver._Constraints);
+            }
+            return solver;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        /// <summary>
+        /// Solves the session again after the given points have been changed.
+        /// </summary>
+        public bool SolveSession(Dictionary<int, Pnt2d> points, IEnumerable<int> changedPoints, bool precise)
+        {
+            if (_Session == null)
+                return true;
+
+            foreach (var pointKey in changedPoints)
+            {
+                if (!_PointMap.TryGetValue(pointKey, out var index) || !points.TryGetValue(pointKey, out var point))
+                    continue;
+
+                _Session.SetValue(index, point.X);
+                _Session.SetValue(index + 1, point.Y);
+            }
+
+            var result = _Session.Solve(precise);
+            if (result == Result.Success)
+            {
+                for (int i = 0; i < _Values.Count; i++)
+                {
+                    _Values[i] = _SessionParameters[i].Value;
+                }
+                _CopyBackPoints(points, _Values);
+            }
+            return result == Result.Success;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        public void Dispose()
+        {
+            _Session?.Dispose();
+            _Session = null;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        #endregion
+
         #region Support functions for constraints
 
         int _GetPointIndex(int pointKey, bool isConstant)
         {
             if (_PointMap.TryGetValue(pointKey, out var index))
             {
-                if (!isConstant && _Parameters[index].Usage == Usage.Constant)
-                    _Parameters[index].Usage = Usage.Variable;
-                if (!isConstant && _Parameters[index+1].Usage == Usage.Constant)
-                    _Parameters[index+1].Usage = Usage.Variable;
+                if (!isConstant && _Usages[index] == Usage.Constant)
+                    _Usages[index] = Usage.Variable;
+                if (!isConstant && _Usages[index+1] == Usage.Constant)
+                    _Usages[index+1] = Usage.Variable;
                 return index;
             }
 
@@ -101,22 +301,10 @@ namespace Macad.Core.Shapes
                 return -1;
             }
             
-            index = _Parameters.Count;
+            var usage = isConstant ? Usage.Constant : Usage.Variable;
+            index = _AddValue(value.X, usage, pointKey);
+            _AddValue(value.Y, usage, pointKey);
             _PointMap.Add(pointKey, index);
-            _Parameters.Add(
-                new Parameter
-                {
-                    Value = value.X, 
-                    PointKey = pointKey, 
-                    Usage = isConstant ? Usage.Constant : Usage.Variable
-                });
-            _Parameters.Add(
-                new Parameter
-                {
-                    Value = value.Y, 
-                    PointKey = pointKey, 
-                    Usage = isConstant ? Usage.Constant : Usage.Variable
-                });
             return index;
         }
 
@@ -218,14 +406,7 @@ namespace Macad.Core.Shapes
 
         public bool SetParameter(out int parameter, double value, bool isConstant)
         {
-            parameter = _Parameters.Count;
-            _Parameters.Add(
-                new Parameter
-                {
-                    Value = value,
-                    Usage = isConstant ? Usage.Constant : Usage.Variable,
-                    PointKey = -1
-                });
+            parameter = _AddValue(value, isConstant ? Usage.Constant : Usage.Variable, -1);
             return true;
         }
 
@@ -235,21 +416,9 @@ namespace Macad.Core.Shapes
         {
             _MaxPointKey++;
             pointKey = _MaxPointKey;
-            _PointMap.Add(_MaxPointKey, _Parameters.Count);
-            _Parameters.Add(
-                new Parameter()
-                {
-                    Value = point.X,
-                    Usage = isConstant ? Usage.Constant : Usage.Variable,
-                    PointKey = -1
-                });
-            _Parameters.Add(
-                new Parameter()
-                {
-                    Value = point.Y,
-                    Usage = isConstant ? Usage.Constant : Usage.Variable,
-                    PointKey = -1
-                });
+            var usage = isConstant ? Usage.Constant : Usage.Variable;
+            _PointMap.Add(_MaxPointKey, _AddValue(point.X, usage, -1));
+            _AddValue(point.Y, usage, -1);
 
             return true;
         }
@@ -268,8 +437,8 @@ namespace Macad.Core.Shapes
             var index = _GetPointIndex(pointKey, true);
             if (index >= 0)
             {
-                _Parameters[index].Usage = Usage.Immutable;
-                _Parameters[index+1].Usage = Usage.Immutable;
+                _Usages[index] = Usage.Immutable;
+                _Usages[index+1] = Usage.Immutable;
             }
         }
         
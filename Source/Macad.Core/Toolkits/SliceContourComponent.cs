@@ -36,6 +36,24 @@ namespace Macad.Core.Toolkits
 
         //--------------------------------------------------------------------------------------------------
 
+        [SerializeMember]
+        public bool SliceAllPlanesAtOnce
+        {
+            get { return _SliceAllPlanesAtOnce; }
+            set
+            {
+                if (_SliceAllPlanesAtOnce != value)
+                {
+                    SaveUndo();
+                    _SliceAllPlanesAtOnce = value;
+                    Invalidate();
+                    RaisePropertyChanged();
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         [SerializeMember]
         public Guid ShapeGuid
         {
@@ -115,6 +133,7 @@ namespace Macad.Core.Toolkits
         #region Members and infrastructure
 
         int _LayerCount;
+        bool _SliceAllPlanesAtOnce;
         SubshapeReference _ReferenceFace;
         Guid _ShapeGuid;
         bool _HasErrors;
@@ -296,7 +315,10 @@ namespace Macad.Core.Toolkits
         
         bool _Slice(MakeContext context)
         {
-            context.Slicer = new SliceByPlanes(context.SourceShape, context.ReferenceFace, LayerCount);
+            context.Slicer = new SliceByPlanes(context.SourceShape, context.ReferenceFace, LayerCount)
+            {
+                Method = SliceAllPlanesAtOnce ? SliceByPlanes.SliceMethod.AllPlanes : SliceByPlanes.SliceMethod.PerPlane
+            };
             if(!context.Slicer.CreateSlices(false))
             {
                 return false;
@@ -295,12 +295,7 @@ namespace Macad.Exchange.Dxf
         void _ImportSplineWithFitPoints(DxfDomSpline dxfSpline)
         {
             // Copy points
-            var pointCount = dxfSpline.FitPoints.Length;
-            var points = new TColgp_HArray1OfPnt2d(1, pointCount);
-            for (int i = 0; i < pointCount; i++)
-            {
-                points.SetValue(i + 1, dxfSpline.FitPoints[i]);
-            }
+            var points = new TColgp_HArray1OfPnt2d(dxfSpline.FitPoints);
 
             // Interpolate
             var algo = new Geom2dAPI_Interpolate(points, false, 0.001);
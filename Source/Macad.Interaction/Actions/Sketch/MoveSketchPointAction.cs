@@ -331,19 +331,16 @@ namespace Macad.Interaction
                 if (moveDelta != Vec2d.Zero)
                     movedPoint = movedPoint.Translated(moveDelta);
 
-                // Distance to other points
-                foreach (var pointKvp in _Sketch.Points)
+                // Nearest of the other points
+                foreach (var otherPoint in _Sketch.PointIndex.FindInRadius(movedPoint, mergeDistance))
                 {
-                    if (!Points.Contains(pointKvp.Key))
+                    if (!Points.Contains(otherPoint))
                     {
-                        var distance = pointKvp.Value.Distance(movedPoint);
-                        if (distance < mergeDistance)
+                        if (!mergeCandidates.ContainsKey(point))
                         {
-                            if (!mergeCandidates.ContainsKey(point))
-                            {
-                                mergeCandidates.Add(point, pointKvp.Key);
-                            }
+                            mergeCandidates.Add(point, otherPoint);
                         }
+                        break;
                     }
                 }
             }
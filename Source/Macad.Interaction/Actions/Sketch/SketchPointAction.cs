@@ -186,14 +186,11 @@ namespace Macad.Interaction
 
             if (EnablePointMerge)
             {
-                foreach (var pointKvp in _SketchEditorTool.Sketch.Points)
+                var sketch = _SketchEditorTool.Sketch;
+                if (sketch.PointIndex.FindNearest(snapPoint, mergeDistance, out var nearestPoint, out _))
                 {
-                    var distance = pointKvp.Value.Distance(snapPoint);
-                    if (distance < mergeDistance)
-                    {
-                        _MergeCandidatePoint = pointKvp.Value;
-                        MergeCandidateIndex = pointKvp.Key;
-                    }
+                    _MergeCandidatePoint = sketch.Points[nearestPoint];
+                    MergeCandidateIndex = nearestPoint;
                 }
             }
 
@@ -5,6 +5,8 @@ using Macad.Common;
 using Macad.Core;
 using Macad.Common.Serialization;
 using Macad.Occt;
+using Macad.Occt.Helper;
+using Macad.Interaction.Visual;
 
 namespace Macad.Interaction
 {
@@ -53,6 +55,11 @@ namespace Macad.Interaction
 
         SnapMode _SupportedSnapModes = SnapMode.None;
         readonly WorkspaceController _WorkspaceController;
+        SnapIndex _SnapIndex;
+        bool _SnapIndexInvalid = true;
+
+        // Capture radius around the cursor for snapping to vertices and edges
+        const double _SnapIndexRadiusInPixels = 8.0;
 
         //--------------------------------------------------------------------------------------------------
 
@@ -60,6 +67,7 @@ namespace Macad.Interaction
         {
             _WorkspaceController = workspaceController;
             _WorkspaceController.PropertyChanged += _WorkspaceController_PropertyChanged;
+            VisualObjectManager.SelectableBRepsChanged += _VisualObjectManager_SelectableBRepsChanged;
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -70,6 +78,9 @@ namespace Macad.Interaction
             {
                 _WorkspaceController.PropertyChanged -= _WorkspaceController_PropertyChanged;
             }
+            VisualObjectManager.SelectableBRepsChanged -= _VisualObjectManager_SelectableBRepsChanged;
+            _SnapIndex?.Dispose();
+            _SnapIndex = null;
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -84,6 +95,16 @@ namespace Macad.Interaction
 
         //--------------------------------------------------------------------------------------------------
 
+        void _VisualObjectManager_SelectableBRepsChanged(VisualObjectManager visualObjectManager)
+        {
+            if (visualObjectManager == _WorkspaceController.VisualObjects)
+            {
+                _SnapIndexInvalid = true;
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         public SnapInfo Snap(MouseEventData mouseEvent)
         {
             if (!InteractiveContext.Current.EditorState.SnappingEnabled)
@@ -91,6 +112,19 @@ namespace Macad.Interaction
                 return null;
             }
 
+            var info = _SnapToDetected(mouseEvent);
+
+            if (info != null)
+            {
+                _WorkspaceController.CursorPosition = info.Point;
+            }
+            return info;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        SnapInfo _SnapToDetected(MouseEventData mouseEvent)
+        {
             SnapInfo info = null;
 
             if (mouseEvent.DetectedShapes.Count == 1)
@@ -115,7 +149,7 @@ namespace Macad.Interaction
                     // On Edge
                     var edge = TopoDS.Edge(detectedShape);
                     double umin = 0, umax = 0;
-                    var curve = BRep_Tool.Curve(edge, ref umin, ref umax);
+                    var curve = BRep_Tool.CurveShared(edge, ref umin, ref umax);
                     if (curve != null)
                     {
                         var extrema = new GeomAPI_ExtremaCurveCurve(curve,
@@ -150,6 +184,12 @@ namespace Macad.Interaction
                     };
                 }
             }
+            else if (mouseEvent.DetectedShapes.Count == 0 && mouseEvent.DetectedAisInteractives.Count == 0
+                     && _SnapToSelectableBodies(mouseEvent) is SnapInfo bodyInfo)
+            {
+                // Nothing detected, but the cursor is close to a vertex or edge of a selectable body
+                info = bodyInfo;
+            }
             else if (SupportedSnapModes.HasFlag(SnapMode.Grid)
                 && InteractiveContext.Current.EditorState.SnapToGridSelected
                 && _WorkspaceController.Workspace.V3dViewer.Grid().IsActive())
@@ -162,11 +202,47 @@ namespace Macad.Interaction
                 };
             }
 
-            if (info != null)
+            return info;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        SnapInfo _SnapToSelectableBodies(MouseEventData mouseEvent)
+        {
+            var editorState = InteractiveContext.Current.EditorState;
+            var targets = SnapIndexTargets.None;
+            if (SupportedSnapModes.HasFlag(SnapMode.Vertex) && editorState.SnapToVertexSelected)
             {
-                _WorkspaceController.CursorPosition = info.Point;
+                // Edge midpoints share the setting with vertices
+                targets |= SnapIndexTargets.Vertex | SnapIndexTargets.EdgeMidpoint;
             }
-            return info;
+            if (SupportedSnapModes.HasFlag(SnapMode.Edge) && editorState.SnapToEdgeSelected)
+            {
+                targets |= SnapIndexTargets.Edge;
+            }
+
+            var viewport = mouseEvent.Viewport ?? _WorkspaceController.ActiveViewport;
+            if (targets == SnapIndexTargets.None || viewport == null)
+                return null;
+
+            // Synchronize only after the set of selectable bodies has changed, then
+            // only bodies which have been changed or added are indexed again
+            _SnapIndex ??= new SnapIndex();
+            if (_SnapIndexInvalid)
+            {
+                _SnapIndex.Update(_WorkspaceController.VisualObjects.GetSelectableBReps());
+                _SnapIndexInvalid = false;
+            }
+
+            var axis = viewport.ViewAxis(Convert.ToInt32(mouseEvent.ScreenPoint.X), Convert.ToInt32(mouseEvent.ScreenPoint.Y));
+            if (!_SnapIndex.FindNearest(axis, _SnapIndexRadiusInPixels * viewport.PixelSize, targets, out var point, out var target))
+                return null;
+
+            return new SnapInfo()
+            {
+                Point = point,
+                SnapMode = target == SnapIndexTargets.Edge ? SnapMode.Edge : SnapMode.Vertex
+            };
         }
 
         //--------------------------------------------------------------------------------------------------
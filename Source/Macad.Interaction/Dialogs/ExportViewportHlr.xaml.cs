@@ -109,6 +109,19 @@ namespace Macad.Interaction.Dialogs
 
         //--------------------------------------------------------------------------------------------------
 
+        [SerializeMember]
+        public bool MergeEdges
+        {
+            get { return _MergeEdges; }
+            set
+            {
+                _MergeEdges = value;
+                RaisePropertyChanged();
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         #endregion
 
         #region Members
@@ -120,6 +133,7 @@ namespace Macad.Interaction.Dialogs
         bool _HiddenSmooth;
         bool _HiddenSewn;
         bool _UseTriangulation;
+        bool _MergeEdges;
 
         //--------------------------------------------------------------------------------------------------
         
@@ -131,6 +145,7 @@ namespace Macad.Interaction.Dialogs
         {
             _VisibleOutline = true;
             _HiddenOutline = true;
+            _MergeEdges = true;
         }
 
         #endregion
@@ -231,6 +246,7 @@ namespace Macad.Interaction.Dialogs
                 var source = new TopoDSBrepSource(InteractiveContext.Current.WorkspaceController.VisualObjects.GetVisibleBReps().ToArray());
                 var hlrBrepDrawing = HlrDrawing.Create(projection, hlrEdgeTypes, source);
                 hlrBrepDrawing.UseTriangulation = Settings.UseTriangulation;
+                hlrBrepDrawing.MergeEdges = Settings.MergeEdges;
 
                 var drawing = new Drawing();
                 drawing.Add(hlrBrepDrawing);
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Linq;
 using Macad.Interaction.Visual;
 using Macad.Common;
 using Macad.Core;
@@ -26,7 +27,15 @@ namespace Macad.Interaction.Editors.Shapes
 
         public override void UpdateVisual()
         {
-            _Marker.SetColor(IsSelected ? Colors.AttributeMarkerSelection : Colors.AttributeMarkerBackground);
+            if (_Marker == null)
+                return;
+
+            if (IsSelected)
+                _Marker.SetColor(Colors.AttributeMarkerSelection);
+            else if (SketchEditorTool.Sketch.FailedConstraints.Contains(Constraint))
+                _Marker.SetColor(Colors.AttributeMarkerFailed);
+            else
+                _Marker.SetColor(Colors.AttributeMarkerBackground);
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -375,5 +375,13 @@ namespace Macad.Interaction.Editors.Shapes
             _SketchEditorTool.WorkspaceController.Invalidate();
         }
 
+        //--------------------------------------------------------------------------------------------------
+
+        internal void OnFailedConstraintsChanged()
+        {
+            ConstraintElements.ForEach(cc => cc.UpdateVisual());
+            _SketchEditorTool.WorkspaceController.Invalidate();
+        }
+
     }
 }
\ No newline at end of file
@@ -110,6 +110,7 @@ namespace Macad.Interaction.Editors.Shapes
 
         SelectSketchElementAction _SelectAction;
         MoveSketchPointAction _MoveAction;
+        SketchConstraintSolver _MoveSolver;
         ISketchTool _CurrentTool;
         bool _ContinuesSegmentCreation;
         List<int> _SelectedPoints;
@@ -182,6 +183,7 @@ namespace Macad.Interaction.Editors.Shapes
             _UpdateSelections();
 
             Sketch.ElementsChanged += _Sketch_ElementsChanged;
+            Sketch.PropertyChanged += _Sketch_PropertyChanged;
 
             _SelectAction = new SelectSketchElementAction(this);
             if (!WorkspaceController.StartToolAction(_SelectAction))
@@ -212,10 +214,12 @@ namespace Macad.Interaction.Editors.Shapes
                 }
 
                 Sketch.ElementsChanged -= _Sketch_ElementsChanged;
+                Sketch.PropertyChanged -= _Sketch_PropertyChanged;
             }
 
             WorkspaceController.Selection.CloseContext(_SelectionContext);
             _SelectionContext = null;
+            _ResetMoveSolver();
 
             Elements.RemoveAll();
 
@@ -502,6 +506,7 @@ namespace Macad.Interaction.Editors.Shapes
                 // Take over new points
                 _TempPoints = new Dictionary<int, Pnt2d>(Sketch.Points);
             }
+            _ResetMoveSolver();
 
             Elements.OnSketchChanged(Sketch, types);
             _UpdateSelections();
@@ -509,6 +514,16 @@ namespace Macad.Interaction.Editors.Shapes
 
         //--------------------------------------------------------------------------------------------------
 
+        void _Sketch_PropertyChanged(object sender, System.ComponentModel.PropertyChangedEventArgs e)
+        {
+            if (e.PropertyName == nameof(Sketch.FailedConstraints))
+            {
+                Elements.OnFailedConstraintsChanged();
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         #endregion
 
         #region Movement
@@ -520,7 +535,9 @@ namespace Macad.Interaction.Editors.Shapes
                 _TempPoints[pointIndex] = Sketch.Points[pointIndex].Translated(moveDelta);
             }
 
-            SketchConstraintSolver.Solve(Sketch, _TempPoints, false);
+            // Keep the constraint system loaded while dragging, only the moved points are updated
+            _MoveSolver ??= SketchConstraintSolver.CreateSession(Sketch, _TempPoints);
+            _MoveSolver.SolveSession(_TempPoints, points, false);
             Elements.OnPointsChanged(_TempPoints, Sketch.Segments);
             WorkspaceController.Invalidate();
 
@@ -531,6 +548,14 @@ namespace Macad.Interaction.Editors.Shapes
 
         //--------------------------------------------------------------------------------------------------
 
+        void _ResetMoveSolver()
+        {
+            _MoveSolver?.Dispose();
+            _MoveSolver = null;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         void _OnMoveActionPreview(ToolAction toolAction)
         {
             if (CurrentTool != null)
@@ -561,6 +586,7 @@ namespace Macad.Interaction.Editors.Shapes
             if (_MoveAction.MoveDelta.Magnitude() > 0)
             {
                 Sketch.Points = new Dictionary<int, Pnt2d>(_ApplyMoveDelta(_MoveAction.Points, _MoveAction.MoveDelta));
+                _ResetMoveSolver();
 
                 // Check if points can be merged, and merge them
                 var mergeCandidates = _MoveAction.CheckMergePoints(Vec2d.Zero);
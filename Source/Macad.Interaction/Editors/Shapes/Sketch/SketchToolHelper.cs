@@ -56,15 +56,15 @@ namespace Macad.Interaction.Editors.Shapes
                 }
 
                 // Calc snapping position and distance to other points
-                IEnumerable<Pnt2d> otherPoints = sketch.Points.Values;
-                if (freePoints != null)
-                {
-                    otherPoints = otherPoints.Concat(freePoints);
-                }
-
                 if (editorState.SnapToVertexSelected)
                 {
-                    foreach (var otherPnt in otherPoints)
+                    if (sketch.PointIndex.FindNearest(point, snapDistance, out var nearestPoint, out var nearestDistance))
+                    {
+                        snapDistance = nearestDistance;
+                        snapPoint = sketch.Points[nearestPoint];
+                    }
+
+                    foreach (var otherPnt in freePoints ?? Enumerable.Empty<Pnt2d>())
                     {
                         var distance = point.Distance(otherPnt);
                         if (distance < snapDistance)
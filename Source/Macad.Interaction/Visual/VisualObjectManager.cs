@@ -71,12 +71,14 @@ namespace Macad.Interaction.Visual
 
             Entity.EntityRemoved += _Entity_EntityRemoved;
             InteractiveEntity.VisualChanged += _InteractiveEntity_VisualChanged;
+            VisualObject.AisObjectChanged += _VisualObject_AisObjectChanged;
         }
 
         //--------------------------------------------------------------------------------------------------
 
         public void Dispose()
         {
+            VisualObject.AisObjectChanged -= _VisualObject_AisObjectChanged;
             InteractiveEntity.VisualChanged -= _InteractiveEntity_VisualChanged;
             Entity.EntityRemoved -= _Entity_EntityRemoved;
             
@@ -107,6 +109,9 @@ namespace Macad.Interaction.Visual
 
         public static event VisualShapeManagerEventHandler IsolatedEntitiesChanged;
 
+        // Raised if the result of GetSelectableBReps may have changed
+        public static event VisualShapeManagerEventHandler SelectableBRepsChanged;
+
         //--------------------------------------------------------------------------------------------------
 
         public bool EntityIsolationEnabled
@@ -125,6 +130,7 @@ namespace Macad.Interaction.Visual
             }
 
             IsolatedEntitiesChanged?.Invoke(this);
+            SelectableBRepsChanged?.Invoke(this);
             RaisePropertyChanged(nameof(EntityIsolationEnabled));
         }
 
@@ -200,6 +206,7 @@ namespace Macad.Interaction.Visual
                 }
             }
 
+            SelectableBRepsChanged?.Invoke(this);
             return visualObject;
         }
 
@@ -241,6 +248,7 @@ namespace Macad.Interaction.Visual
                 }
 
                 _BRepToInteractiveDictionary.Add(ocShape, entity);
+                SelectableBRepsChanged?.Invoke(this);
             }
 
             visualObject.Update();
@@ -262,6 +270,8 @@ namespace Macad.Interaction.Visual
             {
                 _BRepToInteractiveDictionary.Remove(item.Key);
             }
+
+            SelectableBRepsChanged?.Invoke(this);
         }
 
         //--------------------------------------------------------------------------------------------------
@@ -309,6 +319,17 @@ namespace Macad.Interaction.Visual
 
         //--------------------------------------------------------------------------------------------------
 
+        // BReps of visuals which can currently be selected, excluding hidden, locked, ghosted and not isolated ones
+        public IEnumerable<TopoDS_Shape> GetSelectableBReps()
+        {
+            var isolatedEntities = GetIsolatedEntities();
+            return _BRepToInteractiveDictionary.Where(kvp => (isolatedEntities?.Contains(kvp.Value) ?? true)
+                                                             && (Get(kvp.Value)?.IsSelectable ?? false))
+                                               .Select(kvp => kvp.Key);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         void _Entity_EntityRemoved(Entity entity)
         {
             if (!(entity is InteractiveEntity interactiveEntity))
@@ -332,5 +353,13 @@ namespace Macad.Interaction.Visual
 
         //--------------------------------------------------------------------------------------------------
 
+        void _VisualObject_AisObjectChanged(VisualObject visualObject)
+        {
+            // Visibility or interactivity of the visual has been changed
+            SelectableBRepsChanged?.Invoke(this);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
     }
 }
\ No newline at end of file
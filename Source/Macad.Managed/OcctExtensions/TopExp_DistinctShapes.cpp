@@ -0,0 +1,30 @@
+﻿#include "ManagedPCH.h"
+#include <TopTools_IndexedMapOfShape.hxx>
+#include "TopExp_DistinctShapes.h"
+
+#pragma managed(push, off)
+
+void TopExp_DistinctShapes::Collect(const TopoDS_Shape& theShape, TopAbs_ShapeEnum theType, bool thePreferForward,
+									std::vector<TopoDS_Shape>& theShapes)
+{
+	TopTools_IndexedMapOfShape map;
+	const size_t first = theShapes.size();
+	for (TopExp_Explorer exp(theShape, theType); exp.More(); exp.Next())
+	{
+		const TopoDS_Shape& current = exp.Current();
+		const size_t index = first + map.Add(current) - 1;
+		if (index == theShapes.size())
+		{
+			theShapes.push_back(current);
+		}
+		else if (thePreferForward
+				 && theShapes[index].Orientation() == TopAbs_REVERSED
+				 && current.Orientation() == TopAbs_FORWARD)
+		{
+			// Replace with forward shape, this is prefered
+			theShapes[index] = current;
+		}
+	}
+}
+
+#pragma managed(pop)
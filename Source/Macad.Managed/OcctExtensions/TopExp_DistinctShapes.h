@@ -0,0 +1,13 @@
+﻿#pragma once
+
+#include <vector>
+
+// Distinct subshapes of a type in explorer order, as used for the subshape lists of the managed helpers.
+// Shapes are the same if they share TShape and location, if requested a forward occurrence replaces a
+// reversed one. The shapes are appended to the given list.
+class TopExp_DistinctShapes
+{
+public:
+	static void Collect(const TopoDS_Shape& theShape, TopAbs_ShapeEnum theType, bool thePreferForward,
+						std::vector<TopoDS_Shape>& theShapes);
+};
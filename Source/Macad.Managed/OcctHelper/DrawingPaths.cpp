@@ -0,0 +1,369 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include <algorithm>
+#include <BRep_Tool.hxx>
+#include <BRep_TEdge.hxx>
+#include <BRep_CurveOnSurface.hxx>
+#include <BRepTools.hxx>
+#include <Geom_Plane.hxx>
+#include <Geom2d_Line.hxx>
+#include <Geom2d_Circle.hxx>
+#include <ShapeAnalysis_WireOrder.hxx>
+#include <TopExp.hxx>
+#include "OcctExtensions/TopExp_DistinctShapes.h"
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Traverses a planar shape the same way the drawing renderer does and collects the 2D curves of all edges.
+// Every face contributes one loop for its outer wire and one for each inner wire, a shape without faces
+// contributes one loop with all edges. The edges of a loop are ordered into chains by their end points.
+// Lines and circles are classified and their parameters stored, so exporters can draw them without
+// touching the curve objects. All results are stored in flat arrays with compressed rows.
+class DrawingPathsData
+{
+public:
+	// Same values as DrawingCurveType
+	enum CurveType
+	{
+		Missing = 0,
+		Line = 1,
+		Circle = 2,
+		Other = 3
+	};
+
+	static const int DataStride = 7;
+
+	std::vector<int> LoopChainStart{ 0 };
+	std::vector<int> ChainCurveStart{ 0 };
+	std::vector<unsigned char> ChainIsOrdered;
+	std::vector<int> CurveTypes;
+	std::vector<unsigned char> CurveReversed;
+	std::vector<double> CurveData;
+	std::vector<Handle(Geom2d_Curve)> Curves;
+
+	//--------------------------------------------------------------------------------------------------
+
+	void Build(const TopoDS_Shape& shape, double tolerance)
+	{
+		std::vector<TopoDS_Shape> faces;
+		TopExp_DistinctShapes::Collect(shape, TopAbs_FACE, true, faces);
+		if (faces.empty())
+		{
+			// Drawings may only contain lines, not faces
+			std::vector<TopoDS_Shape> edges;
+			TopExp_DistinctShapes::Collect(shape, TopAbs_EDGE, true, edges);
+			_AddLoop(edges, false, tolerance);
+			return;
+		}
+
+		Handle(Geom_Plane) plane = new Geom_Plane(gp::XOY());
+		for (const auto& faceShape : faces)
+		{
+			const TopoDS_Face& face = TopoDS::Face(faceShape);
+			TopoDS_Wire outerWire = BRepTools::OuterWire(face);
+			if (outerWire.IsNull())
+				continue;
+
+			std::vector<TopoDS_Shape> wires;
+			TopExp_DistinctShapes::Collect(face, TopAbs_WIRE, true, wires);
+			wires.insert(wires.begin(), outerWire);
+			for (size_t i = 0; i < wires.size(); i++)
+			{
+				if (i > 0 && wires[i].IsEqual(outerWire))
+					continue;
+
+				std::vector<TopoDS_Shape> edges;
+				TopExp_DistinctShapes::Collect(wires[i], TopAbs_EDGE, true, edges);
+				_AddLoop(edges, true, tolerance, plane);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	void _AddLoop(const std::vector<TopoDS_Shape>& edges, bool onFace, double tolerance, const Handle(Geom_Plane)& plane = nullptr)
+	{
+		ShapeAnalysis_WireOrder order(Standard_True, tolerance);
+		for (const auto& edgeShape : edges)
+		{
+			const TopoDS_Edge& edge = TopoDS::Edge(edgeShape);
+			gp_Pnt first = BRep_Tool::Pnt(TopExp::FirstVertex(edge));
+			gp_Pnt last = BRep_Tool::Pnt(TopExp::LastVertex(edge));
+			if (edge.Orientation() == TopAbs_FORWARD)
+				order.Add(first.XYZ(), last.XYZ());
+			else
+				order.Add(last.XYZ(), first.XYZ());
+		}
+		order.Perform(Standard_True);
+
+		if (order.IsDone())
+		{
+			order.SetChains(tolerance);
+			for (int chain = 1; chain <= order.NbChains(); chain++)
+			{
+				int startIndex = 0, endIndex = 0;
+				order.Chain(chain, startIndex, endIndex);
+				if (startIndex > endIndex)
+					continue;
+
+				for (int index = startIndex; index <= endIndex; index++)
+				{
+					const int orderIndex = order.Ordered(index);
+					const int originalIndex = Abs(orderIndex) - 1; // order index is 1-based
+					_AddEdge(TopoDS::Edge(edges[originalIndex]), orderIndex < 0, onFace, plane);
+				}
+				_EndChain(true);
+			}
+		}
+		else
+		{
+			// Cannot sort, just pump out all edges
+			for (const auto& edgeShape : edges)
+			{
+				_AddEdge(TopoDS::Edge(edgeShape), false, onFace, plane);
+			}
+			_EndChain(false);
+		}
+
+		LoopChainStart.push_back((int)ChainIsOrdered.size());
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _EndChain(bool isOrdered)
+	{
+		ChainIsOrdered.push_back(isOrdered ? 1 : 0);
+		ChainCurveStart.push_back((int)CurveTypes.size());
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _AddEdge(const TopoDS_Edge& edge, bool reverse, bool onFace, const Handle(Geom_Plane)& plane)
+	{
+		reverse ^= edge.Orientation() == TopAbs_REVERSED;
+
+		if (onFace)
+		{
+			double first = 0, last = 0;
+			Handle(Geom2d_Curve) curve = BRep_Tool::CurveOnSurface(edge, plane, TopLoc_Location(), first, last);
+			_AddCurve(curve, first, last, reverse);
+			return;
+		}
+
+		Handle(BRep_TEdge) tedge = Handle(BRep_TEdge)::DownCast(edge.TShape());
+		if (tedge.IsNull())
+			return;
+
+		std::vector<Handle(BRep_CurveOnSurface)> curveReps;
+		for (BRep_ListIteratorOfListOfCurveRepresentation it(tedge->Curves()); it.More(); it.Next())
+		{
+			Handle(BRep_CurveOnSurface) curveRep = Handle(BRep_CurveOnSurface)::DownCast(it.Value());
+			if (!curveRep.IsNull())
+				curveReps.push_back(curveRep);
+		}
+		if (reverse)
+		{
+			std::reverse(curveReps.begin(), curveReps.end());
+		}
+
+		for (const auto& curveRep : curveReps)
+		{
+			_AddCurve(curveRep->PCurve(), curveRep->First(), curveRep->Last(), reverse);
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _AddCurve(const Handle(Geom2d_Curve)& curve, double first, double last, bool reverse)
+	{
+		double data[DataStride] = { first, last };
+		CurveType type = Other;
+
+		if (curve.IsNull())
+		{
+			type = Missing;
+		}
+		else if (curve->IsKind(STANDARD_TYPE(Geom2d_Line)))
+		{
+			type = Line;
+			gp_Pnt2d start = curve->Value(first);
+			gp_Pnt2d end = curve->Value(last);
+			data[2] = start.X();
+			data[3] = start.Y();
+			data[4] = end.X();
+			data[5] = end.Y();
+		}
+		else if (curve->IsKind(STANDARD_TYPE(Geom2d_Circle)))
+		{
+			type = Circle;
+			const gp_Circ2d circle = Handle(Geom2d_Circle)::DownCast(curve)->Circ2d();
+			data[2] = circle.Location().X();
+			data[3] = circle.Location().Y();
+			data[4] = circle.Radius();
+			data[5] = circle.XAxis().Direction().Angle(gp::DX2d());
+			data[6] = _Sense(circle.Axis());
+		}
+
+		CurveTypes.push_back(type);
+		CurveReversed.push_back(reverse ? 1 : 0);
+		CurveData.insert(CurveData.end(), data, data + DataStride);
+		Curves.push_back(curve);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	static double _Sense(const gp_Ax22d& axis)
+	{
+		return axis.YAxis().Angle(axis.XAxis()) > 0 ? 1.0 : -1.0;
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			public enum class DrawingCurveType
+			{
+				// The edge has no curve in the drawing plane
+				Missing = 0,
+				Line = 1,
+				Circle = 2,
+				// Any other curve, use the curve object for rendering
+				Other = 3
+			};
+
+			//--------------------------------------------------------------------------------------------------
+
+			// 2D curves of all edges of a planar drawing shape, collected in one native traversal. Loops are
+			// the wires of the faces, or all edges of a shape without faces. Each loop consists of chains
+			// of connected edges, each chain of curves. The curve data has a stride of DataStride values:
+			// first and last parameter, then for lines start and end point, for circles center, radius,
+			// rotation and sense.
+			public ref class DrawingPaths sealed
+			{
+			public:
+				literal int DataStride = DrawingPathsData::DataStride;
+
+				//--------------------------------------------------------------------------------------------------
+
+				static DrawingPaths^ Build(Macad::Occt::TopoDS_Shape^ shape, double tolerance)
+				{
+					if (shape == nullptr)
+						throw gcnew System::ArgumentNullException("shape");
+
+					auto paths = gcnew DrawingPaths();
+					paths->_Data->Build(*shape->NativeInstance, tolerance);
+					paths->_CopyBuffers();
+					return paths;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				~DrawingPaths()
+				{
+					this->!DrawingPaths();
+				}
+
+				!DrawingPaths()
+				{
+					delete _Data;
+					_Data = nullptr;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				property int LoopCount { int get() { return _LoopChainStart->Length - 1; } }
+				property int ChainCount { int get() { return _ChainCurveStart->Length - 1; } }
+				property int CurveCount { int get() { return _CurveTypes->Length; } }
+
+				property array<int>^ LoopChainStart { array<int>^ get() { return _LoopChainStart; } }
+				property array<int>^ ChainCurveStart { array<int>^ get() { return _ChainCurveStart; } }
+
+				// Chains which could not be ordered contain all edges of the loop in original order
+				property array<bool>^ ChainIsOrdered { array<bool>^ get() { return _ChainIsOrdered; } }
+
+				property array<DrawingCurveType>^ CurveTypes { array<DrawingCurveType>^ get() { return _CurveTypes; } }
+				property array<bool>^ CurveReversed { array<bool>^ get() { return _CurveReversed; } }
+				property array<double>^ CurveData { array<double>^ get() { return _CurveData; } }
+
+				//--------------------------------------------------------------------------------------------------
+
+				Macad::Occt::Geom2d_Curve^ Curve(int index)
+				{
+					if (index < 0 || index >= CurveCount)
+						throw gcnew System::ArgumentOutOfRangeException("index");
+
+					const auto& curve = _Data->Curves[index];
+					return curve.IsNull() ? nullptr : Macad::Occt::Geom2d_Curve::CreateDowncasted(curve.get());
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				DrawingPathsData* _Data;
+				array<int>^ _LoopChainStart;
+				array<int>^ _ChainCurveStart;
+				array<bool>^ _ChainIsOrdered;
+				array<DrawingCurveType>^ _CurveTypes;
+				array<bool>^ _CurveReversed;
+				array<double>^ _CurveData;
+
+				//--------------------------------------------------------------------------------------------------
+
+				DrawingPaths()
+				{
+					_Data = new DrawingPathsData();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void _CopyBuffers()
+				{
+					_LoopChainStart = _ToArray<int>(_Data->LoopChainStart);
+					_ChainCurveStart = _ToArray<int>(_Data->ChainCurveStart);
+					_CurveData = _ToArray<double>(_Data->CurveData);
+
+					_ChainIsOrdered = gcnew array<bool>((int)_Data->ChainIsOrdered.size());
+					for (int i = 0; i < _ChainIsOrdered->Length; i++)
+					{
+						_ChainIsOrdered[i] = _Data->ChainIsOrdered[i] != 0;
+					}
+
+					_CurveTypes = gcnew array<DrawingCurveType>((int)_Data->CurveTypes.size());
+					_CurveReversed = gcnew array<bool>(_CurveTypes->Length);
+					for (int i = 0; i < _CurveTypes->Length; i++)
+					{
+						_CurveTypes[i] = (DrawingCurveType)_Data->CurveTypes[i];
+						_CurveReversed[i] = _Data->CurveReversed[i] != 0;
+					}
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				template<typename T>
+				static array<T>^ _ToArray(const std::vector<T>& values)
+				{
+					auto result = gcnew array<T>((int)values.size());
+					if (result->Length > 0)
+					{
+						pin_ptr<T> resultPtr = &result[0];
+						memcpy(resultPtr, values.data(), values.size() * sizeof(T));
+					}
+					return result;
+				}
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
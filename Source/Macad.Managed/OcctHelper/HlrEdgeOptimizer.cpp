@@ -0,0 +1,707 @@
+﻿#include "ManagedPCH.h"
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <BRep_Builder.hxx>
+#include <BRep_TEdge.hxx>
+#include <BRep_CurveOnSurface.hxx>
+#include <BRepBuilderAPI_MakeEdge2d.hxx>
+#include <Geom2d_Line.hxx>
+#include <Geom2d_Circle.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Line piece in the drawing plane. Source is the index of the input edge, or -1 if merged.
+struct HlrMergeLine
+{
+	double X0, Y0, X1, Y1;
+	int Source;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+// Arc in the drawing plane, the counter-clockwise angle range starts in [0, 2*PI)
+// and spans at most 2*PI. Source is the index of the input edge, or -1 if merged.
+struct HlrMergeArc
+{
+	double CX, CY, Radius;
+	double Start, End;
+	int Source;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+// Merges pieces of lines and arcs lying on the same line or circle. Candidates are grouped by sorting
+// and clustering their parameters: direction angle and distance from the origin for lines, radius and
+// center for arcs. Inside a group, the pieces are sorted along the line or circle and overlapping or
+// touching pieces are combined. Every piece must lie within tolerance of the first piece of its group,
+// others are passed through unchanged. Pieces covered completely by others count as duplicates.
+class HlrEdgeMerger
+{
+public:
+	int MergedLines = 0;
+	int MergedArcs = 0;
+	int Duplicates = 0;
+
+	//--------------------------------------------------------------------------------------------------
+
+	HlrEdgeMerger(double tolerance, double angularTolerance)
+		: _Tolerance(tolerance)
+		, _AngularTolerance(angularTolerance)
+	{
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	std::vector<HlrMergeLine> MergeLines(const std::vector<HlrMergeLine>& lines)
+	{
+		std::vector<HlrMergeLine> result;
+		std::vector<_Entry> entries;
+		entries.reserve(lines.size());
+		for (int i = 0; i < (int)lines.size(); i++)
+		{
+			const HlrMergeLine& line = lines[i];
+			const double dx = line.X1 - line.X0;
+			const double dy = line.Y1 - line.Y0;
+			if (std::hypot(dx, dy) <= _Tolerance)
+			{
+				result.push_back(line);
+				continue;
+			}
+
+			// Direction angle in [0, PI), lines near PI are moved to the start of the range
+			double angle = std::atan2(dy, dx);
+			if (angle < 0)
+				angle += M_PI;
+			double offset = -std::sin(angle) * line.X0 + std::cos(angle) * line.Y0;
+			if (angle > M_PI - _AngularTolerance)
+			{
+				angle -= M_PI;
+				offset = -offset;
+			}
+			entries.push_back({ i, angle, offset, 0 });
+		}
+
+		_Cluster(entries, 0, (int)entries.size(), &_Entry::A, _AngularTolerance, [&](int begin, int end)
+		{
+			_Cluster(entries, begin, end, &_Entry::B, _Tolerance, [&](int begin2, int end2)
+			{
+				_MergeCollinear(lines, entries, begin2, end2, result);
+			});
+		});
+		return result;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	std::vector<HlrMergeArc> MergeArcs(const std::vector<HlrMergeArc>& arcs)
+	{
+		std::vector<HlrMergeArc> result;
+		std::vector<_Entry> entries;
+		entries.reserve(arcs.size());
+		for (int i = 0; i < (int)arcs.size(); i++)
+		{
+			entries.push_back({ i, arcs[i].Radius, arcs[i].CX, arcs[i].CY });
+		}
+
+		_Cluster(entries, 0, (int)entries.size(), &_Entry::A, _Tolerance, [&](int begin, int end)
+		{
+			_Cluster(entries, begin, end, &_Entry::B, _Tolerance, [&](int begin2, int end2)
+			{
+				_Cluster(entries, begin2, end2, &_Entry::C, _Tolerance, [&](int begin3, int end3)
+				{
+					_MergeCocircular(arcs, entries, begin3, end3, result);
+				});
+			});
+		});
+		return result;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	struct _Entry
+	{
+		int Index;
+		double A, B, C;
+	};
+
+	struct _Interval
+	{
+		double Start, End;
+		int Index;
+
+		bool operator<(const _Interval& other) const
+		{
+			return Start < other.Start || (Start == other.Start && Index < other.Index);
+		}
+	};
+
+	struct _Run
+	{
+		double Start, End;
+		int First, Count;
+	};
+
+	double _Tolerance;
+	double _AngularTolerance;
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Sorts the range by the value and calls the function for every range of entries whose values
+	// differ less than the tolerance from their predecessor
+	template<typename TFunc>
+	static void _Cluster(std::vector<_Entry>& entries, int begin, int end, double _Entry::* value, double tolerance, TFunc func)
+	{
+		if (begin >= end)
+			return;
+
+		std::sort(entries.begin() + begin, entries.begin() + end, [value](const _Entry& a, const _Entry& b)
+		{
+			return a.*value < b.*value || (a.*value == b.*value && a.Index < b.Index);
+		});
+
+		int clusterBegin = begin;
+		for (int i = begin + 1; i <= end; i++)
+		{
+			if (i == end || entries[i].*value - entries[i - 1].*value > tolerance)
+			{
+				func(clusterBegin, i);
+				clusterBegin = i;
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _MergeCollinear(const std::vector<HlrMergeLine>& lines, const std::vector<_Entry>& entries, int begin, int end,
+						 std::vector<HlrMergeLine>& result)
+	{
+		// All pieces are measured on the line of the first one
+		const HlrMergeLine& reference = lines[entries[begin].Index];
+		const double baseX = reference.X0;
+		const double baseY = reference.Y0;
+		const double length = std::hypot(reference.X1 - baseX, reference.Y1 - baseY);
+		const double dirX = (reference.X1 - baseX) / length;
+		const double dirY = (reference.Y1 - baseY) / length;
+
+		std::vector<_Interval> intervals;
+		intervals.reserve(end - begin);
+		for (int i = begin; i < end; i++)
+		{
+			const HlrMergeLine& line = lines[entries[i].Index];
+			const double d0 = (line.X0 - baseX) * -dirY + (line.Y0 - baseY) * dirX;
+			const double d1 = (line.X1 - baseX) * -dirY + (line.Y1 - baseY) * dirX;
+			if (std::abs(d0) > _Tolerance || std::abs(d1) > _Tolerance)
+			{
+				result.push_back(line);
+				continue;
+			}
+
+			const double t0 = (line.X0 - baseX) * dirX + (line.Y0 - baseY) * dirY;
+			const double t1 = (line.X1 - baseX) * dirX + (line.Y1 - baseY) * dirY;
+			intervals.push_back({ std::min(t0, t1), std::max(t0, t1), entries[i].Index });
+		}
+
+		std::vector<_Run> runs;
+		_MergeIntervals(intervals, _Tolerance, runs, MergedLines);
+
+		for (const auto& run : runs)
+		{
+			if (run.Count == 1)
+			{
+				result.push_back(lines[run.First]);
+				continue;
+			}
+			result.push_back({ baseX + dirX * run.Start, baseY + dirY * run.Start,
+							   baseX + dirX * run.End, baseY + dirY * run.End, -1 });
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _MergeCocircular(const std::vector<HlrMergeArc>& arcs, const std::vector<_Entry>& entries, int begin, int end,
+						  std::vector<HlrMergeArc>& result)
+	{
+		// All pieces are measured on the circle of the first one
+		const HlrMergeArc& reference = arcs[entries[begin].Index];
+		const double angularTolerance = _Tolerance / reference.Radius;
+
+		std::vector<_Interval> intervals;
+		intervals.reserve(end - begin);
+		for (int i = begin; i < end; i++)
+		{
+			const HlrMergeArc& arc = arcs[entries[i].Index];
+			if (std::hypot(arc.CX - reference.CX, arc.CY - reference.CY) > _Tolerance
+				|| std::abs(arc.Radius - reference.Radius) > _Tolerance)
+			{
+				result.push_back(arc);
+				continue;
+			}
+			intervals.push_back({ arc.Start, arc.End, entries[i].Index });
+		}
+
+		std::vector<_Run> runs;
+		_MergeIntervals(intervals, angularTolerance, runs, MergedArcs);
+
+		// The last run can continue over the end of the range into the first one
+		if (runs.size() > 1 && runs.back().End >= runs.front().Start + 2 * M_PI - angularTolerance)
+		{
+			_Run& first = runs.front();
+			const _Run& last = runs.back();
+			if (last.End - 2 * M_PI >= first.End - angularTolerance)
+			{
+				Duplicates++;
+			}
+			else
+			{
+				MergedArcs++;
+			}
+			first.End = std::max(first.End, last.End - 2 * M_PI);
+			first.Start = last.Start - 2 * M_PI;
+			first.Count += last.Count;
+			runs.pop_back();
+			if (first.Start < 0)
+			{
+				first.Start += 2 * M_PI;
+				first.End += 2 * M_PI;
+			}
+		}
+
+		for (auto& run : runs)
+		{
+			if (run.Count == 1)
+			{
+				result.push_back(arcs[run.First]);
+				continue;
+			}
+			const double end = run.End - run.Start >= 2 * M_PI - angularTolerance ? run.Start + 2 * M_PI : run.End;
+			result.push_back({ reference.CX, reference.CY, reference.Radius, run.Start, end, -1 });
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Combines intervals which overlap or have a gap smaller than the tolerance
+	void _MergeIntervals(std::vector<_Interval>& intervals, double tolerance, std::vector<_Run>& runs, int& mergedCount)
+	{
+		std::sort(intervals.begin(), intervals.end());
+		for (const auto& interval : intervals)
+		{
+			if (!runs.empty() && interval.Start <= runs.back().End + tolerance)
+			{
+				_Run& run = runs.back();
+				if (interval.End <= run.End + tolerance)
+				{
+					Duplicates++;
+				}
+				else
+				{
+					mergedCount++;
+				}
+				run.End = std::max(run.End, interval.End);
+				run.Count++;
+				continue;
+			}
+			runs.push_back({ interval.Start, interval.End, interval.Index, 1 });
+		}
+	}
+};
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+// Orders edges into chains of connected edges. End points are connected if their distance is less than
+// the tolerance, they are found using a grid with the tolerance as cell size. Each chain is extended at
+// its end first, then at its start. The reversed flags tell which edges have to be reversed to follow
+// the direction of the chain.
+class HlrEdgeChainer
+{
+public:
+	struct Ends
+	{
+		double X0, Y0, X1, Y1;
+	};
+
+	//--------------------------------------------------------------------------------------------------
+
+	static int Chain(const std::vector<Ends>& ends, double tolerance, std::vector<int>& order, std::vector<bool>& reversed)
+	{
+		HlrEdgeChainer chainer(ends, tolerance);
+		return chainer._Chain(order, reversed);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	const std::vector<Ends>& _Ends;
+	double _Tolerance;
+	double _CellSize;
+	std::unordered_map<long long, std::vector<int>> _Grid;
+	std::vector<bool> _Visited;
+
+	//--------------------------------------------------------------------------------------------------
+
+	HlrEdgeChainer(const std::vector<Ends>& ends, double tolerance)
+		: _Ends(ends)
+		, _Tolerance(tolerance)
+		, _CellSize(std::max(tolerance, 1e-9))
+		, _Visited(ends.size(), false)
+	{
+		for (int i = 0; i < (int)ends.size(); i++)
+		{
+			if (!std::isfinite(ends[i].X0) || !std::isfinite(ends[i].X1))
+				continue;
+			_Grid[_CellKey(_Cell(ends[i].X0), _Cell(ends[i].Y0))].push_back(i * 2);
+			_Grid[_CellKey(_Cell(ends[i].X1), _Cell(ends[i].Y1))].push_back(i * 2 + 1);
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	long long _Cell(double value) const
+	{
+		return (long long)std::floor(value / _CellSize);
+	}
+
+	static long long _CellKey(long long x, long long y)
+	{
+		return x * 0x9E3779B1LL ^ y;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _Point(int endPoint, double& x, double& y) const
+	{
+		const Ends& ends = _Ends[endPoint / 2];
+		x = endPoint % 2 ? ends.X1 : ends.X0;
+		y = endPoint % 2 ? ends.Y1 : ends.Y0;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Returns the end point of an unvisited edge next to the point with the lowest edge index, or -1
+	int _FindNext(double x, double y) const
+	{
+		int found = -1;
+		const long long cellX = _Cell(x);
+		const long long cellY = _Cell(y);
+		for (long long i = cellX - 1; i <= cellX + 1; i++)
+		{
+			for (long long j = cellY - 1; j <= cellY + 1; j++)
+			{
+				auto it = _Grid.find(_CellKey(i, j));
+				if (it == _Grid.end())
+					continue;
+
+				for (int endPoint : it->second)
+				{
+					if (_Visited[endPoint / 2] || (found >= 0 && endPoint >= found))
+						continue;
+
+					double px, py;
+					_Point(endPoint, px, py);
+					if (std::hypot(px - x, py - y) <= _Tolerance)
+						found = endPoint;
+				}
+			}
+		}
+		return found;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	int _Chain(std::vector<int>& order, std::vector<bool>& reversed)
+	{
+		const int count = (int)_Ends.size();
+		order.clear();
+		order.reserve(count);
+		reversed.assign(count, false);
+
+		int chainCount = 0;
+		std::deque<int> chain;
+		for (int first = 0; first < count; first++)
+		{
+			if (_Visited[first])
+				continue;
+
+			_Visited[first] = true;
+			chain.assign(1, first);
+			chainCount++;
+
+			// Extend at the end
+			double x, y;
+			_Point(first * 2 + 1, x, y);
+			for (int next = _FindNext(x, y); next >= 0; next = _FindNext(x, y))
+			{
+				const int edge = next / 2;
+				_Visited[edge] = true;
+				reversed[edge] = next % 2 == 1;
+				chain.push_back(edge);
+				_Point(next ^ 1, x, y);
+			}
+
+			// Extend at the start
+			_Point(first * 2, x, y);
+			for (int next = _FindNext(x, y); next >= 0; next = _FindNext(x, y))
+			{
+				const int edge = next / 2;
+				_Visited[edge] = true;
+				reversed[edge] = next % 2 == 0;
+				chain.push_front(edge);
+				_Point(next ^ 1, x, y);
+			}
+
+			order.insert(order.end(), chain.begin(), chain.end());
+		}
+		return chainCount;
+	}
+};
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+// Reduces the edges of a HLR result. The edges are expected to be two-dimensional edges with one curve
+// in the drawing plane, as created by the HLR shape extractors. Lines and circles are merged, all other
+// edges are taken over unchanged. Finally, all edges are ordered into chains and added to a compound.
+class HlrEdgeOptimizerData
+{
+public:
+	int InputEdges = 0;
+	int OutputEdges = 0;
+	int MergedLines = 0;
+	int MergedArcs = 0;
+	int Duplicates = 0;
+	int Chains = 0;
+
+	//--------------------------------------------------------------------------------------------------
+
+	TopoDS_Compound Optimize(const TopoDS_Shape& shape, double tolerance)
+	{
+		TopTools_IndexedMapOfShape edgeMap;
+		TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+		InputEdges += edgeMap.Extent();
+
+		std::vector<TopoDS_Edge> inputEdges;
+		std::vector<HlrMergeLine> lines;
+		std::vector<HlrMergeArc> arcs;
+		std::vector<TopoDS_Edge> edges;
+		std::vector<HlrEdgeChainer::Ends> ends;
+
+		for (int i = 1; i <= edgeMap.Extent(); i++)
+		{
+			const TopoDS_Edge& edge = TopoDS::Edge(edgeMap(i));
+			const int index = (int)inputEdges.size();
+			inputEdges.push_back(edge);
+
+			double first = 0, last = 0;
+			Handle(Geom2d_Curve) curve = _GetCurve(edge, first, last);
+			if (curve.IsNull())
+			{
+				_AddEdge(edge, edges, ends);
+				continue;
+			}
+
+			if (curve->IsKind(STANDARD_TYPE(Geom2d_Line)))
+			{
+				const gp_Pnt2d p0 = curve->Value(first);
+				const gp_Pnt2d p1 = curve->Value(last);
+				lines.push_back({ p0.X(), p0.Y(), p1.X(), p1.Y(), index });
+			}
+			else if (curve->IsKind(STANDARD_TYPE(Geom2d_Circle)))
+			{
+				const gp_Circ2d circle = Handle(Geom2d_Circle)::DownCast(curve)->Circ2d();
+				const gp_Pnt2d center = circle.Location();
+				const gp_Pnt2d start = curve->Value(circle.IsDirect() ? first : last);
+				const double sweep = std::min(last - first, 2 * M_PI);
+				double angle = std::atan2(start.Y() - center.Y(), start.X() - center.X());
+				if (angle < 0)
+					angle += 2 * M_PI;
+				arcs.push_back({ center.X(), center.Y(), circle.Radius(), angle, angle + sweep, index });
+			}
+			else
+			{
+				_AddEdge(edge, edges, ends);
+			}
+		}
+
+		HlrEdgeMerger merger(tolerance, _AngularTolerance);
+		for (const auto& line : merger.MergeLines(lines))
+		{
+			if (line.Source >= 0)
+			{
+				_AddEdge(inputEdges[line.Source], edges, ends);
+				continue;
+			}
+
+			BRepBuilderAPI_MakeEdge2d makeEdge(gp_Pnt2d(line.X0, line.Y0), gp_Pnt2d(line.X1, line.Y1));
+			if (makeEdge.IsDone())
+				_AddEdge(makeEdge.Edge(), edges, ends);
+		}
+
+		for (const auto& arc : merger.MergeArcs(arcs))
+		{
+			if (arc.Source >= 0)
+			{
+				_AddEdge(inputEdges[arc.Source], edges, ends);
+				continue;
+			}
+
+			Handle(Geom2d_Circle) circle = new Geom2d_Circle(gp_Ax2d(gp_Pnt2d(arc.CX, arc.CY), gp::DX2d()), arc.Radius);
+			BRepBuilderAPI_MakeEdge2d makeEdge(circle, arc.Start, std::min(arc.End, arc.Start + 2 * M_PI));
+			if (makeEdge.IsDone())
+				_AddEdge(makeEdge.Edge(), edges, ends);
+		}
+
+		MergedLines += merger.MergedLines;
+		MergedArcs += merger.MergedArcs;
+		Duplicates += merger.Duplicates;
+
+		// Order edges into chains
+		std::vector<int> order;
+		std::vector<bool> reversed;
+		Chains += HlrEdgeChainer::Chain(ends, tolerance, order, reversed);
+
+		BRep_Builder builder;
+		TopoDS_Compound result;
+		builder.MakeCompound(result);
+		for (int index : order)
+		{
+			builder.Add(result, reversed[index] ? edges[index].Reversed() : edges[index]);
+		}
+		OutputEdges += (int)order.size();
+		return result;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	static constexpr double _AngularTolerance = 1e-6;
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Returns the curve in the drawing plane, if the edge has exactly one
+	static Handle(Geom2d_Curve) _GetCurve(const TopoDS_Edge& edge, double& first, double& last)
+	{
+		Handle(BRep_TEdge) tedge = Handle(BRep_TEdge)::DownCast(edge.TShape());
+		if (tedge.IsNull())
+			return nullptr;
+
+		Handle(BRep_CurveOnSurface) found;
+		for (BRep_ListIteratorOfListOfCurveRepresentation it(tedge->Curves()); it.More(); it.Next())
+		{
+			Handle(BRep_CurveOnSurface) curveRep = Handle(BRep_CurveOnSurface)::DownCast(it.Value());
+			if (curveRep.IsNull())
+				continue;
+			if (!found.IsNull())
+				return nullptr;
+			found = curveRep;
+		}
+		if (found.IsNull())
+			return nullptr;
+
+		first = found->First();
+		last = found->Last();
+		return found->PCurve();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	static void _AddEdge(const TopoDS_Edge& edge, std::vector<TopoDS_Edge>& edges, std::vector<HlrEdgeChainer::Ends>& ends)
+	{
+		edges.push_back(edge);
+
+		const TopoDS_Vertex v0 = TopExp::FirstVertex(edge, Standard_True);
+		const TopoDS_Vertex v1 = TopExp::LastVertex(edge, Standard_True);
+		if (v0.IsNull() || v1.IsNull())
+		{
+			// Cannot be connected to other edges
+			const double nan = std::numeric_limits<double>::quiet_NaN();
+			ends.push_back({ nan, nan, nan, nan });
+			return;
+		}
+
+		const gp_Pnt p0 = BRep_Tool::Pnt(v0);
+		const gp_Pnt p1 = BRep_Tool::Pnt(v1);
+		ends.push_back({ p0.X(), p0.Y(), p1.X(), p1.Y() });
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			// Reduces the number of edges of HLR results. Connected pieces of the same line or circle
+			// are merged, duplicate and overlapping pieces are removed, and the edges are ordered into
+			// chains. The statistics sum up all shapes optimized with this instance.
+			public ref class HlrEdgeOptimizer sealed
+			{
+			public:
+				HlrEdgeOptimizer(double tolerance)
+				{
+					if (tolerance <= 0)
+						throw gcnew System::ArgumentOutOfRangeException("tolerance");
+
+					_Tolerance = tolerance;
+					_Data = new HlrEdgeOptimizerData();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				~HlrEdgeOptimizer()
+				{
+					this->!HlrEdgeOptimizer();
+				}
+
+				!HlrEdgeOptimizer()
+				{
+					delete _Data;
+					_Data = nullptr;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				property double Tolerance { double get() { return _Tolerance; } }
+
+				property int InputEdgeCount { int get() { return _Data->InputEdges; } }
+				property int OutputEdgeCount { int get() { return _Data->OutputEdges; } }
+				property int MergedLineCount { int get() { return _Data->MergedLines; } }
+				property int MergedArcCount { int get() { return _Data->MergedArcs; } }
+				property int DuplicateCount { int get() { return _Data->Duplicates; } }
+				property int ChainCount { int get() { return _Data->Chains; } }
+
+				//--------------------------------------------------------------------------------------------------
+
+				Macad::Occt::TopoDS_Compound^ Optimize(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					if (shape == nullptr)
+						throw gcnew System::ArgumentNullException("shape");
+
+					return gcnew Macad::Occt::TopoDS_Compound(new ::TopoDS_Compound(_Data->Optimize(*shape->NativeInstance, _Tolerance)));
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				double _Tolerance;
+				HlrEdgeOptimizerData* _Data;
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
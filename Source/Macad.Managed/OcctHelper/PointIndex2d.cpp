@@ -0,0 +1,384 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Two-dimensional kd-tree of keyed points. The tree is stored implicitly in an array, the median
+// of every range is the splitting node of that range. Added and moved points are kept in a small
+// unsorted overflow list, the tree is rebuilt when the overflow list or the number of removed tree
+// entries gets too large. This keeps single updates cheap while queries stay logarithmic.
+class PointIndex2dData
+{
+public:
+	struct Entry
+	{
+		double X, Y;
+		int Key;
+	};
+
+	//--------------------------------------------------------------------------------------------------
+
+	int Count() const
+	{
+		return (int)(_TreeSlots.size() + _Overflow.size());
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void Clear()
+	{
+		_Tree.clear();
+		_Removed.clear();
+		_RemovedCount = 0;
+		_TreeSlots.clear();
+		_Overflow.clear();
+		_OverflowSlots.clear();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void Build(std::vector<Entry>&& entries)
+	{
+		Clear();
+		_Tree = std::move(entries);
+		_Removed.assign(_Tree.size(), false);
+		_Split(0, (int)_Tree.size(), 0);
+
+		_TreeSlots.reserve(_Tree.size());
+		for (int i = 0; i < (int)_Tree.size(); i++)
+		{
+			_TreeSlots[_Tree[i].Key] = i;
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void Set(int key, double x, double y)
+	{
+		_RemoveFromTree(key);
+
+		auto it = _OverflowSlots.find(key);
+		if (it != _OverflowSlots.end())
+		{
+			_Overflow[it->second] = { x, y, key };
+			return;
+		}
+
+		_OverflowSlots[key] = (int)_Overflow.size();
+		_Overflow.push_back({ x, y, key });
+		_CheckBalance();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	bool Remove(int key)
+	{
+		if (_RemoveFromTree(key))
+		{
+			_CheckBalance();
+			return true;
+		}
+
+		auto it = _OverflowSlots.find(key);
+		if (it == _OverflowSlots.end())
+			return false;
+
+		// Move last entry into the gap
+		int slot = it->second;
+		_OverflowSlots.erase(it);
+		if (slot != (int)_Overflow.size() - 1)
+		{
+			_Overflow[slot] = _Overflow.back();
+			_OverflowSlots[_Overflow[slot].Key] = slot;
+		}
+		_Overflow.pop_back();
+		return true;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Returns the key of the nearest point closer than the given squared distance, or -1
+	int FindNearest(double x, double y, double& distanceSq) const
+	{
+		int key = -1;
+		_FindNearest(0, (int)_Tree.size(), 0, x, y, key, distanceSq);
+
+		for (const auto& entry : _Overflow)
+		{
+			double dsq = _DistanceSq(entry, x, y);
+			if (dsq < distanceSq)
+			{
+				distanceSq = dsq;
+				key = entry.Key;
+			}
+		}
+		return key;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Collects all points closer than the given distance, sorted by distance
+	void FindInRadius(double x, double y, double radius, std::vector<std::pair<double, int>>& result) const
+	{
+		double radiusSq = radius * radius;
+		_FindInRadius(0, (int)_Tree.size(), 0, x, y, radiusSq, result);
+
+		for (const auto& entry : _Overflow)
+		{
+			double dsq = _DistanceSq(entry, x, y);
+			if (dsq < radiusSq)
+			{
+				result.emplace_back(dsq, entry.Key);
+			}
+		}
+
+		std::sort(result.begin(), result.end());
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	std::vector<Entry> _Tree;
+	std::vector<bool> _Removed;
+	int _RemovedCount = 0;
+	std::unordered_map<int, int> _TreeSlots;
+	std::vector<Entry> _Overflow;
+	std::unordered_map<int, int> _OverflowSlots;
+
+	//--------------------------------------------------------------------------------------------------
+
+	static double _DistanceSq(const Entry& entry, double x, double y)
+	{
+		double dx = entry.X - x;
+		double dy = entry.Y - y;
+		return dx * dx + dy * dy;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _Split(int begin, int end, int axis)
+	{
+		if (end - begin <= 1)
+			return;
+
+		int mid = begin + (end - begin) / 2;
+		std::nth_element(_Tree.begin() + begin, _Tree.begin() + mid, _Tree.begin() + end,
+						 [axis](const Entry& a, const Entry& b) { return axis == 0 ? a.X < b.X : a.Y < b.Y; });
+
+		_Split(begin, mid, axis ^ 1);
+		_Split(mid + 1, end, axis ^ 1);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	bool _RemoveFromTree(int key)
+	{
+		auto it = _TreeSlots.find(key);
+		if (it == _TreeSlots.end())
+			return false;
+
+		// The entry stays in the tree as splitting node, but is not reported anymore
+		_Removed[it->second] = true;
+		_RemovedCount++;
+		_TreeSlots.erase(it);
+		return true;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _CheckBalance()
+	{
+		size_t treeSize = _Tree.size();
+		if (_Overflow.size() <= 32 + treeSize / 16 && (size_t)_RemovedCount <= 32 + treeSize / 2)
+			return;
+
+		std::vector<Entry> entries;
+		entries.reserve(Count());
+		for (size_t i = 0; i < treeSize; i++)
+		{
+			if (!_Removed[i])
+				entries.push_back(_Tree[i]);
+		}
+		entries.insert(entries.end(), _Overflow.begin(), _Overflow.end());
+		Build(std::move(entries));
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _FindNearest(int begin, int end, int axis, double x, double y, int& key, double& distanceSq) const
+	{
+		if (begin >= end)
+			return;
+
+		int mid = begin + (end - begin) / 2;
+		const Entry& node = _Tree[mid];
+		if (!_Removed[mid])
+		{
+			double dsq = _DistanceSq(node, x, y);
+			if (dsq < distanceSq)
+			{
+				distanceSq = dsq;
+				key = node.Key;
+			}
+		}
+
+		// Descend into the half containing the point first, the other one only if it can be closer
+		double delta = axis == 0 ? x - node.X : y - node.Y;
+		if (delta < 0)
+		{
+			_FindNearest(begin, mid, axis ^ 1, x, y, key, distanceSq);
+			if (delta * delta < distanceSq)
+				_FindNearest(mid + 1, end, axis ^ 1, x, y, key, distanceSq);
+		}
+		else
+		{
+			_FindNearest(mid + 1, end, axis ^ 1, x, y, key, distanceSq);
+			if (delta * delta < distanceSq)
+				_FindNearest(begin, mid, axis ^ 1, x, y, key, distanceSq);
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _FindInRadius(int begin, int end, int axis, double x, double y, double radiusSq, std::vector<std::pair<double, int>>& result) const
+	{
+		if (begin >= end)
+			return;
+
+		int mid = begin + (end - begin) / 2;
+		const Entry& node = _Tree[mid];
+		if (!_Removed[mid])
+		{
+			double dsq = _DistanceSq(node, x, y);
+			if (dsq < radiusSq)
+			{
+				result.emplace_back(dsq, node.Key);
+			}
+		}
+
+		double delta = axis == 0 ? x - node.X : y - node.Y;
+		if (delta < 0 || delta * delta < radiusSq)
+			_FindInRadius(begin, mid, axis ^ 1, x, y, radiusSq, result);
+		if (delta >= 0 || delta * delta < radiusSq)
+			_FindInRadius(mid + 1, end, axis ^ 1, x, y, radiusSq, result);
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			// Spatial index of keyed 2D points for nearest point and radius queries in logarithmic time.
+			// Single points can be added, moved and removed without rebuilding the whole index.
+			public ref class PointIndex2d sealed
+			{
+			public:
+				PointIndex2d()
+				{
+					_Data = new PointIndex2dData();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				~PointIndex2d()
+				{
+					this->!PointIndex2d();
+				}
+
+				!PointIndex2d()
+				{
+					delete _Data;
+					_Data = nullptr;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				property int Count { int get() { return _Data->Count(); } }
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Replaces the content of the index with the given points
+				void Build(System::Collections::Generic::Dictionary<int, Macad::Occt::Pnt2d>^ points)
+				{
+					if (points == nullptr)
+						throw gcnew System::ArgumentNullException("points");
+
+					std::vector<PointIndex2dData::Entry> entries;
+					entries.reserve(points->Count);
+					for each (auto kvp in points)
+					{
+						entries.push_back({ kvp.Value.X, kvp.Value.Y, kvp.Key });
+					}
+					_Data->Build(std::move(entries));
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void Clear()
+				{
+					_Data->Clear();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Adds the point, or moves it if the key is already in the index
+				void Set(int key, Macad::Occt::Pnt2d point)
+				{
+					_Data->Set(key, point.X, point.Y);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				bool Remove(int key)
+				{
+					return _Data->Remove(key);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Finds the nearest point closer than maxDistance
+				bool FindNearest(Macad::Occt::Pnt2d point, double maxDistance, [System::Runtime::InteropServices::Out] int% key, [System::Runtime::InteropServices::Out] double% distance)
+				{
+					double distanceSq = maxDistance < System::Double::MaxValue ? maxDistance * maxDistance : System::Double::PositiveInfinity;
+					key = _Data->FindNearest(point.X, point.Y, distanceSq);
+					distance = key >= 0 ? System::Math::Sqrt(distanceSq) : maxDistance;
+					return key >= 0;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Returns the keys of all points closer than radius, the nearest first
+				array<int>^ FindInRadius(Macad::Occt::Pnt2d point, double radius)
+				{
+					std::vector<std::pair<double, int>> found;
+					_Data->FindInRadius(point.X, point.Y, radius, found);
+
+					auto keys = gcnew array<int>((int)found.size());
+					for (int i = 0; i < keys->Length; i++)
+					{
+						keys[i] = found[i].second;
+					}
+					return keys;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				PointIndex2dData* _Data;
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
@@ -0,0 +1,102 @@
+﻿#include "ManagedPCH.h"
+
+#include <TopoDS_Builder.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Builds a compound of transformed instances of a shape. Rigid transformations only set the location
+// of the instance, so all instances share the TShapes of the source. Scaling or mirroring transformations
+// need a copy of the geometry, they are done the same way BRepBuilderAPI_Transform would do them.
+class ShapeArrayData
+{
+public:
+	static bool MakeCompound(const TopoDS_Shape& shape, const gp_Trsf* transforms, int count, TopoDS_Compound& result)
+	{
+		TopoDS_Builder builder;
+		builder.MakeCompound(result);
+
+		for (int i = 0; i < count; i++)
+		{
+			const gp_Trsf& transform = transforms[i];
+			if (_IsRigid(transform))
+			{
+				builder.Add(result, shape.Moved(TopLoc_Location(transform)));
+				continue;
+			}
+
+			try
+			{
+				BRepBuilderAPI_Transform makeTransform(shape, transform);
+				if (!makeTransform.IsDone())
+					return false;
+				builder.Add(result, makeTransform.Shape());
+			}
+			catch (const Standard_Failure&)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	// Same condition BRepBuilderAPI_Transform uses to decide between moving and copying
+	static bool _IsRigid(const gp_Trsf& transform)
+	{
+		return !transform.IsNegative()
+			&& Abs(Abs(transform.ScaleFactor()) - 1.0) <= TopLoc_Location::ScalePrec();
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			public ref class ShapeArrayBuilder sealed
+			{
+			public:
+				// Creates a compound with one instance of the shape per transformation. Returns null
+				// if a transformation which needs a copy of the geometry failed.
+				static Macad::Occt::TopoDS_Compound^ MakeCompound(Macad::Occt::TopoDS_Shape^ shape, array<Macad::Occt::Trsf>^ transforms)
+				{
+					if (shape == nullptr)
+						throw gcnew System::ArgumentNullException("shape");
+					if (transforms == nullptr)
+						throw gcnew System::ArgumentNullException("transforms");
+
+					auto result = new ::TopoDS_Compound();
+					bool success;
+					if (transforms->Length > 0)
+					{
+						pin_ptr<Macad::Occt::Trsf> transformsPtr = &transforms[0];
+						success = ShapeArrayData::MakeCompound(*shape->NativeInstance, reinterpret_cast<const ::gp_Trsf*>(transformsPtr), transforms->Length, *result);
+					}
+					else
+					{
+						success = ShapeArrayData::MakeCompound(*shape->NativeInstance, nullptr, 0, *result);
+					}
+
+					if (!success)
+					{
+						delete result;
+						return nullptr;
+					}
+					return gcnew Macad::Occt::TopoDS_Compound(result);
+				}
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
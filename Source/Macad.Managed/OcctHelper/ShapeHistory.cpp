@@ -0,0 +1,224 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include <NCollection_IndexedMap.hxx>
+#include <TopTools_OrientedShapeMapHasher.hxx>
+#include <BRepBuilderAPI_MakeShape.hxx>
+#include "OcctExtensions/TopExp_DistinctShapes.h"
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// History of the faces, edges and vertices of the source shapes of a builder, collected in one pass.
+// The inputs are the distinct subshapes in the order of the subshape lists, the faces, edges and vertices
+// of the first source shape, then those of the next one. The modified and generated shapes are stored
+// once in a result map and referenced by index in compressed rows, one row per input. Generated shapes
+// are only collected for modified inputs, deleted inputs are only checked if they are not modified.
+class ShapeHistoryData
+{
+public:
+	std::vector<TopoDS_Shape> Inputs;
+	NCollection_IndexedMap<TopoDS_Shape, TopTools_OrientedShapeMapHasher> Results;
+
+	std::vector<int> ModifiedStart{ 0 }, Modified;
+	std::vector<int> GeneratedStart{ 0 }, Generated;
+	std::vector<int> Deleted;
+
+	//--------------------------------------------------------------------------------------------------
+
+	void Add(BRepBuilderAPI_MakeShape& makeShape, const TopoDS_Shape& source)
+	{
+		_Add(makeShape, source, TopAbs_FACE, true);
+		_Add(makeShape, source, TopAbs_EDGE, true);
+		_Add(makeShape, source, TopAbs_VERTEX, false);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	void _Add(BRepBuilderAPI_MakeShape& makeShape, const TopoDS_Shape& source, TopAbs_ShapeEnum type, bool preferForward)
+	{
+		// Same selection of subshapes as TopoDSHelper
+		const size_t first = Inputs.size();
+		TopExp_DistinctShapes::Collect(source, type, preferForward, Inputs);
+
+		for (size_t input = first; input < Inputs.size(); input++)
+		{
+			const TopoDS_Shape& shape = Inputs[input];
+			_AddResults(makeShape.Modified(shape), Modified);
+			if (Modified.size() == (size_t)ModifiedStart.back())
+			{
+				if (_IsDeleted(makeShape, shape))
+					Deleted.push_back((int)input);
+			}
+			else
+			{
+				_AddResults(makeShape.Generated(shape), Generated);
+			}
+			ModifiedStart.push_back((int)Modified.size());
+			GeneratedStart.push_back((int)Generated.size());
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _AddResults(const TopTools_ListOfShape& shapes, std::vector<int>& indices)
+	{
+		for (TopTools_ListIteratorOfListOfShape it(shapes); it.More(); it.Next())
+		{
+			indices.push_back(Results.Add(it.Value()) - 1);
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	static bool _IsDeleted(BRepBuilderAPI_MakeShape& makeShape, const TopoDS_Shape& shape)
+	{
+		try
+		{
+			return makeShape.IsDeleted(shape) == Standard_True;
+		}
+		catch (const Standard_Failure&)
+		{
+			// The builder does not know the shape, so it is neither deleted nor modified
+			return false;
+		}
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			// Modified, generated and deleted subshapes of the source shapes of a builder, collected in
+			// one native call. Inputs and results are referenced by index, the rows of an input are the
+			// ranges [Start[input], Start[input + 1]) in the index arrays. Wrappers of the input and result
+			// shapes are only created when requested.
+			public ref class ShapeHistory sealed
+			{
+			public:
+				static ShapeHistory^ Collect(Macad::Occt::BRepBuilderAPI_MakeShape^ makeShape, System::Collections::Generic::IEnumerable<Macad::Occt::TopoDS_Shape^>^ sourceShapes)
+				{
+					if (makeShape == nullptr)
+						throw gcnew System::ArgumentNullException("makeShape");
+					if (sourceShapes == nullptr)
+						throw gcnew System::ArgumentNullException("sourceShapes");
+
+					auto history = gcnew ShapeHistory();
+					for each (auto sourceShape in sourceShapes)
+					{
+						if (sourceShape == nullptr)
+							throw gcnew System::ArgumentNullException("sourceShapes");
+						history->_Data->Add(*makeShape->NativeInstance, *sourceShape->NativeInstance);
+					}
+					history->_CopyIndices();
+					return history;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				~ShapeHistory()
+				{
+					this->!ShapeHistory();
+				}
+
+				!ShapeHistory()
+				{
+					delete _Data;
+					_Data = nullptr;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				property int InputCount { int get() { return (int)_Data->Inputs.size(); } }
+				property int ResultCount { int get() { return _Data->Results.Extent(); } }
+
+				property array<int>^ ModifiedStart { array<int>^ get() { return _ModifiedStart; } }
+				property array<int>^ Modified { array<int>^ get() { return _Modified; } }
+				property array<int>^ GeneratedStart { array<int>^ get() { return _GeneratedStart; } }
+				property array<int>^ Generated { array<int>^ get() { return _Generated; } }
+
+				// Indices of the inputs which are deleted, in ascending order
+				property array<int>^ Deleted { array<int>^ get() { return _Deleted; } }
+
+				//--------------------------------------------------------------------------------------------------
+
+				Macad::Occt::TopoDS_Shape^ Input(int index)
+				{
+					if (index < 0 || index >= InputCount)
+						throw gcnew System::ArgumentOutOfRangeException("index");
+
+					if (_InputShapes[index] == nullptr)
+						_InputShapes[index] = gcnew Macad::Occt::TopoDS_Shape(new ::TopoDS_Shape(_Data->Inputs[index]));
+					return _InputShapes[index];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				Macad::Occt::TopoDS_Shape^ Result(int index)
+				{
+					if (index < 0 || index >= ResultCount)
+						throw gcnew System::ArgumentOutOfRangeException("index");
+
+					if (_ResultShapes[index] == nullptr)
+						_ResultShapes[index] = gcnew Macad::Occt::TopoDS_Shape(new ::TopoDS_Shape(_Data->Results.FindKey(index + 1)));
+					return _ResultShapes[index];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				ShapeHistoryData* _Data;
+				array<int>^ _ModifiedStart;
+				array<int>^ _Modified;
+				array<int>^ _GeneratedStart;
+				array<int>^ _Generated;
+				array<int>^ _Deleted;
+				array<Macad::Occt::TopoDS_Shape^>^ _InputShapes;
+				array<Macad::Occt::TopoDS_Shape^>^ _ResultShapes;
+
+				//--------------------------------------------------------------------------------------------------
+
+				ShapeHistory()
+				{
+					_Data = new ShapeHistoryData();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void _CopyIndices()
+				{
+					_ModifiedStart = _ToArray(_Data->ModifiedStart);
+					_Modified = _ToArray(_Data->Modified);
+					_GeneratedStart = _ToArray(_Data->GeneratedStart);
+					_Generated = _ToArray(_Data->Generated);
+					_Deleted = _ToArray(_Data->Deleted);
+					_InputShapes = gcnew array<Macad::Occt::TopoDS_Shape^>(InputCount);
+					_ResultShapes = gcnew array<Macad::Occt::TopoDS_Shape^>(ResultCount);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<int>^ _ToArray(const std::vector<int>& values)
+				{
+					auto result = gcnew array<int>((int)values.size());
+					if (result->Length > 0)
+					{
+						pin_ptr<int> resultPtr = &result[0];
+						memcpy(resultPtr, values.data(), values.size() * sizeof(int));
+					}
+					return result;
+				}
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
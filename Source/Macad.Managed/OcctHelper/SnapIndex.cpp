@@ -0,0 +1,522 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <Bnd_Box.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <GCPnts_AbscissaPoint.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_MapOfShape.hxx>
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Bounding volume hierarchy over the snap primitives of one body. Primitives are points (vertices
+// and edge midpoints) and segments of the edge polylines. The hierarchy is built top down with a
+// median split on the largest axis, nodes are stored depth first with the right child at Next.
+class SnapIndexBvh
+{
+public:
+	enum Kind
+	{
+		Vertex = 1,
+		EdgeMidpoint = 2,
+		Edge = 4
+	};
+
+	struct Primitive
+	{
+		gp_XYZ P0, P1;
+		int Kind;
+		int Edge;
+		double U0, U1;
+	};
+
+	struct Node
+	{
+		gp_XYZ Min, Max;
+		int Begin, End;
+		int Next;
+	};
+
+	struct Hit
+	{
+		int Primitive = -1;
+		double Distance;
+		double Fraction;
+	};
+
+	std::vector<Primitive> Primitives;
+	std::vector<Node> Nodes;
+
+	//--------------------------------------------------------------------------------------------------
+
+	void Build()
+	{
+		Nodes.clear();
+		if (!Primitives.empty())
+		{
+			Nodes.reserve(2 * Primitives.size() / LeafSize + 1);
+			_Build(0, (int)Primitives.size());
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Finds the primitive of one of the given kinds nearest to the line, if closer than hit.Distance
+	void FindNearest(const gp_XYZ& origin, const gp_XYZ& direction, int kinds, Hit& hit) const
+	{
+		if (Nodes.empty())
+			return;
+
+		int stack[64];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const int nodeIndex = stack[--top];
+			const Node& node = Nodes[nodeIndex];
+			if (!_LineHitsBox(origin, direction, node.Min, node.Max, hit.Distance))
+				continue;
+
+			if (node.Next < 0)
+			{
+				for (int i = node.Begin; i < node.End; i++)
+				{
+					const Primitive& primitive = Primitives[i];
+					if ((primitive.Kind & kinds) == 0)
+						continue;
+
+					double fraction = 0.0;
+					const double distance = primitive.Kind == Edge
+												? SegmentDistance(origin, direction, primitive.P0, primitive.P1, fraction)
+												: PointDistance(origin, direction, primitive.P0);
+					if (distance < hit.Distance)
+					{
+						hit.Primitive = i;
+						hit.Distance = distance;
+						hit.Fraction = fraction;
+					}
+				}
+				continue;
+			}
+
+			stack[top++] = node.Next;
+			stack[top++] = nodeIndex + 1;
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	static double PointDistance(const gp_XYZ& origin, const gp_XYZ& direction, const gp_XYZ& point)
+	{
+		const gp_XYZ w = point - origin;
+		return (w - direction * w.Dot(direction)).Modulus();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Distance of the infinite line to the segment, the fraction is the position of the nearest point on the segment
+	static double SegmentDistance(const gp_XYZ& origin, const gp_XYZ& direction, const gp_XYZ& p0, const gp_XYZ& p1, double& fraction)
+	{
+		// Project the segment into the plane perpendicular to the line, the line becomes the origin
+		const gp_XYZ w0 = p0 - origin;
+		const gp_XYZ a = w0 - direction * w0.Dot(direction);
+		const gp_XYZ segment = p1 - p0;
+		const gp_XYZ b = segment - direction * segment.Dot(direction);
+
+		const double lengthSq = b.SquareModulus();
+		fraction = lengthSq > 1e-24 ? std::min(1.0, std::max(0.0, -a.Dot(b) / lengthSq)) : 0.0;
+		return (a + b * fraction).Modulus();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	static const int LeafSize = 4;
+
+	//--------------------------------------------------------------------------------------------------
+
+	int _Build(int begin, int end)
+	{
+		const int nodeIndex = (int)Nodes.size();
+		Nodes.push_back(Node());
+
+		gp_XYZ min(RealLast(), RealLast(), RealLast());
+		gp_XYZ max(RealFirst(), RealFirst(), RealFirst());
+		for (int i = begin; i < end; i++)
+		{
+			const Primitive& primitive = Primitives[i];
+			for (int c = 1; c <= 3; c++)
+			{
+				min.SetCoord(c, std::min({ min.Coord(c), primitive.P0.Coord(c), primitive.P1.Coord(c) }));
+				max.SetCoord(c, std::max({ max.Coord(c), primitive.P0.Coord(c), primitive.P1.Coord(c) }));
+			}
+		}
+
+		Nodes[nodeIndex] = { min, max, begin, end, -1 };
+		if (end - begin <= LeafSize)
+			return nodeIndex;
+
+		const gp_XYZ extent = max - min;
+		const int axis = extent.X() >= extent.Y() && extent.X() >= extent.Z() ? 1 : extent.Y() >= extent.Z() ? 2 : 3;
+		const int mid = begin + (end - begin) / 2;
+		std::nth_element(Primitives.begin() + begin, Primitives.begin() + mid, Primitives.begin() + end,
+						 [axis](const Primitive& a, const Primitive& b)
+						 {
+							 return a.P0.Coord(axis) + a.P1.Coord(axis) < b.P0.Coord(axis) + b.P1.Coord(axis);
+						 });
+
+		_Build(begin, mid);
+		Nodes[nodeIndex].Next = _Build(mid, end);
+		return nodeIndex;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Slab test of the infinite line against the box grown by the tolerance
+	static bool _LineHitsBox(const gp_XYZ& origin, const gp_XYZ& direction, const gp_XYZ& min, const gp_XYZ& max, double tolerance)
+	{
+		double tMin = RealFirst();
+		double tMax = RealLast();
+		for (int c = 1; c <= 3; c++)
+		{
+			const double lo = min.Coord(c) - tolerance - origin.Coord(c);
+			const double hi = max.Coord(c) + tolerance - origin.Coord(c);
+			const double d = direction.Coord(c);
+			if (std::abs(d) < 1e-12)
+			{
+				if (lo > 0.0 || hi < 0.0)
+					return false;
+				continue;
+			}
+
+			double t0 = lo / d;
+			double t1 = hi / d;
+			if (t0 > t1)
+				std::swap(t0, t1);
+			tMin = std::max(tMin, t0);
+			tMax = std::min(tMax, t1);
+			if (tMin > tMax)
+				return false;
+		}
+		return true;
+	}
+};
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+// Snap primitives of one body, the edges are kept for the refinement of hits on the polylines
+class SnapIndexBody
+{
+public:
+	TopoDS_Shape Shape;
+	std::vector<TopoDS_Edge> Edges;
+	SnapIndexBvh Bvh;
+
+	//--------------------------------------------------------------------------------------------------
+
+	explicit SnapIndexBody(const TopoDS_Shape& shape)
+		: Shape(shape)
+	{
+		TopTools_IndexedMapOfShape vertices;
+		TopExp::MapShapes(shape, TopAbs_VERTEX, vertices);
+		for (int i = 1; i <= vertices.Extent(); i++)
+		{
+			const gp_XYZ point = BRep_Tool::Pnt(TopoDS::Vertex(vertices(i))).XYZ();
+			Bvh.Primitives.push_back({ point, point, SnapIndexBvh::Vertex, -1, 0.0, 0.0 });
+		}
+
+		TopTools_IndexedMapOfShape edges;
+		TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+		const double deflection = _Deflection(Bvh.Primitives);
+		for (int i = 1; i <= edges.Extent(); i++)
+		{
+			const TopoDS_Edge& edge = TopoDS::Edge(edges(i));
+			if (BRep_Tool::Degenerated(edge) || !BRep_Tool::IsGeometric(edge))
+				continue;
+
+			try
+			{
+				_AddEdge(edge, deflection);
+			}
+			catch (Standard_Failure&)
+			{
+				// Edges which cannot be discretized are not snapped to
+			}
+		}
+
+		Bvh.Build();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Moves the point found on a polyline segment onto the curve, minimizing the distance to the line
+	gp_Pnt Refine(const SnapIndexBvh::Primitive& segment, double fraction, const gp_XYZ& origin, const gp_XYZ& direction) const
+	{
+		BRepAdaptor_Curve curve(Edges[segment.Edge]);
+		const double span = segment.U1 - segment.U0;
+		const double uMin = std::max(curve.FirstParameter(), std::min(segment.U0, segment.U1) - std::abs(span));
+		const double uMax = std::min(curve.LastParameter(), std::max(segment.U0, segment.U1) + std::abs(span));
+
+		// Newton iteration on the derivative of the squared distance to the line
+		double u = segment.U0 + span * fraction;
+		gp_Pnt point;
+		gp_Vec d1, d2;
+		for (int iteration = 0; iteration < 8; iteration++)
+		{
+			curve.D2(u, point, d1, d2);
+			const gp_XYZ w = point.XYZ() - origin;
+			const gp_XYZ e = w - direction * w.Dot(direction);
+			const gp_XYZ d1Perpendicular = d1.XYZ() - direction * d1.XYZ().Dot(direction);
+			const double f1 = e.Dot(d1.XYZ());
+			const double f2 = d1Perpendicular.SquareModulus() + e.Dot(d2.XYZ());
+			if (f2 <= 0.0)
+				break;
+
+			const double next = std::min(uMax, std::max(uMin, u - f1 / f2));
+			if (std::abs(next - u) < 1e-12 * (1.0 + std::abs(u)))
+				break;
+			u = next;
+		}
+
+		const gp_Pnt refined = curve.Value(u);
+		const gp_Pnt onSegment = curve.Value(segment.U0 + span * fraction);
+		return SnapIndexBvh::PointDistance(origin, direction, refined.XYZ()) <= SnapIndexBvh::PointDistance(origin, direction, onSegment.XYZ())
+				   ? refined
+				   : onSegment;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	static double _Deflection(const std::vector<SnapIndexBvh::Primitive>& vertices)
+	{
+		Bnd_Box box;
+		for (const auto& vertex : vertices)
+		{
+			box.Add(gp_Pnt(vertex.P0));
+		}
+		const double diagonal = box.IsVoid() ? 0.0 : std::sqrt(box.SquareExtent());
+		return std::max(diagonal * 1e-3, Precision::Confusion() * 10.0);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	void _AddEdge(const TopoDS_Edge& edge, double deflection)
+	{
+		BRepAdaptor_Curve curve(edge);
+		const int edgeIndex = (int)Edges.size();
+		Edges.push_back(edge);
+
+		// Midpoint by arc length
+		const double length = GCPnts_AbscissaPoint::Length(curve);
+		GCPnts_AbscissaPoint midpoint(curve, length * 0.5, curve.FirstParameter());
+		if (midpoint.IsDone())
+		{
+			const gp_XYZ point = curve.Value(midpoint.Parameter()).XYZ();
+			Bvh.Primitives.push_back({ point, point, SnapIndexBvh::EdgeMidpoint, edgeIndex, midpoint.Parameter(), midpoint.Parameter() });
+		}
+
+		// Polyline
+		GCPnts_TangentialDeflection polyline(curve, 0.1, deflection, 2);
+		for (int i = 2; i <= polyline.NbPoints(); i++)
+		{
+			Bvh.Primitives.push_back({ polyline.Value(i - 1).XYZ(), polyline.Value(i).XYZ(), SnapIndexBvh::Edge, edgeIndex,
+									   polyline.Parameter(i - 1), polyline.Parameter(i) });
+		}
+	}
+};
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+class SnapIndexData
+{
+public:
+	std::vector<std::unique_ptr<SnapIndexBody>> Bodies;
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Drops the bodies not in the list and builds the primitives only for shapes not yet indexed
+	void Update(const std::vector<TopoDS_Shape>& shapes)
+	{
+		TopTools_MapOfShape incoming;
+		for (const auto& shape : shapes)
+		{
+			incoming.Add(shape);
+		}
+
+		TopTools_MapOfShape existing;
+		Bodies.erase(std::remove_if(Bodies.begin(), Bodies.end(),
+									[&](const std::unique_ptr<SnapIndexBody>& body) { return !incoming.Contains(body->Shape); }),
+					 Bodies.end());
+		for (const auto& body : Bodies)
+		{
+			existing.Add(body->Shape);
+		}
+
+		for (const auto& shape : shapes)
+		{
+			if (existing.Add(shape))
+			{
+				Bodies.push_back(std::make_unique<SnapIndexBody>(shape));
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Points have precedence over edges, edges are only searched if no point is within the tolerance
+	bool FindNearest(const gp_Pnt& origin, const gp_Dir& direction, double tolerance, int kinds, gp_Pnt& point, int& kind) const
+	{
+		const int pointKinds = kinds & (SnapIndexBvh::Vertex | SnapIndexBvh::EdgeMidpoint);
+		if (pointKinds != 0 && _FindNearest(origin.XYZ(), direction.XYZ(), tolerance, pointKinds, point, kind))
+			return true;
+
+		return (kinds & SnapIndexBvh::Edge) != 0 && _FindNearest(origin.XYZ(), direction.XYZ(), tolerance, SnapIndexBvh::Edge, point, kind);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	bool _FindNearest(const gp_XYZ& origin, const gp_XYZ& direction, double tolerance, int kinds, gp_Pnt& point, int& kind) const
+	{
+		SnapIndexBvh::Hit hit;
+		hit.Distance = tolerance;
+		const SnapIndexBody* hitBody = nullptr;
+		for (const auto& body : Bodies)
+		{
+			const int previous = hit.Primitive;
+			hit.Primitive = -1;
+			body->Bvh.FindNearest(origin, direction, kinds, hit);
+			if (hit.Primitive >= 0)
+			{
+				hitBody = body.get();
+				continue;
+			}
+			hit.Primitive = previous;
+		}
+
+		if (hitBody == nullptr)
+			return false;
+
+		const SnapIndexBvh::Primitive& primitive = hitBody->Bvh.Primitives[hit.Primitive];
+		kind = primitive.Kind;
+		point = primitive.Kind == SnapIndexBvh::Edge
+					? hitBody->Refine(primitive, hit.Fraction, origin, direction)
+					: gp_Pnt(primitive.P0);
+		return true;
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			[System::Flags]
+			public enum class SnapIndexTargets
+			{
+				None = 0,
+				Vertex = SnapIndexBvh::Vertex,
+				EdgeMidpoint = SnapIndexBvh::EdgeMidpoint,
+				Edge = SnapIndexBvh::Edge,
+				All = Vertex | EdgeMidpoint | Edge
+			};
+
+			//--------------------------------------------------------------------------------------------------
+
+			// Spatial index of the vertices, edge midpoints and edges of a set of bodies for snapping. The
+			// edges are indexed as polylines, hits are refined to the exact curve. Bodies are identified by
+			// their shape instance, only new shapes are indexed when the set is updated.
+			public ref class SnapIndex sealed
+			{
+			public:
+				SnapIndex()
+				{
+					_Data = new SnapIndexData();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				~SnapIndex()
+				{
+					this->!SnapIndex();
+				}
+
+				!SnapIndex()
+				{
+					delete _Data;
+					_Data = nullptr;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				property int ShapeCount { int get() { return (int)_Data->Bodies.size(); } }
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Synchronizes the index with the given shapes
+				void Update(System::Collections::Generic::IEnumerable<Macad::Occt::TopoDS_Shape^>^ shapes)
+				{
+					if (shapes == nullptr)
+						throw gcnew System::ArgumentNullException("shapes");
+
+					std::vector<::TopoDS_Shape> nativeShapes;
+					for each (auto shape in shapes)
+					{
+						if (shape != nullptr && !shape->NativeInstance->IsNull())
+							nativeShapes.push_back(*shape->NativeInstance);
+					}
+					_Data->Update(nativeShapes);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void Clear()
+				{
+					_Data->Bodies.clear();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Finds the snap target nearest to the line, if its distance is less than the tolerance
+				bool FindNearest(Macad::Occt::Ax1 axis, double tolerance, SnapIndexTargets targets,
+								 [System::Runtime::InteropServices::Out] Macad::Occt::Pnt% point,
+								 [System::Runtime::InteropServices::Out] SnapIndexTargets% target)
+				{
+					STRUCT_PIN(axis, Ax1, gp_Ax1);
+
+					gp_Pnt nativePoint;
+					int kind = 0;
+					const bool found = _Data->FindNearest(axis_ptr->Location(), axis_ptr->Direction(), tolerance, (int)targets, nativePoint, kind);
+					point = Macad::Occt::Pnt(nativePoint);
+					target = (SnapIndexTargets)kind;
+					return found;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				SnapIndexData* _Data;
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
@@ -0,0 +1,88 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include "OcctExtensions/TopExp_DistinctShapes.h"
+
+#using "Macad.Occt.dll" as_friend
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			public ref class TopoDSHelper sealed
+			{
+			public:
+				static array<Macad::Occt::TopoDS_CompSolid^>^ CompSolids(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_CompSolid, Macad::Occt::TopoDS_CompSolid>(shape, ::TopAbs_COMPSOLID, false);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<Macad::Occt::TopoDS_Solid^>^ Solids(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_Solid, Macad::Occt::TopoDS_Solid>(shape, ::TopAbs_SOLID, false);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<Macad::Occt::TopoDS_Shell^>^ Shells(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_Shell, Macad::Occt::TopoDS_Shell>(shape, ::TopAbs_SHELL, false);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<Macad::Occt::TopoDS_Face^>^ Faces(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_Face, Macad::Occt::TopoDS_Face>(shape, ::TopAbs_FACE, true);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<Macad::Occt::TopoDS_Wire^>^ Wires(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_Wire, Macad::Occt::TopoDS_Wire>(shape, ::TopAbs_WIRE, true);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<Macad::Occt::TopoDS_Edge^>^ Edges(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_Edge, Macad::Occt::TopoDS_Edge>(shape, ::TopAbs_EDGE, true);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static array<Macad::Occt::TopoDS_Vertex^>^ Vertices(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					return _Collect<::TopoDS_Vertex, Macad::Occt::TopoDS_Vertex>(shape, ::TopAbs_VERTEX, false);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				// Collects the distinct subshapes in explorer order, see TopExp_DistinctShapes
+				template<typename TNative, typename TManaged>
+				static array<TManaged^>^ _Collect(Macad::Occt::TopoDS_Shape^ shape, ::TopAbs_ShapeEnum type, bool preferForward)
+				{
+					if (shape == nullptr)
+						throw gcnew System::ArgumentNullException("shape");
+
+					std::vector<::TopoDS_Shape> shapes;
+					::TopExp_DistinctShapes::Collect(*shape->NativeInstance, type, preferForward, shapes);
+
+					auto result = gcnew array<TManaged^>((int)shapes.size());
+					for (int i = 0; i < result->Length; i++)
+					{
+						result[i] = gcnew TManaged(new TNative(static_cast<const TNative&>(shapes[i])));
+					}
+					return result;
+				}
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
@@ -0,0 +1,414 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Index maps of the faces, edges and vertices of a shape and their adjacency as compressed rows,
+// all indices are zero-based and in the order the explorer finds the subshapes first. The rows from
+// children to parents have one entry per occurrence like TopExp::MapShapesAndAncestors, so a seam
+// edge lists its face twice and a closed edge is listed twice for its vertex.
+class TopologyIndexData
+{
+public:
+	TopoDS_Shape Shape;
+
+	TopTools_IndexedMapOfShape Faces;
+	TopTools_IndexedMapOfShape Edges;
+	TopTools_IndexedMapOfShape Vertices;
+
+	std::vector<int> FaceEdgeStart, FaceEdges;
+	std::vector<int> EdgeFaceStart, EdgeFaces;
+	std::vector<int> VertexEdgeStart, VertexEdges;
+	std::vector<int> FaceFaceStart, FaceFaces, FaceFaceEdges;
+
+	//--------------------------------------------------------------------------------------------------
+
+	explicit TopologyIndexData(const TopoDS_Shape& shape)
+		: Shape(shape)
+	{
+		TopExp::MapShapes(shape, TopAbs_FACE, Faces);
+		TopExp::MapShapes(shape, TopAbs_EDGE, Edges);
+		TopExp::MapShapes(shape, TopAbs_VERTEX, Vertices);
+
+		std::vector<int> faceEdgeStart, faceEdges;
+		_MapChildren(Faces, Edges, TopAbs_EDGE, faceEdgeStart, faceEdges);
+		_Transpose(faceEdgeStart, faceEdges, Edges.Extent(), EdgeFaceStart, EdgeFaces);
+		_Distinct(faceEdgeStart, faceEdges, Edges.Extent(), FaceEdgeStart, FaceEdges);
+
+		std::vector<int> edgeVertexStart, edgeVertices;
+		_MapChildren(Edges, Vertices, TopAbs_VERTEX, edgeVertexStart, edgeVertices);
+		_Transpose(edgeVertexStart, edgeVertices, Vertices.Extent(), VertexEdgeStart, VertexEdges);
+
+		// Faces sharing an edge, in the order of the edges of the face
+		const int faceCount = Faces.Extent();
+		std::vector<int> lastSeen(faceCount, -1);
+		FaceFaceStart.assign(faceCount + 1, 0);
+		for (int face = 0; face < faceCount; face++)
+		{
+			lastSeen[face] = face;
+			for (int i = FaceEdgeStart[face]; i < FaceEdgeStart[face + 1]; i++)
+			{
+				const int edge = FaceEdges[i];
+				for (int j = EdgeFaceStart[edge]; j < EdgeFaceStart[edge + 1]; j++)
+				{
+					const int other = EdgeFaces[j];
+					if (lastSeen[other] == face)
+						continue;
+					lastSeen[other] = face;
+					FaceFaces.push_back(other);
+					FaceFaceEdges.push_back(edge);
+				}
+			}
+			FaceFaceStart[face + 1] = (int)FaceFaces.size();
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	// Collects every occurrence of the children of every parent in explorer order
+	static void _MapChildren(const TopTools_IndexedMapOfShape& parents, const TopTools_IndexedMapOfShape& children, TopAbs_ShapeEnum childType,
+							 std::vector<int>& start, std::vector<int>& indices)
+	{
+		const int parentCount = parents.Extent();
+		start.assign(parentCount + 1, 0);
+		for (int parent = 0; parent < parentCount; parent++)
+		{
+			for (TopExp_Explorer exp(parents.FindKey(parent + 1), childType); exp.More(); exp.Next())
+			{
+				const int child = children.FindIndex(exp.Current()) - 1;
+				if (child >= 0)
+					indices.push_back(child);
+			}
+			start[parent + 1] = (int)indices.size();
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Keeps the first occurrence of every child in the rows
+	static void _Distinct(const std::vector<int>& start, const std::vector<int>& indices, int childCount,
+						  std::vector<int>& distinctStart, std::vector<int>& distinct)
+	{
+		const int parentCount = (int)start.size() - 1;
+		std::vector<int> lastSeen(childCount, -1);
+		distinctStart.assign(parentCount + 1, 0);
+		for (int parent = 0; parent < parentCount; parent++)
+		{
+			for (int i = start[parent]; i < start[parent + 1]; i++)
+			{
+				if (lastSeen[indices[i]] == parent)
+					continue;
+				lastSeen[indices[i]] = parent;
+				distinct.push_back(indices[i]);
+			}
+			distinctStart[parent + 1] = (int)distinct.size();
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Inverts parent->children rows into child->parents rows, parents stay in ascending order
+	static void _Transpose(const std::vector<int>& start, const std::vector<int>& indices, int childCount,
+						   std::vector<int>& transposedStart, std::vector<int>& transposed)
+	{
+		transposedStart.assign(childCount + 1, 0);
+		for (size_t i = 0; i < indices.size(); i++)
+		{
+			transposedStart[indices[i] + 1]++;
+		}
+		for (int i = 0; i < childCount; i++)
+		{
+			transposedStart[i + 1] += transposedStart[i];
+		}
+
+		transposed.resize(indices.size());
+		std::vector<int> fill(transposedStart.begin(), transposedStart.end() - 1);
+		const int parentCount = (int)start.size() - 1;
+		for (int parent = 0; parent < parentCount; parent++)
+		{
+			for (int i = start[parent]; i < start[parent + 1]; i++)
+			{
+				transposed[fill[indices[i]]++] = parent;
+			}
+		}
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			// Topology of a shape with constant time adjacency queries. The index is built once per native
+			// shape, that is per TShape, location and orientation, and shared by all wrappers of it. It is kept
+			// alive as long as one of the wrappers it has been requested for is alive. Face, edge and vertex
+			// indices are the same as the positions in the distinct subshape lists of the shape.
+			public ref class TopologyIndex sealed
+			{
+			public:
+				static TopologyIndex^ Get(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					if (shape == nullptr)
+						throw gcnew System::ArgumentNullException("shape");
+
+					const ::TopoDS_Shape& nativeShape = *shape->NativeInstance;
+					System::IntPtr key(nativeShape.TShape().get());
+
+					System::Threading::Monitor::Enter(_Cache);
+					try
+					{
+						TopologyIndex^ index = nullptr;
+						System::Collections::Generic::List<System::WeakReference<TopologyIndex^>^>^ entries;
+						if (_Cache->TryGetValue(key, entries))
+						{
+							for (int i = entries->Count - 1; i >= 0; i--)
+							{
+								TopologyIndex^ entry;
+								if (!entries[i]->TryGetTarget(entry))
+								{
+									entries->RemoveAt(i);
+								}
+								else if (entry->_Data->Shape.IsEqual(nativeShape))
+								{
+									index = entry;
+								}
+							}
+						}
+						else
+						{
+							entries = gcnew System::Collections::Generic::List<System::WeakReference<TopologyIndex^>^>();
+							_Cache->Add(key, entries);
+						}
+
+						if (index == nullptr)
+						{
+							index = gcnew TopologyIndex(shape);
+							entries->Add(gcnew System::WeakReference<TopologyIndex^>(index));
+							_PurgeCache();
+						}
+
+						// Tie the lifetime of the index to the wrapper
+						_Owners->Remove(shape);
+						_Owners->Add(shape, index);
+						return index;
+					}
+					finally
+					{
+						System::Threading::Monitor::Exit(_Cache);
+					}
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				~TopologyIndex()
+				{
+					this->!TopologyIndex();
+				}
+
+				!TopologyIndex()
+				{
+					delete _Data;
+					_Data = nullptr;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				property int FaceCount { int get() { return _Data->Faces.Extent(); } }
+				property int EdgeCount { int get() { return _Data->Edges.Extent(); } }
+				property int VertexCount { int get() { return _Data->Vertices.Extent(); } }
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Returns the index of the face, edge or vertex, or -1 if it is not part of the shape
+				int IndexOfFace(Macad::Occt::TopoDS_Shape^ face)
+				{
+					return face == nullptr ? -1 : _Data->Faces.FindIndex(*face->NativeInstance) - 1;
+				}
+
+				int IndexOfEdge(Macad::Occt::TopoDS_Shape^ edge)
+				{
+					return edge == nullptr ? -1 : _Data->Edges.FindIndex(*edge->NativeInstance) - 1;
+				}
+
+				int IndexOfVertex(Macad::Occt::TopoDS_Shape^ vertex)
+				{
+					return vertex == nullptr ? -1 : _Data->Vertices.FindIndex(*vertex->NativeInstance) - 1;
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Returns the subshape with the orientation of its first occurrence. The wrapper is created once
+				// and returned again on every call, it must not be disposed or modified.
+				Macad::Occt::TopoDS_Face^ Face(int index)
+				{
+					_CheckIndex(index, FaceCount);
+					if (_Faces[index] == nullptr)
+						_Faces[index] = gcnew Macad::Occt::TopoDS_Face(new ::TopoDS_Face(::TopoDS::Face(_Data->Faces.FindKey(index + 1))));
+					return _Faces[index];
+				}
+
+				Macad::Occt::TopoDS_Edge^ Edge(int index)
+				{
+					_CheckIndex(index, EdgeCount);
+					if (_Edges[index] == nullptr)
+						_Edges[index] = gcnew Macad::Occt::TopoDS_Edge(new ::TopoDS_Edge(::TopoDS::Edge(_Data->Edges.FindKey(index + 1))));
+					return _Edges[index];
+				}
+
+				Macad::Occt::TopoDS_Vertex^ Vertex(int index)
+				{
+					_CheckIndex(index, VertexCount);
+					if (_Vertices[index] == nullptr)
+						_Vertices[index] = gcnew Macad::Occt::TopoDS_Vertex(new ::TopoDS_Vertex(::TopoDS::Vertex(_Data->Vertices.FindKey(index + 1))));
+					return _Vertices[index];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Edges bounding a face, in explorer order
+				int FaceEdgeCount(int face)
+				{
+					_CheckIndex(face, FaceCount);
+					return _Data->FaceEdgeStart[face + 1] - _Data->FaceEdgeStart[face];
+				}
+
+				int FaceEdge(int face, int i)
+				{
+					_CheckIndex(i, FaceEdgeCount(face));
+					return _Data->FaceEdges[_Data->FaceEdgeStart[face] + i];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Faces using an edge, in ascending order and once per occurrence of the edge
+				int EdgeFaceCount(int edge)
+				{
+					_CheckIndex(edge, EdgeCount);
+					return _Data->EdgeFaceStart[edge + 1] - _Data->EdgeFaceStart[edge];
+				}
+
+				int EdgeFace(int edge, int i)
+				{
+					_CheckIndex(i, EdgeFaceCount(edge));
+					return _Data->EdgeFaces[_Data->EdgeFaceStart[edge] + i];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Edges using a vertex, in ascending order and once per occurrence of the vertex
+				int VertexEdgeCount(int vertex)
+				{
+					_CheckIndex(vertex, VertexCount);
+					return _Data->VertexEdgeStart[vertex + 1] - _Data->VertexEdgeStart[vertex];
+				}
+
+				int VertexEdge(int vertex, int i)
+				{
+					_CheckIndex(i, VertexEdgeCount(vertex));
+					return _Data->VertexEdges[_Data->VertexEdgeStart[vertex] + i];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Faces sharing at least one edge with a face, in the order of its edges
+				int FaceNeighborCount(int face)
+				{
+					_CheckIndex(face, FaceCount);
+					return _Data->FaceFaceStart[face + 1] - _Data->FaceFaceStart[face];
+				}
+
+				int FaceNeighbor(int face, int i)
+				{
+					_CheckIndex(i, FaceNeighborCount(face));
+					return _Data->FaceFaces[_Data->FaceFaceStart[face] + i];
+				}
+
+				// The first edge shared with the neighbor face
+				int FaceNeighborEdge(int face, int i)
+				{
+					_CheckIndex(i, FaceNeighborCount(face));
+					return _Data->FaceFaceEdges[_Data->FaceFaceStart[face] + i];
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+			private:
+				static System::Collections::Generic::Dictionary<System::IntPtr, System::Collections::Generic::List<System::WeakReference<TopologyIndex^>^>^>^ _Cache;
+				static System::Runtime::CompilerServices::ConditionalWeakTable<Macad::Occt::TopoDS_Shape^, TopologyIndex^>^ _Owners;
+				static int _AddedSincePurge;
+
+				TopologyIndexData* _Data;
+				array<Macad::Occt::TopoDS_Face^>^ _Faces;
+				array<Macad::Occt::TopoDS_Edge^>^ _Edges;
+				array<Macad::Occt::TopoDS_Vertex^>^ _Vertices;
+
+				//--------------------------------------------------------------------------------------------------
+
+				static TopologyIndex()
+				{
+					_Cache = gcnew System::Collections::Generic::Dictionary<System::IntPtr, System::Collections::Generic::List<System::WeakReference<TopologyIndex^>^>^>();
+					_Owners = gcnew System::Runtime::CompilerServices::ConditionalWeakTable<Macad::Occt::TopoDS_Shape^, TopologyIndex^>();
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				TopologyIndex(Macad::Occt::TopoDS_Shape^ shape)
+				{
+					_Data = new TopologyIndexData(*shape->NativeInstance);
+					_Faces = gcnew array<Macad::Occt::TopoDS_Face^>(FaceCount);
+					_Edges = gcnew array<Macad::Occt::TopoDS_Edge^>(EdgeCount);
+					_Vertices = gcnew array<Macad::Occt::TopoDS_Vertex^>(VertexCount);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Removes the entries of collected indices from time to time, the cache is locked by the caller
+				static void _PurgeCache()
+				{
+					if (++_AddedSincePurge < 256)
+						return;
+					_AddedSincePurge = 0;
+
+					auto emptyKeys = gcnew System::Collections::Generic::List<System::IntPtr>();
+					for each (auto pair in _Cache)
+					{
+						pair.Value->RemoveAll(gcnew System::Predicate<System::WeakReference<TopologyIndex^>^>(&TopologyIndex::_IsCollected));
+						if (pair.Value->Count == 0)
+							emptyKeys->Add(pair.Key);
+					}
+					for each (auto key in emptyKeys)
+					{
+						_Cache->Remove(key);
+					}
+				}
+
+				static bool _IsCollected(System::WeakReference<TopologyIndex^>^ reference)
+				{
+					TopologyIndex^ entry;
+					return !reference->TryGetTarget(entry);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				static void _CheckIndex(int index, int count)
+				{
+					if (index < 0 || index >= count)
+						throw gcnew System::ArgumentOutOfRangeException("index");
+				}
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
@@ -0,0 +1,197 @@
+﻿#include "ManagedPCH.h"
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <BRepBuilderAPI_MakeWire.hxx>
+
+#using "Macad.Occt.dll" as_friend
+
+#pragma managed(push, off)
+
+// Groups edges into chains of connected edges, given the start and end point keys of every edge.
+// A point key of -1 means the edge has no point at this end. The chains are the same the pairwise
+// search finds: starting with the first free edge, the chain is extended with the first free edge
+// sharing a point with the edge added last at the front, or else at the back of the chain. Every
+// point keeps a cursor into its ascending edge list, so each adjacency entry is visited once.
+class WireChainBuilder
+{
+public:
+	static std::vector<std::vector<int>> Build(const int* startPoints, const int* endPoints, int count)
+	{
+		WireChainBuilder builder(startPoints, endPoints, count);
+		return builder._Build();
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+private:
+	struct Adjacency
+	{
+		std::vector<int> Edges;
+		size_t Cursor = 0;
+	};
+
+	const int* _StartPoints;
+	const int* _EndPoints;
+	int _Count;
+	std::vector<bool> _Used;
+	std::unordered_map<int, Adjacency> _Adjacency;
+
+	//--------------------------------------------------------------------------------------------------
+
+	WireChainBuilder(const int* startPoints, const int* endPoints, int count)
+		: _StartPoints(startPoints)
+		, _EndPoints(endPoints)
+		, _Count(count)
+		, _Used(count, false)
+	{
+		_Adjacency.reserve(count * 2);
+		for (int edge = 0; edge < count; edge++)
+		{
+			if (startPoints[edge] != -1)
+				_Adjacency[startPoints[edge]].Edges.push_back(edge);
+			if (endPoints[edge] != -1 && endPoints[edge] != startPoints[edge])
+				_Adjacency[endPoints[edge]].Edges.push_back(edge);
+		}
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	std::vector<std::vector<int>> _Build()
+	{
+		std::vector<std::vector<int>> chains;
+		for (int first = 0; first < _Count; first++)
+		{
+			if (_Used[first])
+				continue;
+
+			_Used[first] = true;
+			std::vector<int> chain{ first };
+			int front = first;
+			int back = first;
+			while (true)
+			{
+				int next = _NextFree(front);
+				if (next >= 0)
+				{
+					front = next;
+				}
+				else
+				{
+					next = _NextFree(back);
+					if (next < 0)
+						break;
+					back = next;
+				}
+
+				_Used[next] = true;
+				chain.push_back(next);
+			}
+			chains.push_back(std::move(chain));
+		}
+		return chains;
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	// Returns the lowest free edge sharing a point with the edge, or -1
+	int _NextFree(int edge)
+	{
+		const int fromStart = _NextFreeAt(_StartPoints[edge]);
+		const int fromEnd = _NextFreeAt(_EndPoints[edge]);
+		if (fromStart < 0)
+			return fromEnd;
+		if (fromEnd < 0)
+			return fromStart;
+		return std::min(fromStart, fromEnd);
+	}
+
+	//--------------------------------------------------------------------------------------------------
+
+	int _NextFreeAt(int point)
+	{
+		if (point == -1)
+			return -1;
+
+		auto it = _Adjacency.find(point);
+		if (it == _Adjacency.end())
+			return -1;
+
+		Adjacency& adjacency = it->second;
+		while (adjacency.Cursor < adjacency.Edges.size() && _Used[adjacency.Edges[adjacency.Cursor]])
+		{
+			adjacency.Cursor++;
+		}
+		return adjacency.Cursor < adjacency.Edges.size() ? adjacency.Edges[adjacency.Cursor] : -1;
+	}
+};
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Helper
+		{
+			public ref class WireBuilder sealed
+			{
+			public:
+				// Assembles all wires of the edges in one pass, the edges are connected by the point keys
+				// of their ends. An entry of the result is null if the wire could not be built.
+				static array<Macad::Occt::TopoDS_Wire^>^ MakeWires(array<Macad::Occt::TopoDS_Edge^>^ edges, array<int>^ startPoints, array<int>^ endPoints)
+				{
+					array<int>^ edgeWires;
+					return MakeWires(edges, startPoints, endPoints, edgeWires);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				// Same as above, additionally returns the index of the wire each edge has been added to
+				static array<Macad::Occt::TopoDS_Wire^>^ MakeWires(array<Macad::Occt::TopoDS_Edge^>^ edges, array<int>^ startPoints, array<int>^ endPoints,
+																   [System::Runtime::InteropServices::Out] array<int>^% edgeWires)
+				{
+					if (edges == nullptr)
+						throw gcnew System::ArgumentNullException("edges");
+					if (startPoints == nullptr || startPoints->Length != edges->Length)
+						throw gcnew System::ArgumentException("Start point count does not match edge count.", "startPoints");
+					if (endPoints == nullptr || endPoints->Length != edges->Length)
+						throw gcnew System::ArgumentException("End point count does not match edge count.", "endPoints");
+
+					edgeWires = gcnew array<int>(edges->Length);
+					if (edges->Length == 0)
+						return gcnew array<Macad::Occt::TopoDS_Wire^>(0);
+
+					std::vector<std::vector<int>> chains;
+					{
+						pin_ptr<int> startPinned = &startPoints[0];
+						pin_ptr<int> endPinned = &endPoints[0];
+						chains = WireChainBuilder::Build(startPinned, endPinned, edges->Length);
+					}
+
+					auto wires = gcnew array<Macad::Occt::TopoDS_Wire^>((int)chains.size());
+					for (int i = 0; i < wires->Length; i++)
+					{
+						::BRepBuilderAPI_MakeWire makeWire;
+						for (int edge : chains[i])
+						{
+							makeWire.Add(*edges[edge]->NativeInstance);
+							edgeWires[edge] = i;
+						}
+
+						if (makeWire.IsDone())
+						{
+							wires[i] = gcnew Macad::Occt::TopoDS_Wire(new ::TopoDS_Wire(makeWire.Wire()));
+						}
+					}
+					return wires;
+				}
+			};
+
+		} // namespace Helper
+	} // namespace Occt
+} // namespace Macad
@@ -76,6 +76,42 @@ namespace Macad
 
 		//--------------------------------------------------------------------------------------------------
 
+		public enum class Algorithm
+		{
+			Bfgs				= solveAlgorithm::bfgs,
+			LevenbergMarquardt	= solveAlgorithm::levenbergMarquardt,
+			LimitedMemoryBfgs	= solveAlgorithm::limitedMemoryBfgs
+		};
+
+		//--------------------------------------------------------------------------------------------------
+
+		public value struct Statistics
+		{
+			int Iterations;
+			int FunctionEvaluations;
+			int GradientEvaluations;
+			double Error;
+			double Residual;
+			System::TimeSpan Time;
+			int VariableCount;
+			int ConstraintCount;
+		};
+
+		//--------------------------------------------------------------------------------------------------
+
+		// Outcome of the degree of freedom analysis, constraint indices refer to the packed constraint table
+		public ref class Analysis
+		{
+		public:
+			int Rank;
+			int Freedom;
+			array<int>^ PointFreedom;
+			array<int>^ RedundantConstraints;
+			array<int>^ ConflictingConstraints;
+		};
+
+		//--------------------------------------------------------------------------------------------------
+
 		public enum class Usage
 		{
 			Variable,
@@ -109,6 +145,12 @@ namespace Macad
 				p.y = VALUEPTR(Y);
 				return p;
 			}
+
+			void Pack(array<int>^ table, int% offset)
+			{
+				table[offset++] = X;
+				table[offset++] = Y;
+			}
 		};
 		
 		//--------------------------------------------------------------------------------------------------
@@ -125,6 +167,12 @@ namespace Macad
 				l.p2 = P2.ToNative(parameters);
 				return l;
 			}
+
+			void Pack(array<int>^ table, int% offset)
+			{
+				P1.Pack(table, offset);
+				P2.Pack(table, offset);
+			}
 		};
 		
 		//--------------------------------------------------------------------------------------------------
@@ -141,6 +189,12 @@ namespace Macad
 				c.rad = VALUEPTR(Radius);
 				return c;
 			}
+
+			void Pack(array<int>^ table, int% offset)
+			{
+				Center.Pack(table, offset);
+				table[offset++] = Radius;
+			}
 		};
 		
 		//--------------------------------------------------------------------------------------------------
@@ -159,6 +213,13 @@ namespace Macad
 				a.center = Center.ToNative(parameters);
 				return a;
 			}
+
+			void Pack(array<int>^ table, int% offset)
+			{
+				Start.Pack(table, offset);
+				End.Pack(table, offset);
+				Center.Pack(table, offset);
+			}
 		};
 		
 		//--------------------------------------------------------------------------------------------------
@@ -178,6 +239,11 @@ namespace Macad
 			Arc Arc2;
 			int Parameter;
 
+			// Number of entries per constraint in the packed constraint table: type, point 1 and 2 (x, y),
+			// line 1, line 2 and symmetry line (x1, y1, x2, y2), circle 1 and 2 (x, y, radius),
+			// arc 1 and 2 (start x, y, end x, y, center x, y) and the parameter.
+			literal int PackedSize = 36;
+
 			constraint ToNative(List<SketchSolve::Parameter^>^ parameters)
 			{
 				constraint cons;
@@ -194,20 +260,44 @@ namespace Macad
 				cons.parameter = VALUEPTR(Parameter);
 				return cons;
 			}
+
+			// Writes the constraint as one row of PackedSize entries into the packed constraint table
+			void Pack(array<int>^ table, int row)
+			{
+				int offset = row * PackedSize;
+				table[offset++] = static_cast<int>(Type);
+				Point1.Pack(table, offset);
+				Point2.Pack(table, offset);
+				Line1.Pack(table, offset);
+				Line2.Pack(table, offset);
+				SymLine.Pack(table, offset);
+				Circle1.Pack(table, offset);
+				Circle2.Pack(table, offset);
+				Arc1.Pack(table, offset);
+				Arc2.Pack(table, offset);
+				table[offset++] = Parameter;
+			}
 		};
 		
 		//--------------------------------------------------------------------------------------------------
 
-		public ref class Solver
+		// Native copy of the parameters and constraints
+		class NativeSystem
 		{
 		public:
-			static Result Solve(List<Parameter^>^ parameters, List<Constraint>^ constraints, bool precise)
+			double* Parameters;
+			double** Variables;
+			int VariableCount;
+			constraint* Constraints;
+			int ConstraintCount;
+
+			NativeSystem(List<Parameter^>^ parameters, List<Constraint>^ constraints)
 			{
 				int curVariable = 0;
 				int curConstant = parameters->Count-1;
 				
 				// Link parameters to native array
-				double* pParameters = new double[parameters->Count];
+				Parameters = new double[parameters->Count];
 				for each (Parameter^ parameter in parameters)
 				{
 					int index;
@@ -221,44 +311,400 @@ namespace Macad
 						index = curConstant;
 						curConstant--;
 					}
-					parameter->Pointer = &pParameters[index];
+					parameter->Pointer = &Parameters[index];
 					*parameter->Pointer = parameter->Value;
 				}
 
 				// Create variable address array
-				const int numVariables = curVariable;
-				double** ppParameters = new double*[numVariables];
-				for (int i = 0; i<numVariables; i++)
+				VariableCount = curVariable;
+				Variables = new double*[VariableCount];
+				for (int i = 0; i<VariableCount; i++)
 				{
-					ppParameters[i] = &(pParameters[i]);
+					Variables[i] = &(Parameters[i]);
 				}
 
 				// Create native constraint array
-				constraint* pConstraints = new constraint[constraints->Count];
-				for (int i = 0; i < constraints->Count; i++)
+				ConstraintCount = constraints->Count;
+				Constraints = new constraint[ConstraintCount];
+				for (int i = 0; i < ConstraintCount; i++)
+				{
+					Constraints[i] = constraints[i].ToNative(parameters);
+				}
+			}
+
+			~NativeSystem()
+			{
+				delete[] Constraints;
+				delete[] Variables;
+				delete[] Parameters;
+			}
+
+			void CopyBack(List<Parameter^>^ parameters)
+			{
+				for each (Parameter^ parameter in parameters)
 				{
-					pConstraints[i] = constraints[i].ToNative(parameters);
+					parameter->Value = *parameter->Pointer;
 				}
+			}
+		};
+
+		//--------------------------------------------------------------------------------------------------
+
+		// Native constraints referencing the values of a pinned array, read from the packed constraint table
+		class PackedSystem
+		{
+		public:
+			std::vector<double*> Variables;
+			std::vector<constraint> Constraints;
+
+			PackedSystem(double* values, const unsigned char* usage, int valueCount, const int* table, int constraintCount)
+				: _Values(values), _Row(table)
+			{
+				for (int i = 0; i < valueCount; i++)
+				{
+					if (usage[i] == static_cast<unsigned char>(Usage::Variable))
+						Variables.push_back(&values[i]);
+				}
+
+				Constraints.resize(constraintCount);
+				for (int i = 0; i < constraintCount; i++)
+				{
+					constraint& cons = Constraints[i];
+					cons.type = static_cast<constraintType>(*_Row++);
+					cons.point1 = _NextPoint();
+					cons.point2 = _NextPoint();
+					cons.line1 = _NextLine();
+					cons.line2 = _NextLine();
+					cons.SymLine = _NextLine();
+					cons.circle1 = _NextCircle();
+					cons.circle2 = _NextCircle();
+					cons.arc1 = _NextArc();
+					cons.arc2 = _NextArc();
+					cons.parameter = _Next();
+				}
+			}
+
+		private:
+			double* _Values;
+			const int* _Row;
+
+			double* _Next()
+			{
+				return &_Values[*_Row++];
+			}
+
+			point _NextPoint()
+			{
+				point p;
+				p.x = _Next();
+				p.y = _Next();
+				return p;
+			}
+
+			line _NextLine()
+			{
+				line l;
+				l.p1 = _NextPoint();
+				l.p2 = _NextPoint();
+				return l;
+			}
+
+			circle _NextCircle()
+			{
+				circle c;
+				c.center = _NextPoint();
+				c.rad = _Next();
+				return c;
+			}
+
+			arc _NextArc()
+			{
+				arc a;
+				a.start = _NextPoint();
+				a.end = _NextPoint();
+				a.center = _NextPoint();
+				return a;
+			}
+		};
+
+		//--------------------------------------------------------------------------------------------------
+
+		public ref class Solver
+		{
+		public:
+			static Result Solve(List<Parameter^>^ parameters, List<Constraint>^ constraints, bool precise)
+			{
+				Statistics statistics;
+				return Solve(parameters, constraints, precise, Algorithm::Bfgs, statistics);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			static Result Solve(List<Parameter^>^ parameters, List<Constraint>^ constraints, bool precise, Algorithm algorithm, [System::Runtime::InteropServices::Out] Statistics% statistics)
+			{
+				return Solve(parameters, constraints, precise, algorithm, LBFGSHistory, statistics);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			// The history length is the number of correction pairs kept by the limited-memory BFGS algorithm
+			static Result Solve(List<Parameter^>^ parameters, List<Constraint>^ constraints, bool precise, Algorithm algorithm, int historyLength, [System::Runtime::InteropServices::Out] Statistics% statistics)
+			{
+				NativeSystem system(parameters, constraints);
 
 				// Call solver
 				::Solver solver;
-				const int result = solver.solve(ppParameters, numVariables, pConstraints, constraints->Count, precise ? fine : rough);
+				solver.SetAlgorithm(static_cast<solveAlgorithm>(algorithm));
+				solver.SetHistoryLength(historyLength);
+				Stopwatch^ stopwatch = Stopwatch::StartNew();
+				const int result = solver.solve(system.Variables, system.VariableCount, system.Constraints, system.ConstraintCount, precise ? fine : rough);
+				stopwatch->Stop();
 				if (result == succsess)
 				{
 					// Copy result parameters
-					for each (Parameter^ parameter in parameters)
+					system.CopyBack(parameters);
+				}
+
+				_GetStatistics(solver, stopwatch, statistics);
+				return result == succsess ? Result::Success : Result::NoSolution;
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			// Solves the values in place, they are left unchanged if no solution is found. The usage array
+			// holds one Usage per value, the constraint table holds Constraint::PackedSize entries per constraint.
+			static Result Solve(array<double>^ values, array<System::Byte>^ usage, array<int>^ constraintTable, bool precise, Algorithm algorithm, [System::Runtime::InteropServices::Out] Statistics% statistics)
+			{
+				_CheckPacked(values, usage, constraintTable);
+
+				const int constraintCount = constraintTable->Length / Constraint::PackedSize;
+				statistics = Statistics();
+				if (values->Length == 0 || constraintCount == 0)
+					return Result::Success;
+
+				pin_ptr<double> pinnedValues = &values[0];
+				pin_ptr<System::Byte> pinnedUsage = &usage[0];
+				pin_ptr<int> pinnedTable = &constraintTable[0];
+				PackedSystem system(pinnedValues, pinnedUsage, values->Length, pinnedTable, constraintCount);
+
+				::Solver solver;
+				solver.SetAlgorithm(static_cast<solveAlgorithm>(algorithm));
+				Stopwatch^ stopwatch = Stopwatch::StartNew();
+				const int result = solver.solve(system.Variables.data(), (int)system.Variables.size(), system.Constraints.data(), constraintCount, precise ? fine : rough);
+				stopwatch->Stop();
+
+				_GetStatistics(solver, stopwatch, statistics);
+				return result == succsess ? Result::Success : Result::NoSolution;
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			// Computes the rank of the constraint Jacobian at the current values and the remaining degrees of freedom
+			// of the points, given by the value indices of x and y in turn. Constraints which depend on the ones before
+			// them are reported as redundant, or as conflicting if they cannot be satisfied together with the others.
+			static Analysis^ Analyze(array<double>^ values, array<System::Byte>^ usage, array<int>^ constraintTable, array<int>^ pointValues)
+			{
+				_CheckPacked(values, usage, constraintTable);
+				if (pointValues->Length % 2 != 0)
+					throw gcnew System::ArgumentException("The point values must be given as pairs of x and y.", "pointValues");
+				for (int i = 0; i < pointValues->Length; i++)
+				{
+					if (pointValues[i] < 0 || pointValues[i] >= values->Length)
+						throw gcnew System::ArgumentOutOfRangeException("pointValues", "The point references a value which does not exist.");
+				}
+
+				const int constraintCount = constraintTable->Length / Constraint::PackedSize;
+				const int pointCount = pointValues->Length / 2;
+				analysisResult result;
+				if (values->Length > 0 && constraintCount > 0)
+				{
+					pin_ptr<double> pinnedValues = &values[0];
+					pin_ptr<System::Byte> pinnedUsage = &usage[0];
+					pin_ptr<int> pinnedTable = &constraintTable[0];
+					PackedSystem system(pinnedValues, pinnedUsage, values->Length, pinnedTable, constraintCount);
+
+					double* valuePointer = pinnedValues;
+					std::vector<point> points(pointCount);
+					for (int i = 0; i < pointCount; i++)
 					{
-						parameter->Value = *parameter->Pointer;
+						points[i].x = &valuePointer[pointValues[i * 2]];
+						points[i].y = &valuePointer[pointValues[i * 2 + 1]];
 					}
+
+					::Solver solver;
+					solver.analyze(system.Variables.data(), (int)system.Variables.size(), system.Constraints.data(), constraintCount, points.data(), pointCount, result);
+				}
+				else
+				{
+					// Nothing is constrained
+					for (int i = 0; i < values->Length; i++)
+					{
+						if (usage[i] == static_cast<System::Byte>(Usage::Variable))
+							result.freedom++;
+					}
+					for (int i = 0; i < pointCount; i++)
+					{
+						result.pointFreedom.push_back((usage[pointValues[i * 2]] == static_cast<System::Byte>(Usage::Variable) ? 1 : 0)
+												   + (usage[pointValues[i * 2 + 1]] == static_cast<System::Byte>(Usage::Variable) ? 1 : 0));
+					}
+				}
+
+				Analysis^ analysis = gcnew Analysis();
+				analysis->Rank = result.rank;
+				analysis->Freedom = result.freedom;
+				analysis->PointFreedom = _ToArray(result.pointFreedom);
+				analysis->RedundantConstraints = _ToArray(result.redundant);
+				analysis->ConflictingConstraints = _ToArray(result.conflicting);
+				return analysis;
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			// Measures the throughput of the error evaluation used in the line search, returns evaluations per second
+			static double MeasureEvaluations(List<Parameter^>^ parameters, List<Constraint>^ constraints, int evaluations)
+			{
+				return MeasureEvaluations(parameters, constraints, evaluations, true);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			// Measures the throughput of the error evaluation, either batched by constraint type or constraint by constraint
+			static double MeasureEvaluations(List<Parameter^>^ parameters, List<Constraint>^ constraints, int evaluations, bool batch)
+			{
+				NativeSystem system(parameters, constraints);
+
+				::Solver solver;
+				solver.Load(system.Constraints, system.ConstraintCount, system.Variables, system.VariableCount);
+				solver.SetBatchEvaluation(batch);
+
+				Stopwatch^ stopwatch = Stopwatch::StartNew();
+				for (int i = 0; i < evaluations; i++)
+				{
+					solver.GetError();
 				}
+				stopwatch->Stop();
 
-				// Clean up
-				delete[] pConstraints;
-				delete[] ppParameters;
-				delete[] pParameters;
+				return evaluations / stopwatch->Elapsed.TotalSeconds;
+			}
+
+			//--------------------------------------------------------------------------------------------------
 
+			// Returns the summed error of all constraints at the current values without solving
+			static double GetError(List<Parameter^>^ parameters, List<Constraint>^ constraints, bool batch)
+			{
+				NativeSystem system(parameters, constraints);
+
+				::Solver solver;
+				solver.Load(system.Constraints, system.ConstraintCount, system.Variables, system.VariableCount);
+				solver.SetBatchEvaluation(batch);
+				return solver.GetError();
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+		private:
+			static void _CheckPacked(array<double>^ values, array<System::Byte>^ usage, array<int>^ constraintTable)
+			{
+				if (usage->Length != values->Length)
+					throw gcnew System::ArgumentException("The usage array must have the same length as the value array.", "usage");
+				if (constraintTable->Length % Constraint::PackedSize != 0)
+					throw gcnew System::ArgumentException("The constraint table length must be a multiple of Constraint.PackedSize.", "constraintTable");
+
+				for (int i = 0; i < constraintTable->Length; i++)
+				{
+					if (i % Constraint::PackedSize != 0 && (constraintTable[i] < 0 || constraintTable[i] >= values->Length))
+						throw gcnew System::ArgumentOutOfRangeException("constraintTable", "The constraint table references a value which does not exist.");
+				}
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			static array<int>^ _ToArray(const std::vector<int>& vector)
+			{
+				array<int>^ result = gcnew array<int>((int)vector.size());
+				for (int i = 0; i < result->Length; i++)
+				{
+					result[i] = vector[i];
+				}
+				return result;
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			static void _GetStatistics(const ::Solver& solver, Stopwatch^ stopwatch, Statistics% statistics)
+			{
+				const solveStatistics& nativeStatistics = solver.GetStatistics();
+				statistics.Iterations = nativeStatistics.iterations;
+				statistics.FunctionEvaluations = nativeStatistics.functionEvaluations;
+				statistics.GradientEvaluations = nativeStatistics.gradientEvaluations;
+				statistics.Error = nativeStatistics.error;
+				statistics.Residual = nativeStatistics.residual;
+				statistics.Time = stopwatch->Elapsed;
+				statistics.VariableCount = nativeStatistics.variableCount;
+				statistics.ConstraintCount = nativeStatistics.constraintCount;
+			}
+		};
+
+		//--------------------------------------------------------------------------------------------------
+
+		// Keeps the constraint system loaded for repeated solving, e.g. while dragging points.
+		// Only the changed parameters need to be set before solving again.
+		public ref class SolverSession
+		{
+		public:
+			SolverSession(List<Parameter^>^ parameters, List<Constraint>^ constraints)
+			{
+				_Parameters = parameters;
+				_System = new NativeSystem(parameters, constraints);
+				_Session = new ::SolverSession();
+				_Session->Load(_System->Variables, _System->VariableCount, _System->Constraints, _System->ConstraintCount);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			~SolverSession()
+			{
+				this->!SolverSession();
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			!SolverSession()
+			{
+				delete _Session;
+				_Session = nullptr;
+				delete _System;
+				_System = nullptr;
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			void SetValue(int parameterIndex, double value)
+			{
+				Parameter^ parameter = _Parameters[parameterIndex];
+				parameter->Value = value;
+				*parameter->Pointer = value;
+				_Session->Changed(parameter->Pointer);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			Result Solve(bool precise)
+			{
+				const int result = _Session->Solve(precise ? fine : rough);
+				if (result == succsess)
+				{
+					_System->CopyBack(_Parameters);
+				}
 				return result == succsess ? Result::Success : Result::NoSolution;
 			}
+
+			//--------------------------------------------------------------------------------------------------
+
+		private:
+			List<Parameter^>^ _Parameters;
+			NativeSystem* _System;
+			::SolverSession* _Session;
 		};
 	}
 }
@@ -14,9 +14,11 @@
 #include <stdlib.h>
 #include <sstream>
 
+#pragma managed(push, off)
+
 using namespace std;
 
-double ParallelError(std::vector<double> &parms)
+double ParallelError(const double *parms)
 {
      double dx = parms[2] - parms[0];
      double dy = parms[3] - parms[1];
@@ -35,7 +37,7 @@ double ParallelError(std::vector<double> &parms)
      return (temp)*(temp)*1000;
 }
 
-double PerpendicularError(std::vector<double> &parms)
+double PerpendicularError(const double *parms)
 {
      double dx = parms[2] - parms[0];
      double dy = parms[3] - parms[1];
@@ -56,7 +58,7 @@ double PerpendicularError(std::vector<double> &parms)
 }
 
 
-double PointOnLineMidpointError(std::vector<double> &parms)
+double PointOnLineMidpointError(const double *parms)
 {
      double dx = parms[4] - parms[0];
      double dy = parms[5] - parms[1];
@@ -70,19 +72,19 @@ double PointOnLineMidpointError(std::vector<double> &parms)
      return temp;
 }
 
-double HorizontalError(std::vector<double> &parms)
+double HorizontalError(const double *parms)
 {
    double ody = parms[3] - parms[1];
    return ody*ody*1000;
 }
 
-double VerticalError(std::vector<double> &parms)
+double VerticalError(const double *parms)
 {
    double odx = parms[2] - parms[0];
    return odx*odx*1000;
 }
 
-double PointOnPointError(std::vector<double> &parms)
+double PointOnPointError(const double *parms)
 {
     //Hopefully avoid this constraint, make coincident points use the same parameters
 	double dx = parms[0] - parms[2];
@@ -90,7 +92,7 @@ double PointOnPointError(std::vector<double> &parms)
     return dx*dx + dy*dy;
 }
 
-double P2PDistanceError(std::vector<double> &parms)
+double P2PDistanceError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -99,7 +101,7 @@ double P2PDistanceError(std::vector<double> &parms)
 	return err*err;
 }
 
-double P2PDistanceHorzError(std::vector<double> &parms)
+double P2PDistanceHorzError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double d = parms[4];
@@ -107,7 +109,7 @@ double P2PDistanceHorzError(std::vector<double> &parms)
 	return err*err;
 }
 
-double P2PDistanceVertError(std::vector<double> &parms)
+double P2PDistanceVertError(const double *parms)
 {
 	double dy = parms[1] - parms[3];
 	double d = parms[4];
@@ -115,7 +117,7 @@ double P2PDistanceVertError(std::vector<double> &parms)
 	return err * err;
 }
 
-double PointOnLineError(std::vector<double> &parms)
+double PointOnLineError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -146,7 +148,7 @@ double P2LDistanceE(double lx, double ly, double dx, double dy, double px, doubl
 	return temp;
 }
 
-double P2LDistanceError(std::vector<double> &parms)                      
+double P2LDistanceError(const double *parms)                      
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -156,7 +158,7 @@ double P2LDistanceError(std::vector<double> &parms)
     return temp*temp*100;
 }
 
-double EllipseTangentError(std::vector<double> &parms)                      
+double EllipseTangentError(const double *parms)                      
 {
 	//double ldx = parms[0] - parms[2];
 	//double ldy = parms[1] - parms[3];
@@ -216,7 +218,7 @@ double EllipseTangentError(std::vector<double> &parms)
 }
 
 
-double P2LDistanceVertError(std::vector<double> &parms)
+double P2LDistanceVertError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -227,7 +229,7 @@ double P2LDistanceVertError(std::vector<double> &parms)
     return temp*temp;
 }
 
-double P2LDistanceHorzError(std::vector<double> &parms)
+double P2LDistanceHorzError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -238,7 +240,7 @@ double P2LDistanceHorzError(std::vector<double> &parms)
     return temp*temp/10;
 }
 
-double LineLengthError(std::vector<double> &parms)
+double LineLengthError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -247,7 +249,7 @@ double LineLengthError(std::vector<double> &parms)
 }
 			
 
-double EqualLengthError(std::vector<double> &parms)
+double EqualLengthError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -258,13 +260,13 @@ double EqualLengthError(std::vector<double> &parms)
     return temp*temp;
 }
 
-double EqualScalarError(std::vector<double> &parms)
+double EqualScalarError(const double *parms)
 {
     double temp= parms[0] - parms[1];
     return temp*temp;
 }
 
-double PointOnArcAngleError(std::vector<double> &parms)
+double PointOnArcAngleError(const double *parms)
 {
 	double a1x = sin(parms[5]) * parms[4] + parms[2];
 	double a1y = cos(parms[5]) * parms[4] + parms[3];
@@ -273,7 +275,7 @@ double PointOnArcAngleError(std::vector<double> &parms)
     return dx*dx + dy*dy;
 }
 
-double ArcAngleOnArcAngleError(std::vector<double> &parms)
+double ArcAngleOnArcAngleError(const double *parms)
 {
 	double a1x = sin(parms[3]) * parms[2] + parms[0];
 	double a1y = cos(parms[3]) * parms[2] + parms[1];
@@ -286,7 +288,7 @@ double ArcAngleOnArcAngleError(std::vector<double> &parms)
     return dx*dx + dy*dy;
 }
 
-double ColinearError(std::vector<double>& parms)
+double ColinearError(const double *parms)
 {
     double dx = parms[2] - parms[0];
     double dy = parms[3] - parms[1];
@@ -316,7 +318,7 @@ double ColinearError(std::vector<double>& parms)
 	return error;
 }
 
-double LinePerpToAngleError(std::vector<double>& parms)
+double LinePerpToAngleError(const double *parms)
 {
 	double dx = parms[0] - parms[2];
 	double dy = parms[1] - parms[3];
@@ -336,19 +338,19 @@ double LinePerpToAngleError(std::vector<double>& parms)
     return (temp)*(temp)*1000;
 }
 
-double PointVerticalDistanceError(std::vector<double> &parms)
+double PointVerticalDistanceError(const double *parms)
 {
     double err = fabs(parms[1]) - fabs(parms[2]);
 	return err*err;
 }
 
-double PointHorizontalDistanceError(std::vector<double> &parms)
+double PointHorizontalDistanceError(const double *parms)
 {
     double err = fabs(parms[0]) - fabs(parms[2]);
 	return err*err;
 }
 
-double InternalAngleError(std::vector<double>& parms)
+double InternalAngleError(const double *parms)
 {
     double dx = parms[2] - parms[0];
     double dy = parms[3] - parms[1];
@@ -369,7 +371,7 @@ double InternalAngleError(std::vector<double>& parms)
 	return (temp-temp2)*(temp-temp2);
 }
 
-double ExternalAngleError(std::vector<double>& parms)
+double ExternalAngleError(const double *parms)
 {
     double dx = parms[2] - parms[0];
     double dy = parms[3] - parms[1];
@@ -389,3 +391,5 @@ double ExternalAngleError(std::vector<double>& parms)
 	double temp2 = cos(M_PI-angleP);
 	return (temp-temp2)*(temp-temp2);
 }
+
+#pragma managed(pop)
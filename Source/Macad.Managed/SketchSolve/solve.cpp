@@ -13,21 +13,32 @@
 #include <cmath>
 #include <stdlib.h>
 #include <sstream>
+#include <algorithm>
+
+#pragma managed(push, off)
+#include <OSD_Parallel.hxx>
 
 using namespace std;
 
 
 Solver::Solver()
 {
+	xLength = 0;
+	x = 0;
+	xsave = 0;
+	hessianValid = false;
+	algorithm = bfgs;
+	historyLength = LBFGSHistory;
+	historyCount = 0;
+	historyNext = 0;
 
 }
 
 void Solver::allocate(int xLength)
 {
    this->xLength = xLength;
-   if(x.size() < (size_t)xLength)
+   if(origSolution.size() < (size_t)xLength)
    {
-		x.resize(xLength);
 		origSolution.resize(xLength);
 		grad.resize(xLength);
 		s.resize(xLength);
@@ -64,22 +75,236 @@ void Solver::deallocate()
 
 int Solver::solve(double  **xin, int xLength, constraint * cons, int consLength, int isFine)
 {
-	int ret = solveI(xin,xLength,cons,consLength,isFine);
+	Load(cons,consLength,xin,xLength);
+
+	//Constraints which do not share any variable can be solved independently
+	std::vector<SolveComponent> components;
+	GetComponents(cons,components);
+	if(components.size() > 1)
+	{
+		return solveComponents(components,isFine);
+	}
+
+	xsave = xin;
+	int ret = solveI(isFine,false);
 	Unload();
 	deallocate();
 	return ret;
 }
 
-int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength, int isFine)
+int Solver::solveSingle(double  **xin, int xLength, constraint * cons, int consLength, int isFine)
+{
+	xsave = xin;
+	Load(cons,consLength,xin,xLength);
+	int ret = solveI(isFine,false);
+	Unload();
+	deallocate();
+	return ret;
+}
+
+int Solver::solveLoaded(int isFine)
+{
+	int ret = solveI(isFine,true);
+	Unload();
+	return ret;
+}
+
+class SolveComponentFunctor
+{
+	std::vector<SolveComponent> &components;
+	int isFine;
+	solveAlgorithm algorithm;
+	int historyLength;
+public:
+	SolveComponentFunctor(std::vector<SolveComponent> &components, int isFine, solveAlgorithm algorithm, int historyLength)
+		: components(components), isFine(isFine), algorithm(algorithm), historyLength(historyLength) {}
+
+	void operator()(int i) const
+	{
+		SolveComponent &component = components[i];
+		Solver solver;
+		solver.SetAlgorithm(algorithm);
+		solver.SetHistoryLength(historyLength);
+		component.result = solver.solveSingle(component.parameters.data(), (int)component.parameters.size(),
+		                                      component.constraints.data(), (int)component.constraints.size(), isFine);
+		component.statistics = solver.GetStatistics();
+	}
+};
+
+int Solver::solveComponents(std::vector<SolveComponent> &components, int isFine)
+{
+	//Save the original parameters, the system fails as a whole if one component has no solution
+	std::vector<double> origValues;
+	size_t consCount = 0;
+	for(size_t i=0; i < components.size(); i++)
+	{
+		for(size_t j=0; j < components[i].parameters.size(); j++)
+			origValues.push_back(*components[i].parameters[j]);
+		consCount += components[i].constraints.size();
+	}
+
+	OSD_Parallel::For(0, (int)components.size(), SolveComponentFunctor(components, isFine, algorithm, historyLength), consCount < ParallelMinConstraints);
+
+	//The components run side by side, the slowest one determines the iterations
+	statistics = solveStatistics();
+	bool solved = true;
+	for(size_t i=0; i < components.size(); i++)
+	{
+		const solveStatistics &componentStatistics = components[i].statistics;
+		solved &= components[i].result == succsess;
+		statistics.iterations = std::max(statistics.iterations, componentStatistics.iterations);
+		statistics.functionEvaluations += componentStatistics.functionEvaluations;
+		statistics.gradientEvaluations += componentStatistics.gradientEvaluations;
+		statistics.error += componentStatistics.error;
+		statistics.variableCount += componentStatistics.variableCount;
+		statistics.constraintCount += componentStatistics.constraintCount;
+	}
+	statistics.residual = sqrt(statistics.error);
+	if(solved)
+		return succsess;
+
+	size_t index = 0;
+	for(size_t i=0; i < components.size(); i++)
+	{
+		for(size_t j=0; j < components[i].parameters.size(); j++)
+			*components[i].parameters[j] = origValues[index++];
+	}
+	return noSolution;
+}
+
+SolverSession::SolverSession()
+{
+}
+
+SolverSession::~SolverSession()
+{
+	clear();
+}
+
+void SolverSession::clear()
 {
-		xsave = xin;
+	for(size_t i=0; i < solvers.size(); i++)
+		delete solvers[i];
+	solvers.clear();
+	components.clear();
+	dirty.clear();
+	componentsOfValue.clear();
+}
+
+void SolverSession::Load(double **x, int xLength, constraint *cons, int consLength)
+{
+	clear();
+
+	Solver loader;
+	loader.Load(cons,consLength,x,xLength);
+	loader.GetComponents(cons,components);
+
+	for(size_t i=0; i < components.size(); i++)
+	{
+		SolveComponent &component = components[i];
+		Solver *solver = new Solver();
+		solver->Load(component.constraints.data(), (int)component.constraints.size(), component.parameters.data(), (int)component.parameters.size());
+		solvers.push_back(solver);
+
+		const std::vector<double*> &variables = solver->GetVariableLocations();
+		for(size_t j=0; j < variables.size(); j++)
+			componentsOfValue.insert(std::make_pair(variables[j], (int)i));
+		const std::vector<double*> &statics = solver->GetStaticLocations();
+		for(size_t j=0; j < statics.size(); j++)
+			componentsOfValue.insert(std::make_pair(statics[j], (int)i));
+	}
+	dirty.assign(components.size(), true);
+}
+
+void SolverSession::Changed(double *value)
+{
+	std::pair<std::unordered_multimap<double*,int>::iterator, std::unordered_multimap<double*,int>::iterator> range = componentsOfValue.equal_range(value);
+	for(std::unordered_multimap<double*,int>::iterator it = range.first; it != range.second; ++it)
+		dirty[it->second] = true;
+}
+
+class SolveSessionFunctor
+{
+	const std::vector<int> &indices;
+	std::vector<Solver*> &solvers;
+	std::vector<SolveComponent> &components;
+	int isFine;
+public:
+	SolveSessionFunctor(const std::vector<int> &indices, std::vector<Solver*> &solvers, std::vector<SolveComponent> &components, int isFine)
+		: indices(indices), solvers(solvers), components(components), isFine(isFine) {}
+
+	void operator()(int i) const
+	{
+		int index = indices[i];
+		components[index].result = solvers[index]->solveLoaded(isFine);
+	}
+};
+
+int SolverSession::Solve(int isFine)
+{
+	//Only components with changed values need to be solved again
+	std::vector<int> indices;
+	std::vector<double> origValues;
+	size_t consCount = 0;
+	for(size_t i=0; i < components.size(); i++)
+	{
+		if(!dirty[i])
+			continue;
+		solvers[i]->Reload();
+		indices.push_back((int)i);
+		for(size_t j=0; j < components[i].parameters.size(); j++)
+			origValues.push_back(*components[i].parameters[j]);
+		consCount += components[i].constraints.size();
+	}
+
+	OSD_Parallel::For(0, (int)indices.size(), SolveSessionFunctor(indices, solvers, components, isFine), consCount < ParallelMinConstraints);
+
+	bool solved = true;
+	for(size_t i=0; i < indices.size(); i++)
+		solved &= components[indices[i]].result == succsess;
+	if(solved)
+	{
+		dirty.assign(components.size(), false);
+		return succsess;
+	}
+
+	//Restore the values, the components stay dirty
+	size_t index = 0;
+	for(size_t i=0; i < indices.size(); i++)
+	{
+		const std::vector<double*> &parameters = components[indices[i]].parameters;
+		for(size_t j=0; j < parameters.size(); j++)
+			*parameters[j] = origValues[index++];
+	}
+	return noSolution;
+}
 
-		Load(cons,consLength,xin,xLength);
+int Solver::solveI(int isFine, bool warmStart)
+{
+	ResetEvaluations();
+	statistics = solveStatistics();
+	statistics.variableCount = GetVectorSize();
+	statistics.constraintCount = GetConstraintCount();
+
+	int ret;
+	if(algorithm == levenbergMarquardt)
+		ret = solveLM(isFine);
+	else if(algorithm == limitedMemoryBfgs)
+		ret = solveLBFGS(isFine, warmStart);
+	else
+		ret = solveBFGS(isFine, warmStart);
+
+	statistics.functionEvaluations = GetFunctionEvaluations();
+	statistics.gradientEvaluations = GetGradientEvaluations();
+	statistics.error = statistics.residual * statistics.residual;
+	return ret;
+}
 
-		xLength = GetVectorSize();
+int Solver::solveBFGS(int isFine, bool warmStart)
+{
+		int xLength = GetVectorSize();
 		allocate(xLength);
-		for(int i=0; i < xLength; i++)
-			x[i] = GetInitialValue(i);
+		x = GetVector();
 
 
         std::stringstream cstr;
@@ -97,6 +322,7 @@ int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength
         //Calculate Function at the starting point:
         double f0;
 		f0 = GetError();
+		statistics.residual = sqrt(f0);
         if(f0<smallF) return succsess;
         ftimes++;
         //Calculate the gradient at the starting point:
@@ -107,10 +333,10 @@ int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength
         double f1,f2,f3,alpha1,alpha2,alpha3,alphaStar;
         norm = 0;
         pert = f0*pertMag;
+        GetGradient(grad.data(),pert);
+        ftimes+=xLength;
         for(int j=0;j<xLength;j++)
         {
-                grad[j]=GetGradient(j,pert);
-                ftimes++;
 #ifdef DEBUG
                 cstr << "gradient: " << grad[j];
                 debugprint(cstr.str());
@@ -121,9 +347,19 @@ int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength
         norm = sqrt(norm);
         //Estimate the norm of N
 
-        //Initialize N and calculate s
+        //Initialize N and calculate s, a warm start continues with the last Hessian approximation
+        bool keepHessian = warmStart && hessianValid;
         for(int i=0;i<xLength;i++)
         {
+                if(keepHessian)
+                {
+                        s[i]=0;
+                        for(int j=0;j<xLength;j++)
+                        {
+                                s[i]+=-N[i][j]*grad[j];
+                        }
+                        continue;
+                }
                 for(int j=0;j<xLength;j++)
                 {
                         if(i==j)
@@ -268,11 +504,11 @@ int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength
         deltaXtDotGamma = 0;
         pert = fnew*pertMag;
         if(pert<pertMin) pert = pertMin;
+        //Calculate the new gradient vector
+        GetGradient(gradnew.data(),pert);
+        ftimes+=xLength;
         for(int i=0;i<xLength;i++)
         {
-                //Calculate the new gradient vector
-                gradnew[i]= GetGradient(i,pert);
-                ftimes++;
                 //Calculate the change in the gradient
                 gamma[i]=gradnew[i]-grad[i];
                 bottom+=deltaX[i]*gamma[i];
@@ -521,15 +757,19 @@ int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength
 #endif
 
         ///End of function
+		statistics.iterations = iterations;
+		statistics.residual = sqrt(fnew);
         double validSolution;
         if(isFine==1) validSolution=validSolutionFine;
         else validSolution=validSoltuionRough;
         if(fnew<validSolution)
                 {
+                hessianValid = true;
                 return succsess;
                 }
         else
                 {
+                hessianValid = false;
 
                 //Replace the bad numbers with the last result
                 for(int i=0;i<xLength;i++)
@@ -541,3 +781,5 @@ int Solver::solveI(double  **xin, int xLength, constraint * cons, int consLength
 
 }
 
+
+#pragma managed(pop)
@@ -11,6 +11,8 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <unordered_map>
+#include <climits>
 #ifndef WIN32
         #define _hypot hypot
 #endif
@@ -97,6 +99,39 @@ pointVerticalDistance
 #define rough             0
 #define fine              1
 #define MaxIterations     50 //Note that the total number of iterations allowed is MaxIterations *xLength
+#define ParallelMinConstraints 64 //Below this number of constraints, independent components are solved sequentially
+
+///////////////////////////////////////
+/// Levenberg-Marquardt Solver parameters
+///////////////////////////////////////
+#define LMInitialDamping  1e-3
+#define LMMinDamping      1e-12
+#define LMMaxDamping      1e12
+#define LMMaxIterations   10 //Note that the total number of iterations allowed is LMMaxIterations *xLength
+#define JacobianPert      1e-8 //Relative, small enough to keep the curvature of the errors out of the residual derivatives
+
+///////////////////////////////////////
+/// L-BFGS Solver parameters
+///////////////////////////////////////
+#define LBFGSHistory      8 //Number of correction pairs kept to approximate the inverse Hessian
+#define LBFGSPertMax      1e-4 //Upper bound of the gradient perturbation, a large one spoils the correction pairs
+
+///////////////////////////////////////
+/// Analysis parameters
+///////////////////////////////////////
+#define AnalysisPert      1e-4 //Relative, perturbation for the second derivatives of satisfied constraints
+#define AnalysisTolerance 1e-6 //A Jacobian row is dependent if its part orthogonal to the previous rows is smaller
+
+///////////////////////////////////////
+/// Solve algorithms
+///////////////////////////////////////
+
+enum solveAlgorithm
+{
+bfgs,
+levenbergMarquardt,
+limitedMemoryBfgs
+};
 
 ///////////////////////////////////////
 /// Solve exit codes
@@ -175,12 +210,6 @@ public:
 
 void debugprint(std::string s);
 
-enum varLocation
-{
-   Vector,
-   Static
-};
-
 enum dependencyType
 {
    line1,
@@ -242,56 +271,204 @@ enum dependencyType
 
 class SolveImpl;
 
+//Outcome of the last solve
+struct solveStatistics
+{
+	solveStatistics() : iterations(0), functionEvaluations(0), gradientEvaluations(0), error(0), residual(0), variableCount(0), constraintCount(0) {}
+	int iterations;
+	int functionEvaluations;
+	int gradientEvaluations;
+	double error;
+	double residual;
+	int variableCount;
+	int constraintCount;
+};
+
+//Outcome of the degree of freedom analysis, constraint indices refer to the input array
+struct analysisResult
+{
+	analysisResult() : rank(0), freedom(0) {}
+	int rank;
+	int freedom;
+	std::vector<int> pointFreedom;
+	std::vector<int> redundant;
+	std::vector<int> conflicting;
+};
+
+//A set of constraints which does not share any variable with other constraints
+class SolveComponent
+{
+public:
+	SolveComponent(){result = 0;}
+	std::vector<constraint> constraints;
+	std::vector<double*> parameters;
+	int result;
+	solveStatistics statistics;
+};
+
+//Static registration of a constraint type
+#define MaxConstraintDependencies 8
+#define MaxConstraintValues       16
+
+typedef double (*errorFunction)(const double*);
+
+struct constraintRegistration
+{
+	constraintType type;
+	errorFunction error;
+	int dependencyCount;
+	dependencyType dependencies[MaxConstraintDependencies];
+};
+
+//Batch kernel evaluating constraints of one error function at once. The value indices are passed as
+//structure of arrays, value j of constraint c is found at v[index[j*stride+c]].
+typedef void (*errorKernel)(const double *v, const int *index, int stride, int count, double *errors);
+
+//Constraints sharing an error function, evaluated together by its kernel
+struct errorBlock
+{
+	errorKernel kernel;
+	int count;
+	int arity;
+	int valuestart;
+	int constraintstart;
+};
+
 class SolveImpl
 {
-	std::vector<double(*)(std::vector<double>&)> errors;
-	std::vector<std::vector<dependencyType> > dependencies;
-	std::set<constraintType> depset;
-	std::vector<std::vector<std::pair<varLocation,void*> > > constraintvars;
-	std::vector<double* > myvec;
-	std::vector<constraintType> constrainttypes;
-	std::map<double*,std::pair<varLocation,void*> > mapparms;
-	std::map<size_t,std::vector<size_t> > vecmap;
-	std::set<double*> mapset;
-	std::vector<double> pvec;
-	size_t next_vector;
-
-	void LoadDouble(std::vector<std::pair<varLocation,void*> > &mylist, double *d, int c);
-	void LoadPoint(std::vector<std::pair<varLocation,void*> > &mylist, point p, int c);
-	void LoadLine(std::vector<std::pair<varLocation,void*> > &mylist,line l, int c);
-	void LoadArc(std::vector<std::pair<varLocation,void*> > &mylist,arc a, int c);
-	void LoadCircle(std::vector<std::pair<varLocation,void*> > &mylist,circle c, int con);
-	void LoadEllipse(std::vector<std::pair<varLocation,void*> > &mylist,ellipse e, int con);
-	void registerconstraint(constraintType,double(*)(std::vector<double>&));
-	void registerdependency(constraintType,dependencyType);
+	//All values referenced by the constraints, the variables are followed by the static values
+	std::vector<double> values;
+	std::vector<double*> myvec;
+	int variablecount;
+
+	//Per constraint: error function, index in the input array and the indices of its values (CSR)
+	std::vector<errorFunction> constrainterrors;
+	std::vector<int> constraintindex;
+	std::vector<int> constraintstart;
+	std::vector<int> constraintvalues;
+
+	//Per variable: indices of the constraints depending on it (CSR)
+	std::vector<int> variablestart;
+	std::vector<int> variableconstraints;
+
+	//Locations of the static values
+	std::vector<double*> staticvec;
+
+	//Batch evaluation: blocks with the value indices of their constraints as structure of arrays,
+	//constraints of error functions without a kernel are evaluated one by one
+	bool batchevaluation;
+	std::vector<errorBlock> errorblocks;
+	std::vector<int> blockvalues;
+	std::vector<int> blockconstraints;
+	std::vector<int> singleconstraints;
+	std::vector<double> blockerrors;
+	std::vector<double> errors;
+
+	//Only used while loading
+	static const int unusedVariable = INT_MIN;
+	std::unordered_map<double*,int> valueindex;
+
+	//Number of evaluations of all errors and of the gradient or Jacobian
+	int functionevaluations;
+	int gradientevaluations;
+
+	void LoadDouble(double *d);
+	void LoadPoint(const point &p);
+	void LoadLine(const line &l);
+	void LoadArc(const arc &a);
+	void LoadCircle(const circle &c);
+	void LoadEllipse(const ellipse &e);
+	bool DependsOnBefore(int i, int j) const;
+	void LoadBlocks();
 	double GetErrorForGrad(int i);
 
-protected:
-	std::map<double*,int> parms;
-
 public:
 	SolveImpl();
-	~SolveImpl();
+	virtual ~SolveImpl();
+
+	static const constraintRegistration* GetRegistration(constraintType type);
+	static errorKernel GetKernel(errorFunction error);
 
 	void Load(constraint* c, int nconstraints, double** p, int nparms);
-	void Load(constraint &c);
+	bool Load(const constraint &c);
 	void Unload();
+	void Reload();
+	const std::vector<double*>& GetVariableLocations() const {return myvec;}
+	const std::vector<double*>& GetStaticLocations() const {return staticvec;}
+	void GetComponents(constraint* c, std::vector<SolveComponent> &components) const;
 	double GetError();
 	double GetError(int i);
+	void GetErrors(double *errors);
+	void SetBatchEvaluation(bool batch) {batchevaluation = batch;}
 
 	int GetVectorSize() const;
-	double GetInitialValue(int i);
+	double* GetVector() {return values.data();}
 	double GetGradient(int i, double pert);
-	virtual double GetElement(size_t i) =0; //Pure virtual
-	virtual void SetElement(size_t i, double v) = 0;
+	void GetGradient(double *gradient, double pert);
+	double GetResiduals(std::vector<double> &residuals);
+	void ResetEvaluations() {functionevaluations = 0; gradientevaluations = 0;}
+	int GetFunctionEvaluations() const {return functionevaluations;}
+	int GetGradientEvaluations() const {return gradientevaluations;}
+	int GetConstraintCount() const {return (int)constrainterrors.size();}
+	int GetConstraintIndex(int i) const {return constraintindex[i];}
+	void GetJacobianStructure(std::vector<int> &rowstart, std::vector<int> &columns) const;
+	void GetJacobian(const std::vector<int> &rowstart, const std::vector<int> &columns, const std::vector<double> &residuals, std::vector<double> &jacobian);
+	double GetResidualChange(int i, int v, double pert, double r0);
+	double GetElement(size_t i) const {return values[i];}
+	void SetElement(size_t i, double v) {values[i] = v;}
 	virtual int solve(double  **x,int xLength, constraint * cons, int consLength, int isFine) = 0;
 };
 
+//Sparse LDL' factorization of a symmetric positive definite matrix, the upper triangle is stored
+//column by column. The symbolic analysis is done once, the pattern must not change afterwards.
+class SparseLDL
+{
+	int n;
+	std::vector<int> parent;
+	std::vector<int> lnz;
+	std::vector<int> flag;
+	std::vector<int> pattern;
+	std::vector<int> lp;
+	std::vector<int> li;
+	std::vector<double> lx;
+	std::vector<double> d;
+	std::vector<double> y;
+
+public:
+	std::vector<int> colstart;
+	std::vector<int> rows;
+	std::vector<double> entries;
+
+	SparseLDL() : n(0) {}
+	void Analyze(int size);
+	bool Factorize();
+	void Solve(double *b) const;
+};
+
 class Solver: public SolveImpl
 {
 	int xLength;
-	std::vector<double> x;
+	double *x;
 	double **xsave;
+	bool hessianValid;
+	solveAlgorithm algorithm;
+	solveStatistics statistics;
+
+	//Levenberg-Marquardt: sparse Jacobian (CSR) and the LDL' factorization of the normal equations
+	std::vector<int> jacobianstart;
+	std::vector<int> jacobiancolumns;
+	std::vector<double> jacobian;
+	std::vector<double> residuals;
+	SparseLDL normal;
+
+	//L-BFGS: the last correction pairs (deltaX, gamma) in a ring buffer of historyLength * xLength values
+	int historyLength;
+	int historyCount;
+	int historyNext;
+	std::vector<double> historyDeltaX;
+	std::vector<double> historyGamma;
+	std::vector<double> historyRho;
+	std::vector<double> historyAlpha;
 	std::vector<double> origSolution;
 	std::vector<double> grad;
 	std::vector<double> s;
@@ -307,15 +484,50 @@ class Solver: public SolveImpl
     std::vector<std::vector<double> > NDotGammaDotDeltaXt;
 
 	void allocate(int xLength);
-	int solveI(double  **x,int xLength, constraint * cons, int consLength, int isFine);
+	int solveI(int isFine, bool warmStart);
+	int solveBFGS(int isFine, bool warmStart);
+	int solveLM(int isFine);
+	int solveLBFGS(int isFine, bool warmStart);
+	void directionLBFGS(const std::vector<double> &gradient, std::vector<double> &direction);
+	double lineSearch(const std::vector<double> &xold, const std::vector<double> &direction, double f0);
+	int solveComponents(std::vector<SolveComponent> &components, int isFine);
+	void analysisRows(int i, const int *columns, int count, int equations, std::vector<double> &rows);
 	void deallocate();
 public:
 	Solver();
 	~Solver();
-	
+
+	void SetAlgorithm(solveAlgorithm a) {algorithm = a;}
+	void SetHistoryLength(int length) {historyLength = length > 0 ? length : 1;}
+	const solveStatistics& GetStatistics() const {return statistics;}
+
 	int solve(double  **x,int xLength, constraint * cons, int consLength, int isFine);
-	double GetElement(size_t i){return x[i];}
-	void SetElement(size_t i, double v) { x[i] = v;}
+	int solveSingle(double  **x,int xLength, constraint * cons, int consLength, int isFine);
+	int solveLoaded(int isFine);
+	int analyze(double **x, int xLength, constraint *cons, int consLength, const point *points, int pointCount, analysisResult &result);
+};
+
+//Keeps a loaded constraint system and the state of its solvers between solves,
+//a re-solve after changing some values starts with the last Hessian approximation.
+class SolverSession
+{
+	std::vector<SolveComponent> components;
+	std::vector<Solver*> solvers;
+	std::vector<bool> dirty;
+	std::unordered_multimap<double*,int> componentsOfValue;
+
+	SolverSession(const SolverSession&);
+	SolverSession& operator=(const SolverSession&);
+	void clear();
+
+public:
+	SolverSession();
+	~SolverSession();
+
+	void Load(double **x, int xLength, constraint *cons, int consLength);
+	void Changed(double *value);
+	int Solve(int isFine);
+	int GetComponentCount() const {return (int)components.size();}
 };
 
 //Function Prototypes
@@ -323,31 +535,31 @@ double calc(constraint * cons, int consLength);
 void derivatives(double **x,double *gradF,int xLength, constraint * cons, int consLength);
 
 //Error functions
-double HorizontalError(std::vector<double> &parms);
-double ParallelError(std::vector<double> &parms);
-double VerticalError(std::vector<double> &parms);
-double PointOnPointError(std::vector<double> &parms);
-double P2PDistanceError(std::vector<double> &parms);
-double P2PDistanceHorzError(std::vector<double> &parms);
-double P2PDistanceVertError(std::vector<double> &parms);
-double PointOnLineError(std::vector<double> &parms);
-double P2LDistanceError(std::vector<double> &parms);
-double P2LDistanceVertError(std::vector<double> &parms);
-double P2LDistanceHorzError(std::vector<double> &parms);
-double LineLengthError(std::vector<double> &parms);
-double EqualLengthError(std::vector<double> &parms);
-double EqualScalarError(std::vector<double> &parms);
-double PointOnArcAngleError(std::vector<double> &parms);
-double PerpendicularError(std::vector<double> &parms);
-double ArcAngleOnArcAngleError(std::vector<double> &parms);
-double ColinearError(std::vector<double>& parms);
-double LinePerpToAngleError(std::vector<double>& parms);
-double EllipseTangentError(std::vector<double>& parms);
-double PointOnLineMidpointError(std::vector<double>& parms);
-double PointHorizontalDistanceError(std::vector<double>& parms);
-double PointVerticalDistanceError(std::vector<double>& parms);
-double InternalAngleError(std::vector<double>& parms);
-double ExternalAngleError(std::vector<double>& parms);
+double HorizontalError(const double *parms);
+double ParallelError(const double *parms);
+double VerticalError(const double *parms);
+double PointOnPointError(const double *parms);
+double P2PDistanceError(const double *parms);
+double P2PDistanceHorzError(const double *parms);
+double P2PDistanceVertError(const double *parms);
+double PointOnLineError(const double *parms);
+double P2LDistanceError(const double *parms);
+double P2LDistanceVertError(const double *parms);
+double P2LDistanceHorzError(const double *parms);
+double LineLengthError(const double *parms);
+double EqualLengthError(const double *parms);
+double EqualScalarError(const double *parms);
+double PointOnArcAngleError(const double *parms);
+double PerpendicularError(const double *parms);
+double ArcAngleOnArcAngleError(const double *parms);
+double ColinearError(const double *parms);
+double LinePerpToAngleError(const double *parms);
+double EllipseTangentError(const double *parms);
+double PointOnLineMidpointError(const double *parms);
+double PointHorizontalDistanceError(const double *parms);
+double PointVerticalDistanceError(const double *parms);
+double InternalAngleError(const double *parms);
+double ExternalAngleError(const double *parms);
 
 
 #endif /* SOLVE_H_ */
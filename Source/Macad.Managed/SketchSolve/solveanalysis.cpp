@@ -0,0 +1,425 @@
+/*
+ * solveanalysis.cpp
+ *
+ *  Degree of freedom and redundancy analysis of a constraint system at its current values.
+ *      This program is released under the BSD license. See the file License.txt for details.
+ *
+ */
+
+#include "solve.h"
+#include <cmath>
+#include <algorithm>
+
+#pragma managed(push, off)
+
+using namespace std;
+
+typedef std::vector<std::pair<int,double> > sparseVector;
+
+//Number of scalar equations which are summed up by the error function of a constraint
+static int EquationCount(constraintType type)
+{
+	switch(type)
+	{
+		case pointOnPoint:
+		case pointOnLineMidpoint:
+		case concentricArcs:
+		case concentricCircles:
+		case concentricCircArc:
+		case pointOnArcStart:
+		case pointOnArcEnd:
+		case arcEndToArcEnd:
+		case arcStartToArcEnd:
+		case arcStartToArcStart:
+		case colinear:
+			return 2;
+		default:
+			return 1;
+	}
+}
+
+//Cyclic Jacobi rotations of a small symmetric matrix (row major), the eigenvectors are the columns of v
+static void SymmetricEigen(std::vector<double> &a, int n, std::vector<double> &eigenvalues, std::vector<double> &v)
+{
+	v.assign(n*n, 0.0);
+	for(int i=0; i < n; i++)
+		v[i*n+i] = 1;
+
+	for(int sweep=0; sweep < 50; sweep++)
+	{
+		double offDiagonal = 0, diagonal = 0;
+		for(int p=0; p < n; p++)
+		{
+			diagonal += a[p*n+p] * a[p*n+p];
+			for(int q=p+1; q < n; q++)
+				offDiagonal += a[p*n+q] * a[p*n+q];
+		}
+		if(offDiagonal <= 1e-30 * diagonal)
+			break;
+
+		for(int p=0; p < n; p++)
+		{
+			for(int q=p+1; q < n; q++)
+			{
+				double apq = a[p*n+q];
+				if(apq == 0)
+					continue;
+				double theta = (a[q*n+q] - a[p*n+p]) / (2 * apq);
+				double t = (theta >= 0 ? 1 : -1) / (fabs(theta) + sqrt(theta * theta + 1));
+				double c = 1 / sqrt(t * t + 1);
+				double s = t * c;
+				for(int k=0; k < n; k++)
+				{
+					double akp = a[k*n+p];
+					double akq = a[k*n+q];
+					a[k*n+p] = c * akp - s * akq;
+					a[k*n+q] = s * akp + c * akq;
+				}
+				for(int k=0; k < n; k++)
+				{
+					double apk = a[p*n+k];
+					double aqk = a[q*n+k];
+					a[p*n+k] = c * apk - s * aqk;
+					a[q*n+k] = s * apk + c * aqk;
+				}
+				for(int k=0; k < n; k++)
+				{
+					double vkp = v[k*n+p];
+					double vkq = v[k*n+q];
+					v[k*n+p] = c * vkp - s * vkq;
+					v[k*n+q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	eigenvalues.resize(n);
+	for(int i=0; i < n; i++)
+		eigenvalues[i] = a[i*n+i];
+}
+
+//Dot product of two columns of the row space basis, the entries are sorted by basis index
+static double ColumnDot(const sparseVector &a, const sparseVector &b)
+{
+	double dot = 0;
+	size_t i = 0, j = 0;
+	while(i < a.size() && j < b.size())
+	{
+		if(a[i].first < b[j].first)
+			i++;
+		else if(a[i].first > b[j].first)
+			j++;
+		else
+			dot += a[i++].second * b[j++].second;
+	}
+	return dot;
+}
+
+void Solver::analysisRows(int i, const int *columns, int count, int equations, std::vector<double> &rows)
+{
+	//Rows of the Jacobian of the constraint equations, normalized and count values wide
+	rows.clear();
+	if(count == 0)
+		return;
+
+	double e0 = GetError(i);
+	if(equations == 1 && e0 > validSolutionFine)
+	{
+		//The derivative of the residual is well defined away from the solution
+		rows.resize(count);
+		double norm = 0;
+		for(int a=0; a < count; a++)
+		{
+			double old = GetElement(columns[a]);
+			double pert = JacobianPert * std::max(1.0, fabs(old));
+			SetElement(columns[a], old - pert);
+			double e1 = GetError(i);
+			SetElement(columns[a], old + pert);
+			double e2 = GetError(i);
+			SetElement(columns[a], old);
+			rows[a] = (sqrt(std::max(e2, 0.0)) - sqrt(std::max(e1, 0.0))) / (2 * pert);
+			norm += rows[a] * rows[a];
+		}
+		norm = sqrt(norm);
+		if(norm == 0)
+		{
+			rows.clear();
+			return;
+		}
+		for(int a=0; a < count; a++)
+			rows[a] /= norm;
+		return;
+	}
+
+	//At the solution the Hessian of the squared error is twice the sum of the dyadic products of the
+	//equation gradients, its eigenvectors with a significant eigenvalue span the same space
+	std::vector<double> pert(count);
+	for(int a=0; a < count; a++)
+		pert[a] = AnalysisPert * std::max(1.0, fabs(GetElement(columns[a])));
+
+	std::vector<double> hessian(count * count);
+	for(int a=0; a < count; a++)
+	{
+		double olda = GetElement(columns[a]);
+		SetElement(columns[a], olda + pert[a]);
+		double ep = GetError(i);
+		SetElement(columns[a], olda - pert[a]);
+		double em = GetError(i);
+		SetElement(columns[a], olda);
+		hessian[a*count+a] = (ep - 2 * e0 + em) / (pert[a] * pert[a]);
+
+		for(int b=a+1; b < count; b++)
+		{
+			double oldb = GetElement(columns[b]);
+			double sum = 0;
+			for(int sa=-1; sa <= 1; sa+=2)
+			{
+				for(int sb=-1; sb <= 1; sb+=2)
+				{
+					SetElement(columns[a], olda + sa * pert[a]);
+					SetElement(columns[b], oldb + sb * pert[b]);
+					sum += sa * sb * GetError(i);
+				}
+			}
+			SetElement(columns[a], olda);
+			SetElement(columns[b], oldb);
+			hessian[a*count+b] = hessian[b*count+a] = sum / (4 * pert[a] * pert[b]);
+		}
+	}
+
+	std::vector<double> eigenvalues, eigenvectors;
+	SymmetricEigen(hessian, count, eigenvalues, eigenvectors);
+	std::vector<int> order(count);
+	for(int a=0; a < count; a++)
+	{
+		//Sort by descending eigenvalue
+		int b = a;
+		for(; b > 0 && eigenvalues[order[b-1]] < eigenvalues[a]; b--)
+			order[b] = order[b-1];
+		order[b] = a;
+	}
+
+	double largest = eigenvalues[order[0]];
+	if(!(largest > 0))
+		return;
+	for(int k=0; k < std::min(equations, count); k++)
+	{
+		if(eigenvalues[order[k]] < AnalysisTolerance * largest)
+			break;
+		for(int a=0; a < count; a++)
+			rows.push_back(eigenvectors[a*count+order[k]]);
+	}
+}
+
+int Solver::analyze(double **xin, int xLength, constraint *cons, int consLength, const point *points, int pointCount, analysisResult &result)
+{
+	result = analysisResult();
+	Load(cons, consLength, xin, xLength);
+	int n = GetVectorSize();
+	int nconstraints = GetConstraintCount();
+
+	std::vector<int> rowstart, columns;
+	GetJacobianStructure(rowstart, columns);
+
+	//Orthonormal basis of the row space built by Gram-Schmidt, stored sparse by rows and by columns.
+	//Constraints are added in their order, so a constraint is dependent on the ones before it.
+	std::vector<sparseVector> basisRows;
+	std::vector<sparseVector> basisColumns(n);
+	std::vector<double> w(n, 0.0);
+	std::vector<bool> touched(n, false);
+	std::vector<int> touchedList;
+	std::vector<double> coefficients;
+	std::vector<bool> coefficientUsed;
+	std::vector<int> coefficientList;
+	std::vector<int> dependent;
+	std::vector<double> rows;
+
+	for(int i=0; i < nconstraints; i++)
+	{
+		int count = rowstart[i+1] - rowstart[i];
+		const int *cols = count > 0 ? &columns[rowstart[i]] : 0;
+		int equations = EquationCount(cons[GetConstraintIndex(i)].type);
+		analysisRows(i, cols, count, equations, rows);
+
+		int accepted = 0;
+		for(size_t r=0; count > 0 && r < rows.size(); r += count)
+		{
+			for(int a=0; a < count; a++)
+			{
+				w[cols[a]] = rows[r+a];
+				touched[cols[a]] = true;
+				touchedList.push_back(cols[a]);
+			}
+
+			//Classical Gram-Schmidt, repeated once to keep the basis orthogonal
+			for(int pass=0; pass < 2; pass++)
+			{
+				coefficients.resize(basisRows.size(), 0.0);
+				coefficientUsed.resize(basisRows.size(), false);
+				size_t ntouched = touchedList.size();
+				for(size_t t=0; t < ntouched; t++)
+				{
+					int j = touchedList[t];
+					if(w[j] == 0)
+						continue;
+					for(size_t q=0; q < basisColumns[j].size(); q++)
+					{
+						int k = basisColumns[j][q].first;
+						if(!coefficientUsed[k])
+						{
+							coefficientUsed[k] = true;
+							coefficientList.push_back(k);
+						}
+						coefficients[k] += w[j] * basisColumns[j][q].second;
+					}
+				}
+				for(size_t c=0; c < coefficientList.size(); c++)
+				{
+					int k = coefficientList[c];
+					for(size_t q=0; q < basisRows[k].size(); q++)
+					{
+						int j = basisRows[k][q].first;
+						if(!touched[j])
+						{
+							touched[j] = true;
+							touchedList.push_back(j);
+						}
+						w[j] -= coefficients[k] * basisRows[k][q].second;
+					}
+					coefficients[k] = 0;
+					coefficientUsed[k] = false;
+				}
+				coefficientList.clear();
+			}
+
+			double norm = 0;
+			for(size_t t=0; t < touchedList.size(); t++)
+				norm += w[touchedList[t]] * w[touchedList[t]];
+			norm = sqrt(norm);
+
+			if(norm > AnalysisTolerance)
+			{
+				int k = (int)basisRows.size();
+				basisRows.push_back(sparseVector());
+				for(size_t t=0; t < touchedList.size(); t++)
+				{
+					int j = touchedList[t];
+					double value = w[j] / norm;
+					if(fabs(value) < 1e-15)
+						continue;
+					basisRows[k].push_back(std::make_pair(j, value));
+					basisColumns[j].push_back(std::make_pair(k, value));
+				}
+				accepted++;
+			}
+
+			for(size_t t=0; t < touchedList.size(); t++)
+			{
+				w[touchedList[t]] = 0;
+				touched[touchedList[t]] = false;
+			}
+			touchedList.clear();
+		}
+
+		if(accepted < equations)
+			dependent.push_back(i);
+	}
+
+	result.rank = (int)basisRows.size();
+	result.freedom = xLength - result.rank;
+
+	//Dependent constraints which are satisfied are redundant. The others might still be implied by the
+	//independent constraints, which is checked by solving them alone. Else they are in conflict. If the
+	//independent constraints cannot be solved either, nothing is known about them and they are not reported.
+	std::vector<int> unsatisfied;
+	for(size_t d=0; d < dependent.size(); d++)
+	{
+		if(GetError(dependent[d]) < validSolutionFine)
+			result.redundant.push_back(GetConstraintIndex(dependent[d]));
+		else
+			unsatisfied.push_back(dependent[d]);
+	}
+
+	if(!unsatisfied.empty())
+	{
+		std::vector<constraint> independent;
+		size_t d = 0;
+		for(int i=0; i < nconstraints; i++)
+		{
+			if(d < dependent.size() && dependent[d] == i)
+				d++;
+			else
+				independent.push_back(cons[GetConstraintIndex(i)]);
+		}
+
+		std::vector<double> saved(xLength);
+		for(int j=0; j < xLength; j++)
+			saved[j] = *xin[j];
+
+		bool solved = true;
+		if(!independent.empty())
+		{
+			Solver reduced;
+			reduced.SetAlgorithm(levenbergMarquardt);
+			solved = reduced.solve(xin, xLength, independent.data(), (int)independent.size(), fine) == succsess;
+		}
+
+		Reload();
+		for(size_t u=0; solved && u < unsatisfied.size(); u++)
+		{
+			if(GetError(unsatisfied[u]) < validSolutionFine)
+				result.redundant.push_back(GetConstraintIndex(unsatisfied[u]));
+			else
+				result.conflicting.push_back(GetConstraintIndex(unsatisfied[u]));
+		}
+
+		for(int j=0; j < xLength; j++)
+			*xin[j] = saved[j];
+		Reload();
+	}
+	std::sort(result.redundant.begin(), result.redundant.end());
+
+	//The freedom of a point is the rank of its block in the projection onto the null space
+	std::unordered_map<double*,int> columnOf;
+	const std::vector<double*> &variables = GetVariableLocations();
+	for(int j=0; j < n; j++)
+		columnOf[variables[j]] = j;
+	for(int j=0; j < xLength; j++)
+	{
+		if(columnOf.find(xin[j]) == columnOf.end())
+			columnOf[xin[j]] = -1; //Variable not used by any constraint
+	}
+
+	result.pointFreedom.resize(pointCount);
+	for(int p=0; p < pointCount; p++)
+	{
+		int c[2] = { -2, -2 };
+		double *coordinates[2] = { points[p].x, points[p].y };
+		for(int a=0; a < 2; a++)
+		{
+			std::unordered_map<double*,int>::const_iterator it = columnOf.find(coordinates[a]);
+			if(it != columnOf.end())
+				c[a] = it->second;
+		}
+
+		double block[2][2] = { { 0, 0 }, { 0, 0 } };
+		for(int a=0; a < 2; a++)
+		{
+			if(c[a] == -1)
+				block[a][a] = 1;
+			else if(c[a] >= 0)
+				block[a][a] = 1 - ColumnDot(basisColumns[c[a]], basisColumns[c[a]]);
+		}
+		if(c[0] >= 0 && c[1] >= 0 && c[0] != c[1])
+			block[0][1] = block[1][0] = -ColumnDot(basisColumns[c[0]], basisColumns[c[1]]);
+
+		double halfTrace = (block[0][0] + block[1][1]) / 2;
+		double determinant = block[0][0] * block[1][1] - block[0][1] * block[1][0];
+		double root = sqrt(std::max(halfTrace * halfTrace - determinant, 0.0));
+		result.pointFreedom[p] = (halfTrace + root > AnalysisTolerance ? 1 : 0) + (halfTrace - root > AnalysisTolerance ? 1 : 0);
+	}
+
+	return result.conflicting.empty() ? succsess : noSolution;
+}
+
+#pragma managed(pop)
@@ -0,0 +1,340 @@
+/*
+ * solvebatch.cpp
+ *
+ *  Batch evaluation of the constraint errors, grouped by error function into structure of arrays blocks.
+ *      This program is released under the BSD license. See the file License.txt for details.
+ *
+ */
+
+#include "solve.h"
+#include <cmath>
+#include <algorithm>
+
+#pragma managed(push, off)
+
+using namespace std;
+
+//Number of constraints evaluated at once, keeps the errors of a chunk in the first level cache
+#define BatchChunkSize 256
+
+//The kernels read the values of one block directly through its index columns and call no function,
+//so that the compiler can inline the arithmetic and vectorize the loops where the target allows it.
+//They must compute exactly the same as the error functions in errorfuncs.cpp.
+
+static void HorizontalKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *y1 = index + stride;
+	const int *y2 = index + 3*stride;
+	for(int c=0; c < count; c++)
+	{
+		double ody = v[y2[c]] - v[y1[c]];
+		errors[c] = ody*ody*1000;
+	}
+}
+
+static void VerticalKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *x2 = index + 2*stride;
+	for(int c=0; c < count; c++)
+	{
+		double odx = v[x2[c]] - v[x1[c]];
+		errors[c] = odx*odx*1000;
+	}
+}
+
+static void PointOnPointKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *y1 = index + stride;
+	const int *x2 = index + 2*stride;
+	const int *y2 = index + 3*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x1[c]] - v[x2[c]];
+		double dy = v[y1[c]] - v[y2[c]];
+		errors[c] = dx*dx + dy*dy;
+	}
+}
+
+static void P2PDistanceKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *y1 = index + stride;
+	const int *x2 = index + 2*stride;
+	const int *y2 = index + 3*stride;
+	const int *distance = index + 4*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x1[c]] - v[x2[c]];
+		double dy = v[y1[c]] - v[y2[c]];
+		double d = v[distance[c]];
+		double err = dx*dx+dy*dy - d * d;
+		errors[c] = err*err;
+	}
+}
+
+static void P2PDistanceHorzKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *x2 = index + 2*stride;
+	const int *distance = index + 4*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x1[c]] - v[x2[c]];
+		double d = v[distance[c]];
+		double err = dx*dx - d * d;
+		errors[c] = err*err;
+	}
+}
+
+static void P2PDistanceVertKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *y1 = index + stride;
+	const int *y2 = index + 3*stride;
+	const int *distance = index + 4*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dy = v[y1[c]] - v[y2[c]];
+		double d = v[distance[c]];
+		double err = dy*dy - d * d;
+		errors[c] = err*err;
+	}
+}
+
+static void P2LDistanceKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *lx = index;
+	const int *ly = index + stride;
+	const int *lx2 = index + 2*stride;
+	const int *ly2 = index + 3*stride;
+	const int *px = index + 4*stride;
+	const int *py = index + 5*stride;
+	const int *rad = index + 6*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[lx[c]] - v[lx2[c]];
+		double dy = v[ly[c]] - v[ly2[c]];
+		double radsq = v[rad[c]] * v[rad[c]];
+
+		double t=-(v[lx[c]]*dx-v[px[c]]*dx+v[ly[c]]*dy-v[py[c]]*dy)/(dx*dx+dy*dy);
+		double Xint=v[lx[c]]+dx*t;
+		double Yint=v[ly[c]]+dy*t;
+		double distance = sqrt((v[px[c]] - Xint)*(v[px[c]] - Xint)+(v[py[c]] - Yint)*(v[py[c]] - Yint));
+
+		double temp = distance - sqrt(radsq);
+		errors[c] = temp*temp*100;
+	}
+}
+
+static void LineLengthKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *y1 = index + stride;
+	const int *x2 = index + 2*stride;
+	const int *y2 = index + 3*stride;
+	const int *length = index + 4*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x1[c]] - v[x2[c]];
+		double dy = v[y1[c]] - v[y2[c]];
+		double temp = sqrt(dx*dx+dy*dy) - v[length[c]];
+		errors[c] = temp*temp*100;
+	}
+}
+
+static void EqualLengthKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *y1 = index + stride;
+	const int *x2 = index + 2*stride;
+	const int *y2 = index + 3*stride;
+	const int *x3 = index + 4*stride;
+	const int *y3 = index + 5*stride;
+	const int *x4 = index + 6*stride;
+	const int *y4 = index + 7*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x1[c]] - v[x2[c]];
+		double dy = v[y1[c]] - v[y2[c]];
+		double dx2 = v[x3[c]] - v[x4[c]];
+		double dy2 = v[y3[c]] - v[y4[c]];
+		double temp = sqrt(dx*dx+dy*dy) - sqrt(dx2*dx2+dy2*dy2);
+		errors[c] = temp*temp;
+	}
+}
+
+static void EqualScalarKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *a = index;
+	const int *b = index + stride;
+	for(int c=0; c < count; c++)
+	{
+		double temp = v[a[c]] - v[b[c]];
+		errors[c] = temp*temp;
+	}
+}
+
+static void ParallelKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *y1 = index + stride;
+	const int *x2 = index + 2*stride;
+	const int *y2 = index + 3*stride;
+	const int *x3 = index + 4*stride;
+	const int *y3 = index + 5*stride;
+	const int *x4 = index + 6*stride;
+	const int *y4 = index + 7*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x2[c]] - v[x1[c]];
+		double dy = v[y2[c]] - v[y1[c]];
+		double dx2 = v[x4[c]] - v[x3[c]];
+		double dy2 = v[y4[c]] - v[y3[c]];
+
+		double hyp1=sqrt(dx*dx+dy*dy);
+		double hyp2=sqrt(dx2*dx2+dy2*dy2);
+
+		dx=dx/hyp1;
+		dy=dy/hyp1;
+		dx2=dx2/hyp2;
+		dy2=dy2/hyp2;
+
+		double temp = dy*dx2-dx*dy2;
+		errors[c] = (temp)*(temp)*1000;
+	}
+}
+
+static void PerpendicularKernel(const double * __restrict v, const int * __restrict index, int stride, int count, double * __restrict errors)
+{
+	const int *x1 = index;
+	const int *y1 = index + stride;
+	const int *x2 = index + 2*stride;
+	const int *y2 = index + 3*stride;
+	const int *x3 = index + 4*stride;
+	const int *y3 = index + 5*stride;
+	const int *x4 = index + 6*stride;
+	const int *y4 = index + 7*stride;
+	for(int c=0; c < count; c++)
+	{
+		double dx = v[x2[c]] - v[x1[c]];
+		double dy = v[y2[c]] - v[y1[c]];
+		double dx2 = v[x4[c]] - v[x3[c]];
+		double dy2 = v[y4[c]] - v[y3[c]];
+
+		double hyp1=sqrt(dx*dx+dy*dy);
+		double hyp2=sqrt(dx2*dx2+dy2*dy2);
+
+		dx=dx/hyp1;
+		dy=dy/hyp1;
+		dx2=dx2/hyp2;
+		dy2=dy2/hyp2;
+
+		double temp = dx*dx2+dy*dy2;
+		errors[c] = (temp)*(temp)*10;
+	}
+}
+
+//Kernels of the error functions, all others are evaluated constraint by constraint
+static const struct
+{
+	errorFunction error;
+	errorKernel kernel;
+	int arity;
+}
+errorKernels[] =
+{
+	{ HorizontalError,      HorizontalKernel,      4 },
+	{ VerticalError,        VerticalKernel,        4 },
+	{ PointOnPointError,    PointOnPointKernel,    4 },
+	{ P2PDistanceError,     P2PDistanceKernel,     5 },
+	{ P2PDistanceHorzError, P2PDistanceHorzKernel, 5 },
+	{ P2PDistanceVertError, P2PDistanceVertKernel, 5 },
+	{ P2LDistanceError,     P2LDistanceKernel,     7 },
+	{ LineLengthError,      LineLengthKernel,      5 },
+	{ EqualLengthError,     EqualLengthKernel,     8 },
+	{ EqualScalarError,     EqualScalarKernel,     2 },
+	{ ParallelError,        ParallelKernel,        8 },
+	{ PerpendicularError,   PerpendicularKernel,   8 },
+};
+
+errorKernel SolveImpl::GetKernel(errorFunction error)
+{
+	for(size_t i=0; i < sizeof(errorKernels)/sizeof(errorKernels[0]); i++)
+	{
+		if(errorKernels[i].error == error)
+			return errorKernels[i].kernel;
+	}
+	return 0;
+}
+
+void SolveImpl::LoadBlocks()
+{
+	errorblocks.clear();
+	blockvalues.clear();
+	blockconstraints.clear();
+	singleconstraints.clear();
+
+	int nconstraints = (int)constrainterrors.size();
+	errors.resize(nconstraints);
+	blockerrors.resize(BatchChunkSize);
+
+	//Group the constraints by their error function, keeping their order within each group
+	std::map<errorFunction, std::vector<int> > groups;
+	for(int i=0; i < nconstraints; i++)
+	{
+		if(GetKernel(constrainterrors[i]) == 0)
+			singleconstraints.push_back(i);
+		else
+			groups[constrainterrors[i]].push_back(i);
+	}
+
+	for(std::map<errorFunction, std::vector<int> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+	{
+		const std::vector<int> &members = it->second;
+		errorBlock block;
+		block.kernel = GetKernel(it->first);
+		block.count = (int)members.size();
+		block.arity = constraintstart[members[0]+1] - constraintstart[members[0]];
+		block.valuestart = (int)blockvalues.size();
+		block.constraintstart = (int)blockconstraints.size();
+
+		//Value indices as structure of arrays, value j of constraint c at [j*count+c]
+		blockvalues.resize(blockvalues.size() + block.arity * block.count);
+		int *index = &blockvalues[block.valuestart];
+		for(int c=0; c < block.count; c++)
+		{
+			const int *values = &constraintvalues[constraintstart[members[c]]];
+			for(int j=0; j < block.arity; j++)
+				index[j*block.count + c] = values[j];
+			blockconstraints.push_back(members[c]);
+		}
+		errorblocks.push_back(block);
+	}
+}
+
+void SolveImpl::GetErrors(double *errors)
+{
+	const double *v = values.data();
+	for(size_t b=0; b < errorblocks.size(); b++)
+	{
+		const errorBlock &block = errorblocks[b];
+		const int *index = &blockvalues[block.valuestart];
+		const int *members = &blockconstraints[block.constraintstart];
+		for(int start=0; start < block.count; start += BatchChunkSize)
+		{
+			int count = std::min(BatchChunkSize, block.count - start);
+			block.kernel(v, index + start, block.count, count, blockerrors.data());
+
+			for(int c=0; c < count; c++)
+				errors[members[start + c]] = blockerrors[c];
+		}
+	}
+
+	for(size_t i=0; i < singleconstraints.size(); i++)
+	{
+		errors[singleconstraints[i]] = GetError(singleconstraints[i]);
+	}
+}
+
+#pragma managed(pop)
@@ -13,262 +13,148 @@
 #include <cmath>
 #include <stdlib.h>
 #include <sstream>
+#include <algorithm>
+
+#pragma managed(push, off)
 
 using namespace std;
 
-void SolveImpl::LoadDouble(std::vector<std::pair<varLocation,void*> > &mylist, double *d, int c)
+//Static registration of all supported constraint types with their error function
+//and the values they depend on, in the order they are passed to the error function.
+static const constraintRegistration constraintRegistrations[] =
+{
+	{ tangentToEllipse,        EllipseTangentError,      2, { line1, ellipse1 } },
+	{ parallel,                ParallelError,            2, { line1, line2 } },
+	{ perpendicular,           PerpendicularError,       2, { line1, line2 } },
+	{ horizontal,              HorizontalError,          1, { line1 } },
+	{ vertical,                VerticalError,            1, { line1 } },
+	{ pointOnPoint,            PointOnPointError,        2, { point1, point2 } },
+	{ pointOnLineMidpoint,     PointOnLineMidpointError, 2, { line1, point1 } },
+	{ P2PDistance,             P2PDistanceError,         3, { point1, point2, parameter } },
+	{ pointOnCircle,           P2PDistanceError,         3, { point1, circle1_center, circle1_rad } },
+	{ pointOnArc,              P2PDistanceError,         3, { point1, arc1_center, arc1_rad } },
+	{ P2PDistanceVert,         P2PDistanceVertError,     3, { point1, point2, parameter } },
+	{ P2PDistanceHorz,         P2PDistanceHorzError,     3, { point1, point2, parameter } },
+	{ pointOnLine,             PointOnLineError,         2, { line1, point1 } },
+	{ P2LDistance,             P2LDistanceError,         3, { line1, point1, parameter } },
+	{ P2LDistanceHorz,         P2LDistanceHorzError,     3, { line1, point1, parameter } },
+	{ P2LDistanceVert,         P2LDistanceVertError,     3, { line1, point1, parameter } },
+	{ tangentToCircle,         P2LDistanceError,         3, { line1, circle1_center, circle1_rad } },
+	{ tangentToArc,            P2LDistanceError,         3, { line1, arc1_center, arc1_rad } },
+	{ tangentToArcStart,       LinePerpToAngleError,     2, { line1, arc1_startAngle } },
+	{ tangentToArcEnd,         LinePerpToAngleError,     2, { line1, arc1_endAngle } },
+	{ lineLength,              LineLengthError,          2, { line1, parameter } },
+	{ equalLength,             EqualLengthError,         2, { line1, line2 } },
+	{ arcRadius,               EqualScalarError,         2, { arc1_rad, parameter } },
+	{ circleRadius,            EqualScalarError,         2, { circle1_rad, parameter } },
+	{ equalRadiusArcs,         EqualScalarError,         2, { arc1_rad, arc2_rad } },
+	{ equalRadiusCircles,      EqualScalarError,         2, { circle1_rad, circle2_rad } },
+	{ equalRadiusCircArc,      EqualScalarError,         2, { arc1_rad, circle1_rad } },
+	{ concentricArcs,          PointOnPointError,        2, { arc1_center, arc2_center } },
+	{ concentricCircles,       PointOnPointError,        2, { circle1_center, circle2_center } },
+	{ concentricCircArc,       PointOnPointError,        2, { arc1_center, circle1_center } },
+	{ pointOnArcStart,         PointOnArcAngleError,     4, { point1, arc1_center, arc1_rad, arc1_startAngle } },
+	{ pointOnArcEnd,           PointOnArcAngleError,     4, { point1, arc1_center, arc1_rad, arc1_endAngle } },
+	{ arcEndToArcEnd,          ArcAngleOnArcAngleError,  6, { arc1_center, arc1_rad, arc1_endAngle, arc2_center, arc2_rad, arc2_endAngle } },
+	{ arcStartToArcEnd,        ArcAngleOnArcAngleError,  6, { arc1_center, arc1_rad, arc1_startAngle, arc2_center, arc2_rad, arc2_endAngle } },
+	{ arcStartToArcStart,      ArcAngleOnArcAngleError,  6, { arc1_center, arc1_rad, arc1_startAngle, arc2_center, arc2_rad, arc2_startAngle } },
+	{ colinear,                ColinearError,            2, { line1, line2 } },
+	{ pointHorizontalDistance, PointHorizontalDistanceError,2, { point1, parameter } },
+	{ pointVerticalDistance,   PointVerticalDistanceError,  2, { point1, parameter } },
+	{ internalAngle,           InternalAngleError,       3, { line1, line2, parameter } },
+	{ externalAngle,           ExternalAngleError,       3, { line1, line2, parameter } },
+};
+
+//Lookup table by constraint type, built once from the registrations above
+class constraintTable
 {
-	if(parms[d])
+	const constraintRegistration* entries[pointVerticalDistance+1];
+public:
+	constraintTable()
 	{
-		//many vars may already be in the vector, must check and remap
-		if(mapset.find(d) != mapset.end())
-		{
-			std::pair<varLocation,void*> tparm = mapparms[d];
-			mylist.push_back(tparm);
-			if(tparm.first == Vector)
-				vecmap[(size_t)tparm.second].push_back(c);
-			return;
-		}
+		for(int i=0; i <= pointVerticalDistance; i++)
+			entries[i] = 0;
+		for(size_t i=0; i < sizeof(constraintRegistrations)/sizeof(constraintRegistrations[0]); i++)
+			entries[constraintRegistrations[i].type] = &constraintRegistrations[i];
+	}
 
-		vecmap[next_vector].push_back(c);
-        std::pair<varLocation,void*> newloc(Vector,(void*)next_vector++);
-		mylist.push_back(newloc);
-		mapparms[d] = newloc;
-		mapset.insert(d);
-		myvec.push_back(d);
+	const constraintRegistration* operator[](constraintType type) const
+	{
+		if(type < 0 || type > pointVerticalDistance)
+			return 0;
+		return entries[type];
+	}
+};
+
+static const constraintTable registeredConstraints;
+
+const constraintRegistration* SolveImpl::GetRegistration(constraintType type)
+{
+	return registeredConstraints[type];
+}
+
+void SolveImpl::LoadDouble(double *d)
+{
+	std::unordered_map<double*,int>::iterator it = valueindex.find(d);
+	if(it == valueindex.end())
+	{
+		//Static value, will be placed behind the variables when loading is finished
+		int index = -(int)staticvec.size() - 1;
+		staticvec.push_back(d);
+		valueindex[d] = index;
+		constraintvalues.push_back(index);
 		return;
 	}
 
-	mylist.push_back(std::pair<varLocation,void*>(Static,d));
+	if(it->second == unusedVariable)
+	{
+		//First use of this variable
+		it->second = (int)myvec.size();
+		myvec.push_back(d);
+	}
+	constraintvalues.push_back(it->second);
 }
 
-void SolveImpl::LoadPoint(std::vector<std::pair<varLocation,void*> > &mylist, point p, int c)
+void SolveImpl::LoadPoint(const point &p)
 {
-	LoadDouble(mylist,p.x,c);
-	LoadDouble(mylist,p.y,c);
+	LoadDouble(p.x);
+	LoadDouble(p.y);
 }
 
-void SolveImpl::LoadLine(std::vector<std::pair<varLocation,void*> > &mylist,line l, int c)
+void SolveImpl::LoadLine(const line &l)
 {
-	LoadPoint(mylist,l.p1,c);
-	LoadPoint(mylist,l.p2,c);
+	LoadPoint(l.p1);
+	LoadPoint(l.p2);
 }
 
-void SolveImpl::LoadArc(std::vector<std::pair<varLocation,void*> > &mylist,arc a, int c)
+void SolveImpl::LoadArc(const arc &a)
 {
-	LoadPoint(mylist,a.center,c);
-	LoadDouble(mylist,a.startAngle,c);
-	LoadDouble(mylist,a.endAngle,c);
-	LoadDouble(mylist,a.rad,c);
+	LoadPoint(a.center);
+	LoadDouble(a.startAngle);
+	LoadDouble(a.endAngle);
+	LoadDouble(a.rad);
 }
 
-void SolveImpl::LoadCircle(std::vector<std::pair<varLocation,void*> > &mylist,circle c, int con)
+void SolveImpl::LoadCircle(const circle &c)
 {
-	LoadPoint(mylist,c.center,con);
-	LoadDouble(mylist,c.rad,con);
+	LoadPoint(c.center);
+	LoadDouble(c.rad);
 }
 
-void SolveImpl::LoadEllipse(std::vector<std::pair<varLocation,void*> > &mylist,ellipse e, int con)
+void SolveImpl::LoadEllipse(const ellipse &e)
 {
-	LoadPoint(mylist,e.center,con);
-	LoadDouble(mylist,e.radone,con);
-	LoadDouble(mylist,e.radtwo,con);
-	LoadDouble(mylist,e.rot,con);
+	LoadPoint(e.center);
+	LoadDouble(e.radone);
+	LoadDouble(e.radtwo);
+	LoadDouble(e.rot);
 }
 
 SolveImpl::SolveImpl()
 {
-	next_vector=0;
-	pvec.resize(50);
-
-	registerdependency(tangentToEllipse,line1);
-	registerdependency(tangentToEllipse,ellipse1);
-	registerconstraint(tangentToEllipse,EllipseTangentError);
-
-
-	registerdependency(parallel,line1);
-	registerdependency(parallel,line2);
-	registerconstraint(parallel,ParallelError);
-
-	registerdependency(perpendicular,line1);
-	registerdependency(perpendicular,line2);
-	registerconstraint(perpendicular,PerpendicularError);
-
-	registerdependency(horizontal,line1);
-	registerconstraint(horizontal,HorizontalError);
-
-	registerdependency(vertical,line1);
-	registerconstraint(vertical,VerticalError);
-
-	registerdependency(pointOnPoint,point1);
-	registerdependency(pointOnPoint,point2);
-	registerconstraint(pointOnPoint,PointOnPointError);
-
-	registerdependency(pointOnLineMidpoint,line1);
-	registerdependency(pointOnLineMidpoint,point1);
-	registerconstraint(pointOnLineMidpoint,PointOnLineMidpointError);
-
-
-	registerdependency(P2PDistance,point1);
-	registerdependency(P2PDistance,point2);
-	registerdependency(P2PDistance,parameter);
-	registerconstraint(P2PDistance,P2PDistanceError);
-
-	registerdependency(pointOnCircle,point1);
-	registerdependency(pointOnCircle,circle1_center);
-	registerdependency(pointOnCircle,circle1_rad);
-	registerconstraint(pointOnCircle,P2PDistanceError);
-
-	registerdependency(pointOnArc,point1);
-	registerdependency(pointOnArc,arc1_center);
-	registerdependency(pointOnArc,arc1_rad);
-	registerconstraint(pointOnArc,P2PDistanceError);
-
-	registerdependency(P2PDistanceVert,point1);
-	registerdependency(P2PDistanceVert,point2);
-	registerdependency(P2PDistanceVert,parameter);
-	registerconstraint(P2PDistanceVert,P2PDistanceVertError);
-
-	registerdependency(P2PDistanceHorz,point1);
-	registerdependency(P2PDistanceHorz,point2);
-	registerdependency(P2PDistanceHorz,parameter);
-	registerconstraint(P2PDistanceHorz,P2PDistanceHorzError);
-
-	registerdependency(pointOnLine,line1);
-	registerdependency(pointOnLine,point1);
-	registerconstraint(pointOnLine,PointOnLineError);
-
-	registerdependency(P2LDistance,line1);
-	registerdependency(P2LDistance,point1);
-	registerdependency(P2LDistance,parameter);
-	registerconstraint(P2LDistance,P2LDistanceError);
-
-	registerdependency(P2LDistanceHorz,line1);
-	registerdependency(P2LDistanceHorz,point1);
-	registerdependency(P2LDistanceHorz,parameter);
-	registerconstraint(P2LDistanceHorz,P2LDistanceHorzError);
-
-	registerdependency(P2LDistanceVert,line1);
-	registerdependency(P2LDistanceVert,point1);
-	registerdependency(P2LDistanceVert,parameter);
-	registerconstraint(P2LDistanceVert,P2LDistanceVertError);
-
-
-	registerdependency(tangentToCircle,line1);
-	registerdependency(tangentToCircle,circle1_center);
-	registerdependency(tangentToCircle,circle1_rad);
-	registerconstraint(tangentToCircle,P2LDistanceError);
-
-	registerdependency(tangentToArc,line1);
-	registerdependency(tangentToArc,arc1_center);
-	registerdependency(tangentToArc,arc1_rad);
-	registerconstraint(tangentToArc,P2LDistanceError);
-
-	registerdependency(tangentToArcStart,line1);
-	registerdependency(tangentToArcStart,arc1_startAngle);
-	registerconstraint(tangentToArcStart,LinePerpToAngleError);
-
-	registerdependency(tangentToArcEnd,line1);
-	registerdependency(tangentToArcEnd,arc1_endAngle);
-	registerconstraint(tangentToArcEnd,LinePerpToAngleError);
-	
-	registerdependency(lineLength,line1);
-	registerdependency(lineLength,parameter);
-	registerconstraint(lineLength,LineLengthError);
-
-	registerdependency(equalLength,line1);
-	registerdependency(equalLength,line2);
-	registerconstraint(equalLength,EqualLengthError);
-
-	registerdependency(arcRadius,arc1_rad);
-	registerdependency(arcRadius,parameter);
-	registerconstraint(arcRadius,EqualScalarError);
-
-	registerdependency(circleRadius,circle1_rad);
-	registerdependency(circleRadius,parameter);
-	registerconstraint(circleRadius,EqualScalarError);
-
-	registerdependency(equalRadiusArcs,arc1_rad);
-	registerdependency(equalRadiusArcs,arc2_rad);
-	registerconstraint(equalRadiusArcs,EqualScalarError);
-
-	registerdependency(equalRadiusCircles,circle1_rad);
-	registerdependency(equalRadiusCircles,circle2_rad);
-	registerconstraint(equalRadiusCircles,EqualScalarError);
-
-	registerdependency(equalRadiusCircArc,arc1_rad);
-	registerdependency(equalRadiusCircArc,circle1_rad);
-	registerconstraint(equalRadiusCircArc,EqualScalarError);
-
-	registerdependency(concentricArcs,arc1_center);
-	registerdependency(concentricArcs,arc2_center);
-	registerconstraint(concentricArcs,PointOnPointError);
-
-	registerdependency(concentricCircles,circle1_center);
-	registerdependency(concentricCircles,circle2_center);
-	registerconstraint(concentricCircles,PointOnPointError);
-
-	registerdependency(concentricCircArc,arc1_center);
-	registerdependency(concentricCircArc,circle1_center);
-	registerconstraint(concentricCircArc,PointOnPointError);
-
-	registerdependency(pointOnArcStart,point1);
-	registerdependency(pointOnArcStart,arc1_center);
-	registerdependency(pointOnArcStart,arc1_rad);
-	registerdependency(pointOnArcStart,arc1_startAngle);
-	registerconstraint(pointOnArcStart,PointOnArcAngleError);
-
-	registerdependency(pointOnArcEnd,point1);
-	registerdependency(pointOnArcEnd,arc1_center);
-	registerdependency(pointOnArcEnd,arc1_rad);
-	registerdependency(pointOnArcEnd,arc1_endAngle);
-	registerconstraint(pointOnArcEnd,PointOnArcAngleError);
-	
-	registerdependency(arcEndToArcEnd,arc1_center);
-	registerdependency(arcEndToArcEnd,arc1_rad);
-	registerdependency(arcEndToArcEnd,arc1_endAngle);
-	registerdependency(arcEndToArcEnd,arc2_center);
-	registerdependency(arcEndToArcEnd,arc2_rad);
-	registerdependency(arcEndToArcEnd,arc2_endAngle);
-	registerconstraint(arcEndToArcEnd,ArcAngleOnArcAngleError);
-
-	registerdependency(arcStartToArcEnd,arc1_center);
-	registerdependency(arcStartToArcEnd,arc1_rad);
-	registerdependency(arcStartToArcEnd,arc1_startAngle);
-	registerdependency(arcStartToArcEnd,arc2_center);
-	registerdependency(arcStartToArcEnd,arc2_rad);
-	registerdependency(arcStartToArcEnd,arc2_endAngle);
-	registerconstraint(arcStartToArcEnd,ArcAngleOnArcAngleError);	
-
-	registerdependency(arcStartToArcStart,arc1_center);
-	registerdependency(arcStartToArcStart,arc1_rad);
-	registerdependency(arcStartToArcStart,arc1_startAngle);
-	registerdependency(arcStartToArcStart,arc2_center);
-	registerdependency(arcStartToArcStart,arc2_rad);
-	registerdependency(arcStartToArcStart,arc2_startAngle);
-	registerconstraint(arcStartToArcStart,ArcAngleOnArcAngleError);	
-
-	registerdependency(colinear,line1);
-	registerdependency(colinear,line2);
-	registerconstraint(colinear,ColinearError);
-
-	registerdependency(pointHorizontalDistance,point1);
-	registerdependency(pointHorizontalDistance,parameter);
-	registerconstraint(pointHorizontalDistance,PointHorizontalDistanceError);
-
-	registerdependency(pointVerticalDistance,point1);
-	registerdependency(pointVerticalDistance,parameter);
-	registerconstraint(pointVerticalDistance,PointVerticalDistanceError);
-
-	registerdependency(internalAngle,line1);
-	registerdependency(internalAngle,line2);
-	registerdependency(internalAngle,parameter);
-	registerconstraint(internalAngle,InternalAngleError);
-
-	registerdependency(externalAngle,line1);
-	registerdependency(externalAngle,line2);
-	registerdependency(externalAngle,parameter);
-	registerconstraint(externalAngle,ExternalAngleError);
+	variablecount = 0;
+	batchevaluation = true;
+	functionevaluations = 0;
+	gradientevaluations = 0;
 }
 
 SolveImpl::~SolveImpl()
@@ -277,53 +163,237 @@ SolveImpl::~SolveImpl()
 
 void SolveImpl::Load(constraint *c, int nconstraints, double** p, int nparms)
 {
-	constraintvars.clear();
+	values.clear();
 	myvec.clear();
-	constrainttypes.clear();
-	mapparms.clear();
-	mapset.clear();
-	next_vector=0;
-	parms.clear();
-	vecmap.clear();
+	staticvec.clear();
+	valueindex.clear();
+	constraintindex.clear();
+	constrainterrors.clear();
+	constraintstart.clear();
+	constraintvalues.clear();
+	variablestart.clear();
+	variableconstraints.clear();
+
+	constraintstart.reserve(nconstraints + 1);
+	constraintindex.reserve(nconstraints);
+	constrainterrors.reserve(nconstraints);
+	constraintstart.push_back(0);
 
 	for(int i=0; i < nparms; i++)
 	{
-		parms[p[i]] = 1;
+		valueindex[p[i]] = unusedVariable;
 	}
 
 	for(int i=0; i < nconstraints; i++)
 	{
-		Load(c[i]);
+		if(Load(c[i]))
+			constraintindex.push_back(i);
 	}
+
+	//Place all values in one contiguous array, variables first
+	variablecount = (int)myvec.size();
+	values.resize(myvec.size() + staticvec.size());
+	for(size_t i=0; i < myvec.size(); i++)
+		values[i] = *myvec[i];
+	for(size_t i=0; i < staticvec.size(); i++)
+		values[myvec.size() + i] = *staticvec[i];
+	for(size_t i=0; i < constraintvalues.size(); i++)
+	{
+		if(constraintvalues[i] < 0)
+			constraintvalues[i] = variablecount - constraintvalues[i] - 1;
+	}
+
+	//Build the list of constraints depending on each variable
+	variablestart.assign(variablecount + 1, 0);
+	int nloaded = (int)constrainterrors.size();
+	for(int i=0; i < nloaded; i++)
+	{
+		for(int j=constraintstart[i]; j < constraintstart[i+1]; j++)
+		{
+			int v = constraintvalues[j];
+			if(v < variablecount && !DependsOnBefore(i, j))
+				variablestart[v+1]++;
+		}
+	}
+	for(int i=0; i < variablecount; i++)
+		variablestart[i+1] += variablestart[i];
+
+	variableconstraints.resize(variablestart[variablecount]);
+	std::vector<int> fill(variablestart.begin(), variablestart.end() - 1);
+	for(int i=0; i < nloaded; i++)
+	{
+		for(int j=constraintstart[i]; j < constraintstart[i+1]; j++)
+		{
+			int v = constraintvalues[j];
+			if(v < variablecount && !DependsOnBefore(i, j))
+				variableconstraints[fill[v]++] = i;
+		}
+	}
+
+	LoadBlocks();
+}
+
+bool SolveImpl::DependsOnBefore(int i, int j) const
+{
+	//Check if the value at slot j has already been referenced by constraint i
+	for(int k=constraintstart[i]; k < j; k++)
+	{
+		if(constraintvalues[k] == constraintvalues[j])
+			return true;
+	}
+	return false;
 }
 
 double SolveImpl::GetErrorForGrad(int i)
 {
 	double error = 0;
-	for(unsigned int j = 0; j < vecmap[i].size(); j++)
+	for(int j = variablestart[i]; j < variablestart[i+1]; j++)
 	{
-		int cindex = (int)vecmap[i][j];
-		error += GetError(cindex);
+		error += GetError(variableconstraints[j]);
 	}
 	return error;
 }
 
 double SolveImpl::GetGradient(int i, double pert)
 {
-	double OldValue = GetElement(i);
-	SetElement(i,OldValue-pert);
+	double OldValue = values[i];
+	values[i] = OldValue-pert;
 	double e1 = GetErrorForGrad(i);
-	SetElement(i,OldValue+pert);
+	values[i] = OldValue+pert;
 	double e2 = GetErrorForGrad(i);
-	SetElement(i,OldValue);
+	values[i] = OldValue;
 	return .5*(e2-e1)/pert;
 }
 
+void SolveImpl::GetGradient(double *gradient, double pert)
+{
+	for(int i=0; i < variablecount; i++)
+	{
+		gradient[i] = GetGradient(i, pert);
+	}
+	gradientevaluations++;
+}
+
+double SolveImpl::GetResiduals(std::vector<double> &residuals)
+{
+	//The error functions return squared values, the residual is their square root
+	double f = 0;
+	if(batchevaluation)
+		GetErrors(errors.data());
+	for(size_t i=0; i < residuals.size(); i++)
+	{
+		double e = batchevaluation ? errors[i] : GetError((int)i);
+		residuals[i] = sqrt(std::max(e, 0.0));
+		f += e;
+	}
+	functionevaluations++;
+	return f;
+}
+
+void SolveImpl::GetJacobianStructure(std::vector<int> &rowstart, std::vector<int> &columns) const
+{
+	//One row per constraint, one column per distinct variable it depends on
+	int nconstraints = (int)constrainterrors.size();
+	rowstart.assign(nconstraints+1, 0);
+	columns.clear();
+	for(int i=0; i < nconstraints; i++)
+	{
+		for(int j=constraintstart[i]; j < constraintstart[i+1]; j++)
+		{
+			int v = constraintvalues[j];
+			if(v < variablecount && !DependsOnBefore(i, j))
+				columns.push_back(v);
+		}
+		rowstart[i+1] = (int)columns.size();
+	}
+}
+
+//Change of the signed residual over a perturbation, given its magnitude at the base and at both sides.
+//If the residual keeps its sign the change is half the difference. If it crosses zero, the magnitudes
+//on both sides add up to the change, and the side with the larger magnitude is the positive one.
+static double ResidualChange(double r0, double rm, double rp)
+{
+	double d = .5*(rp-rm);
+	if(std::fabs(d) < r0)
+		return d;
+	return rp >= rm ? .5*(rp+rm) : -.5*(rp+rm);
+}
+
+double SolveImpl::GetResidualChange(int i, int v, double pert, double r0)
+{
+	double OldValue = values[v];
+	values[v] = OldValue-pert;
+	double rm = std::sqrt(std::max(GetError(i), 0.0));
+	values[v] = OldValue+pert;
+	double rp = std::sqrt(std::max(GetError(i), 0.0));
+	values[v] = OldValue;
+	return ResidualChange(r0, rm, rp);
+}
+
+void SolveImpl::GetJacobian(const std::vector<int> &rowstart, const std::vector<int> &columns, const std::vector<double> &residuals, std::vector<double> &jacobian)
+{
+	//The residual of a constraint is the square root of its error, the derivatives are taken from the
+	//residual itself. At a satisfied constraint the sign of the residual is lost, so the signs of a row
+	//are taken again next to it, on the positive side of the variable changing the residual most.
+	jacobian.resize(columns.size());
+	gradientevaluations++;
+	int nconstraints = (int)constrainterrors.size();
+	for(int i=0; i < nconstraints; i++)
+	{
+		double r0 = residuals[i];
+		int pivot = -1;
+		double pivotchange = 0;
+		for(int j=rowstart[i]; j < rowstart[i+1]; j++)
+		{
+			int v = columns[j];
+			double pert = JacobianPert * std::max(1.0, std::fabs(values[v]));
+			double change = GetResidualChange(i, v, pert, r0);
+			jacobian[j] = change/pert;
+			if(std::fabs(change) > std::fabs(pivotchange))
+			{
+				pivot = j;
+				pivotchange = change;
+			}
+		}
+
+		if(pivot < 0 || std::fabs(pivotchange) < r0)
+			continue;
+
+		int pv = columns[pivot];
+		double OldValue = values[pv];
+		double pivotpert = JacobianPert * std::max(1.0, std::fabs(OldValue));
+		double direction = pivotchange > 0 ? 1 : -1;
+		values[pv] = OldValue + direction*pivotpert;
+		double r1 = std::sqrt(std::max(GetError(i), 0.0));
+		for(int j=rowstart[i]; j < rowstart[i+1]; j++)
+		{
+			int v = columns[j];
+			if(v == pv)
+				continue;
+			double pert = JacobianPert * std::max(1.0, std::fabs(values[v]));
+			jacobian[j] = GetResidualChange(i, v, pert, r1)/pert;
+		}
+		values[pv] = OldValue;
+	}
+}
+
 double SolveImpl::GetError()
 {
+	functionevaluations++;
 	double error = 0;
+	int nconstraints = (int)constrainterrors.size();
+	if(batchevaluation)
+	{
+		//Summed in constraint order, the result is the same as evaluating one by one
+		GetErrors(errors.data());
+		for(int i=0; i < nconstraints; i++)
+		{
+			error += errors[i];
+		}
+		return error;
+	}
 
-	for(unsigned int i=0; i < constrainttypes.size(); i++)
+	for(int i=0; i < nconstraints; i++)
 	{
 		error += GetError(i);
 	}
@@ -332,131 +402,175 @@ double SolveImpl::GetError()
 
 double SolveImpl::GetError(int i)
 {
-	int count=0;
-	std::vector<std::pair<varLocation,void*> > tlist = constraintvars[i];
-	std::vector<std::pair<varLocation,void*> >::iterator it3;
-	for(it3 = tlist.begin(); it3 != tlist.end(); ++it3)
+	double parms[MaxConstraintValues];
+	const int *index = &constraintvalues[constraintstart[i]];
+	int count = constraintstart[i+1] - constraintstart[i];
+	const double *v = values.data();
+	for(int j=0; j < count; j++)
 	{
-		std::pair<varLocation,void*> tvar = *it3;
-		if(tvar.first == Vector)
-			pvec[count++]=GetElement((size_t)tvar.second);
-		else
-			pvec[count++] = *((double*)tvar.second);
+		parms[j] = v[index[j]];
 	}
-	return errors[constrainttypes[i]](pvec);
+	return constrainterrors[i](parms);
 }
 
-void SolveImpl::Load(constraint &c)
+bool SolveImpl::Load(const constraint &c)
 {
-	std::vector<std::pair<varLocation,void*> > mylist;
-	std::vector<dependencyType>::iterator it;
-	int count = (int)constrainttypes.size();
-	for(unsigned int i = 0; i < dependencies[c.type].size(); i++)
+	const constraintRegistration *registration = GetRegistration(c.type);
+	if(registration == 0)
+		return false;
+
+	for(int i = 0; i < registration->dependencyCount; i++)
 	{
-		switch(dependencies[c.type][i])
+		switch(registration->dependencies[i])
 		{
-			case line1: LoadLine(mylist,c.line1,count); break;
-			case line1_p1: LoadPoint(mylist,c.line1.p1,count); break;
-			case line1_p1_x: LoadDouble(mylist,c.line1.p1.x,count); break;
-			case line1_p1_y: LoadDouble(mylist,c.line1.p1.y,count); break;
-			case line1_p2: LoadPoint(mylist,c.line2.p2,count); break;
-			case line1_p2_x: LoadDouble(mylist,c.line1.p2.x,count); break;
-			case line1_p2_y: LoadDouble(mylist,c.line1.p2.y,count); break;
-			case line2: LoadLine(mylist,c.line2,count); break;
-			case line2_p1: LoadPoint(mylist,c.line2.p1,count); break;
-			case line2_p1_x: LoadDouble(mylist,c.line2.p1.x,count); break;
-			case line2_p1_y: LoadDouble(mylist,c.line2.p1.y,count); break;
-			case line2_p2: LoadPoint(mylist,c.line2.p2,count); break;
-			case line2_p2_x: LoadDouble(mylist,c.line2.p2.x,count); break;
-			case line2_p2_y: LoadDouble(mylist,c.line2.p2.y,count); break;
-			case point1: LoadPoint(mylist,c.point1,count); break;
-			case point2: LoadPoint(mylist,c.point2,count); break;
-			case parameter: LoadDouble(mylist,c.parameter,count); break;
-			case arc1: LoadArc(mylist,c.arc1,count); break;
-			case arc1_rad: LoadDouble(mylist,c.arc1.rad,count); break;
-			case arc1_startAngle: LoadDouble(mylist,c.arc1.startAngle,count); break;
-			case arc1_endAngle: LoadDouble(mylist,c.arc1.endAngle,count); break;
-			case arc1_center: LoadPoint(mylist,c.arc1.center,count); break;
-			case arc1_center_x: LoadDouble(mylist,c.arc1.center.x,count); break;
-			case arc1_center_y: LoadDouble(mylist,c.arc1.center.y,count); break;
-			case arc2: LoadArc(mylist,c.arc2,count); break;
-			case arc2_rad: LoadDouble(mylist,c.arc2.rad,count); break;
-			case arc2_startAngle: LoadDouble(mylist,c.arc2.startAngle,count); break;
-			case arc2_endAngle: LoadDouble(mylist,c.arc2.endAngle,count); break;
-			case arc2_center: LoadPoint(mylist,c.arc2.center,count); break;
-			case arc2_center_x: LoadDouble(mylist,c.arc2.center.x,count); break;
-			case arc2_center_y: LoadDouble(mylist,c.arc2.center.y,count); break;
-			case circle1: LoadCircle(mylist,c.circle1,count); break;
-			case circle1_rad: LoadDouble(mylist,c.circle1.rad,count); break;
-			case circle1_center: LoadPoint(mylist,c.circle1.center,count); break;
-			case circle1_center_x: LoadDouble(mylist,c.circle1.center.x,count); break;
-			case circle1_center_y: LoadDouble(mylist,c.circle1.center.y,count); break;
-			case circle2: LoadCircle(mylist,c.circle2,count); break;
-			case circle2_rad: LoadDouble(mylist,c.circle2.rad,count); break;
-			case circle2_center: LoadPoint(mylist,c.circle2.center,count); break;
-			case circle2_center_x: LoadDouble(mylist,c.circle2.center.x,count); break;
-			case circle2_center_y: LoadDouble(mylist,c.circle2.center.y,count); break;
-			case ellipse1: LoadEllipse(mylist,c.ellipse1,count); break;
-			case ellipse2: LoadEllipse(mylist,c.ellipse2,count); break;
-			case ellipse1_center: LoadPoint(mylist,c.ellipse1.center,count); break;
-			case ellipse2_center: LoadPoint(mylist,c.ellipse2.center,count); break;
-			case ellipse1_center_x: LoadDouble(mylist,c.ellipse1.center.x,count); break;
-			case ellipse1_center_y: LoadDouble(mylist,c.ellipse1.center.y,count); break;
-			case ellipse2_center_x: LoadDouble(mylist,c.ellipse2.center.x,count); break;
-			case ellipse2_center_y: LoadDouble(mylist,c.ellipse2.center.y,count); break;
-			case ellipse1_rad1: LoadDouble(mylist,c.ellipse1.radone,count); break;
-			case ellipse1_rad2: LoadDouble(mylist,c.ellipse1.radtwo,count); break;
-			case ellipse1_rot: LoadDouble(mylist,c.ellipse1.rot,count); break;
-			case ellipse2_rad1: LoadDouble(mylist,c.ellipse2.radone,count); break;
-			case ellipse2_rad2: LoadDouble(mylist,c.ellipse2.radtwo,count); break;
-			case ellipse2_rot: LoadDouble(mylist,c.ellipse2.rot,count); break;
+			case line1: LoadLine(c.line1); break;
+			case line1_p1: LoadPoint(c.line1.p1); break;
+			case line1_p1_x: LoadDouble(c.line1.p1.x); break;
+			case line1_p1_y: LoadDouble(c.line1.p1.y); break;
+			case line1_p2: LoadPoint(c.line2.p2); break;
+			case line1_p2_x: LoadDouble(c.line1.p2.x); break;
+			case line1_p2_y: LoadDouble(c.line1.p2.y); break;
+			case line2: LoadLine(c.line2); break;
+			case line2_p1: LoadPoint(c.line2.p1); break;
+			case line2_p1_x: LoadDouble(c.line2.p1.x); break;
+			case line2_p1_y: LoadDouble(c.line2.p1.y); break;
+			case line2_p2: LoadPoint(c.line2.p2); break;
+			case line2_p2_x: LoadDouble(c.line2.p2.x); break;
+			case line2_p2_y: LoadDouble(c.line2.p2.y); break;
+			case point1: LoadPoint(c.point1); break;
+			case point2: LoadPoint(c.point2); break;
+			case parameter: LoadDouble(c.parameter); break;
+			case arc1: LoadArc(c.arc1); break;
+			case arc1_rad: LoadDouble(c.arc1.rad); break;
+			case arc1_startAngle: LoadDouble(c.arc1.startAngle); break;
+			case arc1_endAngle: LoadDouble(c.arc1.endAngle); break;
+			case arc1_center: LoadPoint(c.arc1.center); break;
+			case arc1_center_x: LoadDouble(c.arc1.center.x); break;
+			case arc1_center_y: LoadDouble(c.arc1.center.y); break;
+			case arc2: LoadArc(c.arc2); break;
+			case arc2_rad: LoadDouble(c.arc2.rad); break;
+			case arc2_startAngle: LoadDouble(c.arc2.startAngle); break;
+			case arc2_endAngle: LoadDouble(c.arc2.endAngle); break;
+			case arc2_center: LoadPoint(c.arc2.center); break;
+			case arc2_center_x: LoadDouble(c.arc2.center.x); break;
+			case arc2_center_y: LoadDouble(c.arc2.center.y); break;
+			case circle1: LoadCircle(c.circle1); break;
+			case circle1_rad: LoadDouble(c.circle1.rad); break;
+			case circle1_center: LoadPoint(c.circle1.center); break;
+			case circle1_center_x: LoadDouble(c.circle1.center.x); break;
+			case circle1_center_y: LoadDouble(c.circle1.center.y); break;
+			case circle2: LoadCircle(c.circle2); break;
+			case circle2_rad: LoadDouble(c.circle2.rad); break;
+			case circle2_center: LoadPoint(c.circle2.center); break;
+			case circle2_center_x: LoadDouble(c.circle2.center.x); break;
+			case circle2_center_y: LoadDouble(c.circle2.center.y); break;
+			case ellipse1: LoadEllipse(c.ellipse1); break;
+			case ellipse2: LoadEllipse(c.ellipse2); break;
+			case ellipse1_center: LoadPoint(c.ellipse1.center); break;
+			case ellipse2_center: LoadPoint(c.ellipse2.center); break;
+			case ellipse1_center_x: LoadDouble(c.ellipse1.center.x); break;
+			case ellipse1_center_y: LoadDouble(c.ellipse1.center.y); break;
+			case ellipse2_center_x: LoadDouble(c.ellipse2.center.x); break;
+			case ellipse2_center_y: LoadDouble(c.ellipse2.center.y); break;
+			case ellipse1_rad1: LoadDouble(c.ellipse1.radone); break;
+			case ellipse1_rad2: LoadDouble(c.ellipse1.radtwo); break;
+			case ellipse1_rot: LoadDouble(c.ellipse1.rot); break;
+			case ellipse2_rad1: LoadDouble(c.ellipse2.radone); break;
+			case ellipse2_rad2: LoadDouble(c.ellipse2.radtwo); break;
+			case ellipse2_rot: LoadDouble(c.ellipse2.rot); break;
 		}
 	}
-	constraintvars.push_back(mylist);
-	constrainttypes.push_back(c.type);
+	constraintstart.push_back((int)constraintvalues.size());
+	constrainterrors.push_back(registration->error);
+	return true;
 }
 
-void SolveImpl::Unload()
+void SolveImpl::GetComponents(constraint* c, std::vector<SolveComponent> &components) const
 {
-	//For every item in mapparms, copy variable from vector into pointer
-	std::map<double*,std::pair<varLocation,void*> >::iterator it;
-	for(it = mapparms.begin(); it != mapparms.end(); ++it)
-	{
-		std::pair<varLocation, void*> parm = (*it).second;
-		double* location = (*it).first;
+	//Walk the constraint graph, two constraints are connected if they share a vector variable
+	int nconstraints = (int)constrainterrors.size();
+	std::vector<int> componentOfConstraint(nconstraints, -1);
+	std::vector<bool> visitedVars(variablecount, false);
+	std::vector<int> stack;
+	int staticComponent = -1;
 
-		if(parm.first != Vector)
+	for(int i=0; i < nconstraints; i++)
+	{
+		if(componentOfConstraint[i] >= 0)
 			continue;
 
-		*location = GetElement((size_t)parm.second);
-	}
-}
+		int componentIndex = (int)components.size();
+		components.push_back(SolveComponent());
+		SolveComponent &component = components.back();
 
-void SolveImpl::registerconstraint(constraintType type,double(*error)(std::vector<double>&))
-{
-	if(errors.size() < (unsigned int)type + 1)
-		errors.resize((unsigned int)type+1);
-	errors[type] = error;
+		stack.push_back(i);
+		componentOfConstraint[i] = componentIndex;
+		while(!stack.empty())
+		{
+			int cindex = stack.back();
+			stack.pop_back();
+			component.constraints.push_back(c[constraintindex[cindex]]);
+
+			for(int j=constraintstart[cindex]; j < constraintstart[cindex+1]; j++)
+			{
+				int vindex = constraintvalues[j];
+				if(vindex >= variablecount || visitedVars[vindex])
+					continue;
+				visitedVars[vindex] = true;
+				component.parameters.push_back(myvec[vindex]);
+
+				for(int k=variablestart[vindex]; k < variablestart[vindex+1]; k++)
+				{
+					int next = variableconstraints[k];
+					if(componentOfConstraint[next] >= 0)
+						continue;
+					componentOfConstraint[next] = componentIndex;
+					stack.push_back(next);
+				}
+			}
+		}
+
+		//Constraints without any variable are collected in one component
+		if(component.parameters.empty())
+		{
+			if(staticComponent >= 0)
+			{
+				components[staticComponent].constraints.push_back(component.constraints[0]);
+				components.pop_back();
+			}
+			else
+			{
+				staticComponent = componentIndex;
+			}
+		}
+	}
 }
 
-void SolveImpl::registerdependency(constraintType type, dependencyType d)
+void SolveImpl::Unload()
 {
-	if(depset.find(type) == depset.end())
+	//Copy variables from vector into pointer
+	for(int i=0; i < variablecount; i++)
 	{
-		if(dependencies.size() < (unsigned int)type + 1)
-			dependencies.resize((unsigned int)type+1);
-		depset.insert(type);
+		*myvec[i] = values[i];
 	}
-	dependencies[type].push_back(d);
 }
 
-double SolveImpl::GetInitialValue(int i)
+void SolveImpl::Reload()
 {
-	return *myvec[i];
+	//Take over values which have been changed by the caller since loading
+	for(int i=0; i < variablecount; i++)
+	{
+		values[i] = *myvec[i];
+	}
+	for(size_t i=0; i < staticvec.size(); i++)
+	{
+		values[variablecount + i] = *staticvec[i];
+	}
 }
 
 int SolveImpl::GetVectorSize() const
 {
-	return (int)myvec.size();
+	return variablecount;
 }
 
+#pragma managed(pop)
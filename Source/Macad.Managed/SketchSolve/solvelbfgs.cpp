@@ -0,0 +1,215 @@
+/*
+ * solvelbfgs.cpp
+ *
+ *  Limited-memory BFGS solver, the inverse Hessian is represented by the last correction pairs only.
+ *      This program is released under the BSD license. See the file License.txt for details.
+ *
+ */
+
+#include "solve.h"
+#include <cmath>
+#include <algorithm>
+
+#pragma managed(push, off)
+
+using namespace std;
+
+void Solver::directionLBFGS(const std::vector<double> &gradient, std::vector<double> &direction)
+{
+	//Two-loop recursion over the stored correction pairs, newest first
+	int n = GetVectorSize();
+	direction = gradient;
+	for(int k=0; k < historyCount; k++)
+	{
+		int h = (historyNext - 1 - k + historyLength) % historyLength;
+		const double *deltaX = &historyDeltaX[h*n];
+		const double *gamma = &historyGamma[h*n];
+		double alpha = 0;
+		for(int i=0; i < n; i++)
+			alpha += deltaX[i] * direction[i];
+		alpha *= historyRho[h];
+		historyAlpha[h] = alpha;
+		for(int i=0; i < n; i++)
+			direction[i] -= alpha * gamma[i];
+	}
+
+	//Scale the initial inverse Hessian estimate by the newest pair
+	if(historyCount > 0)
+	{
+		int h = (historyNext - 1 + historyLength) % historyLength;
+		const double *gamma = &historyGamma[h*n];
+		double gammatGamma = 0;
+		for(int i=0; i < n; i++)
+			gammatGamma += gamma[i] * gamma[i];
+		double scale = 1 / (historyRho[h] * gammatGamma);
+		for(int i=0; i < n; i++)
+			direction[i] *= scale;
+	}
+
+	for(int k=historyCount-1; k >= 0; k--)
+	{
+		int h = (historyNext - 1 - k + historyLength) % historyLength;
+		const double *deltaX = &historyDeltaX[h*n];
+		const double *gamma = &historyGamma[h*n];
+		double beta = 0;
+		for(int i=0; i < n; i++)
+			beta += gamma[i] * direction[i];
+		beta *= historyRho[h];
+		for(int i=0; i < n; i++)
+			direction[i] += deltaX[i] * (historyAlpha[h] - beta);
+	}
+
+	for(int i=0; i < n; i++)
+		direction[i] = -direction[i];
+}
+
+double Solver::lineSearch(const std::vector<double> &xold, const std::vector<double> &direction, double f0)
+{
+	//Bracket the minimum by the triplet f1>f2<f3 and take the minimum of the quadratic approximation
+	int n = GetVectorSize();
+	double alpha1 = 0, alpha2 = 1, alpha3 = 2;
+	double f1 = f0, f2, f3;
+
+	for(int i=0; i < n; i++)
+		x[i] = xold[i] + alpha2 * direction[i];
+	f2 = GetError();
+	for(int i=0; i < n; i++)
+		x[i] = xold[i] + alpha3 * direction[i];
+	f3 = GetError();
+
+	int steps = 0;
+	while((f2 > f1 || f2 > f3) && steps < MaxIterations)
+	{
+		if(f2 > f1)
+		{
+			alpha3 = alpha2;
+			f3 = f2;
+			alpha2 = alpha2 / 2;
+			for(int i=0; i < n; i++)
+				x[i] = xold[i] + alpha2 * direction[i];
+			f2 = GetError();
+		}
+		else
+		{
+			alpha2 = alpha3;
+			f2 = f3;
+			alpha3 = alpha3 * 2;
+			for(int i=0; i < n; i++)
+				x[i] = xold[i] + alpha3 * direction[i];
+			f3 = GetError();
+		}
+		steps++;
+	}
+
+	double alphaStar = alpha2 + ((alpha2 - alpha1) * (f1 - f3)) / (3 * (f1 - 2 * f2 + f3));
+	if(alphaStar >= alpha3 || alphaStar <= alpha1)
+		alphaStar = alpha2;
+	if(alphaStar != alphaStar)
+		alphaStar = 0;
+
+	for(int i=0; i < n; i++)
+		x[i] = xold[i] + alphaStar * direction[i];
+	return GetError();
+}
+
+int Solver::solveLBFGS(int isFine, bool warmStart)
+{
+	int n = GetVectorSize();
+	x = GetVector();
+
+	double convergence = isFine > 0 ? XconvergenceFine : XconvergenceRough;
+	double validSolution = isFine > 0 ? validSolutionFine : validSoltuionRough;
+
+	//A warm start continues with the correction pairs of the last solve
+	if(!(warmStart && hessianValid) || historyDeltaX.size() != (size_t)historyLength * n)
+	{
+		historyDeltaX.assign((size_t)historyLength * n, 0.0);
+		historyGamma.assign((size_t)historyLength * n, 0.0);
+		historyRho.assign(historyLength, 0.0);
+		historyCount = 0;
+		historyNext = 0;
+	}
+	historyAlpha.resize(historyLength);
+
+	std::vector<double> origSolution(x, x + n);
+	std::vector<double> xold(n);
+	std::vector<double> grad(n);
+	std::vector<double> gradnew(n);
+	std::vector<double> direction(n);
+	std::vector<double> deltaX(n);
+	std::vector<double> gamma(n);
+
+	double f = GetError();
+	statistics.residual = sqrt(f);
+	if(f < smallF)
+		return succsess;
+
+	double pert = std::min(std::max(f * pertMag, pertMin), LBFGSPertMax);
+	GetGradient(grad.data(), pert);
+
+	int iterations = 0;
+	double deltaXnorm = convergence + 1;
+	double maxIterNumber = MaxIterations * n;
+	while(deltaXnorm > convergence && f > smallF && iterations < maxIterNumber)
+	{
+		directionLBFGS(grad, direction);
+
+		//Fall back to steepest descent if the approximation does not lead downhill
+		double slope = 0;
+		for(int i=0; i < n; i++)
+			slope += direction[i] * grad[i];
+		if(!(slope < 0))
+		{
+			historyCount = 0;
+			for(int i=0; i < n; i++)
+				direction[i] = -grad[i];
+		}
+
+		for(int i=0; i < n; i++)
+			xold[i] = x[i];
+		f = lineSearch(xold, direction, f);
+
+		pert = std::min(std::max(f * pertMag, pertMin), LBFGSPertMax);
+		GetGradient(gradnew.data(), pert);
+
+		//Store the new correction pair, unless it violates the curvature condition. It is built aside,
+		//a rejected pair must not overwrite the oldest pair still in use.
+		double deltaXtDotGamma = 0;
+		deltaXnorm = 0;
+		for(int i=0; i < n; i++)
+		{
+			deltaX[i] = x[i] - xold[i];
+			gamma[i] = gradnew[i] - grad[i];
+			deltaXtDotGamma += deltaX[i] * gamma[i];
+			deltaXnorm += deltaX[i] * deltaX[i];
+			grad[i] = gradnew[i];
+		}
+		deltaXnorm = sqrt(deltaXnorm);
+		if(deltaXtDotGamma > 0)
+		{
+			std::copy(deltaX.begin(), deltaX.end(), historyDeltaX.begin() + (size_t)historyNext * n);
+			std::copy(gamma.begin(), gamma.end(), historyGamma.begin() + (size_t)historyNext * n);
+			historyRho[historyNext] = 1 / deltaXtDotGamma;
+			historyNext = (historyNext + 1) % historyLength;
+			historyCount = std::min(historyCount + 1, historyLength);
+		}
+		iterations++;
+	}
+
+	statistics.iterations = iterations;
+	statistics.residual = sqrt(f);
+	if(f < validSolution)
+	{
+		hessianValid = true;
+		return succsess;
+	}
+
+	hessianValid = false;
+
+	//Replace the bad numbers with the last result
+	for(int i=0; i < n; i++)
+		x[i] = origSolution[i];
+	return noSolution;
+}
+
+#pragma managed(pop)
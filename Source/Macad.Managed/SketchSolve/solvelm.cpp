@@ -0,0 +1,290 @@
+/*
+ * solvelm.cpp
+ *
+ *  Levenberg-Marquardt least squares solver using a sparse Jacobian of the constraint residuals.
+ *      This program is released under the BSD license. See the file License.txt for details.
+ *
+ */
+
+#include "solve.h"
+#include <cmath>
+#include <algorithm>
+
+#pragma managed(push, off)
+
+using namespace std;
+
+///////////////////////////////////////
+/// Sparse LDL' factorization
+///////////////////////////////////////
+
+void SparseLDL::Analyze(int size)
+{
+	//Elimination tree and column counts of L, computed once for the pattern in colstart/rows
+	n = size;
+	parent.assign(n, -1);
+	lnz.assign(n, 0);
+	flag.assign(n, 0);
+	pattern.assign(n, 0);
+	lp.assign(n+1, 0);
+	d.assign(n, 0);
+	y.assign(n, 0);
+
+	for(int k=0; k < n; k++)
+	{
+		flag[k] = k;
+		for(int p=colstart[k]; p < colstart[k+1]; p++)
+		{
+			int i = rows[p];
+			for(; i < k && flag[i] != k; i = parent[i])
+			{
+				if(parent[i] == -1)
+					parent[i] = k;
+				lnz[i]++;
+				flag[i] = k;
+			}
+		}
+	}
+	for(int k=0; k < n; k++)
+		lp[k+1] = lp[k] + lnz[k];
+
+	li.resize(lp[n]);
+	lx.resize(lp[n]);
+}
+
+bool SparseLDL::Factorize()
+{
+	//Up-looking factorization, row k of L is the solution of a sparse triangular system
+	for(int k=0; k < n; k++)
+	{
+		y[k] = 0;
+		int top = n;
+		flag[k] = k;
+		lnz[k] = 0;
+		for(int p=colstart[k]; p < colstart[k+1]; p++)
+		{
+			int i = rows[p];
+			y[i] += entries[p];
+			int len = 0;
+			for(; flag[i] != k; i = parent[i])
+			{
+				pattern[len++] = i;
+				flag[i] = k;
+			}
+			while(len > 0)
+				pattern[--top] = pattern[--len];
+		}
+
+		d[k] = y[k];
+		y[k] = 0;
+		for(; top < n; top++)
+		{
+			int i = pattern[top];
+			double yi = y[i];
+			y[i] = 0;
+			int p2 = lp[i] + lnz[i];
+			for(int p=lp[i]; p < p2; p++)
+				y[li[p]] -= lx[p] * yi;
+			double lki = yi / d[i];
+			d[k] -= lki * yi;
+			li[p2] = k;
+			lx[p2] = lki;
+			lnz[i]++;
+		}
+
+		if(!(d[k] > 0))
+			return false;
+	}
+	return true;
+}
+
+void SparseLDL::Solve(double *b) const
+{
+	for(int j=0; j < n; j++)
+	{
+		for(int p=lp[j]; p < lp[j+1]; p++)
+			b[li[p]] -= lx[p] * b[j];
+	}
+	for(int j=0; j < n; j++)
+		b[j] /= d[j];
+	for(int j=n-1; j >= 0; j--)
+	{
+		for(int p=lp[j]; p < lp[j+1]; p++)
+			b[j] -= lx[p] * b[li[p]];
+	}
+}
+
+///////////////////////////////////////
+/// Levenberg-Marquardt solver
+///////////////////////////////////////
+
+int Solver::solveLM(int isFine)
+{
+	int xLength = GetVectorSize();
+	int nconstraints = GetConstraintCount();
+	x = GetVector();
+
+	double convergence = isFine > 0 ? XconvergenceFine : XconvergenceRough;
+	double validSolution = isFine > 0 ? validSolutionFine : validSoltuionRough;
+
+	residuals.resize(nconstraints);
+	double f = GetResiduals(residuals);
+	statistics.residual = sqrt(f);
+	if(f < smallF)
+		return succsess;
+
+	//Jacobian pattern, and its transpose referencing the Jacobian entries
+	GetJacobianStructure(jacobianstart, jacobiancolumns);
+	std::vector<int> transposestart(xLength+1, 0);
+	std::vector<int> transposeentries(jacobiancolumns.size());
+	for(size_t j=0; j < jacobiancolumns.size(); j++)
+		transposestart[jacobiancolumns[j]+1]++;
+	for(int v=0; v < xLength; v++)
+		transposestart[v+1] += transposestart[v];
+	std::vector<int> fill(transposestart.begin(), transposestart.end() - 1);
+	for(size_t j=0; j < jacobiancolumns.size(); j++)
+		transposeentries[fill[jacobiancolumns[j]]++] = (int)j;
+
+	//Upper triangle of J'J, column b holds every variable a <= b sharing a constraint with b
+	std::vector<int> rowof(jacobiancolumns.size());
+	for(int i=0; i < nconstraints; i++)
+	{
+		for(int j=jacobianstart[i]; j < jacobianstart[i+1]; j++)
+			rowof[j] = i;
+	}
+	std::vector<int> position(xLength, -1);
+	std::vector<int> diagonal(xLength);
+	normal.colstart.assign(xLength+1, 0);
+	normal.rows.clear();
+	for(int b=0; b < xLength; b++)
+	{
+		for(int t=transposestart[b]; t < transposestart[b+1]; t++)
+		{
+			int i = rowof[transposeentries[t]];
+			for(int j=jacobianstart[i]; j < jacobianstart[i+1]; j++)
+			{
+				int a = jacobiancolumns[j];
+				if(a <= b && position[a] != b)
+				{
+					position[a] = b;
+					normal.rows.push_back(a);
+				}
+			}
+		}
+		normal.colstart[b+1] = (int)normal.rows.size();
+	}
+	normal.entries.resize(normal.rows.size());
+	normal.Analyze(xLength);
+
+	std::vector<double> hessian(normal.rows.size());
+	std::vector<double> gradient(xLength);
+	std::vector<double> step(xLength);
+	std::vector<double> xold(x, x + xLength);
+	std::vector<double> origSolution(x, x + xLength);
+
+	double lambda = LMInitialDamping;
+	double lambdaFactor = 2;
+	double stepnorm = convergence + 1;
+	int maxIterNumber = LMMaxIterations * xLength;
+	while(stepnorm > convergence && f > smallF && statistics.iterations < maxIterNumber)
+	{
+		GetJacobian(jacobianstart, jacobiancolumns, residuals, jacobian);
+
+		//Assemble the gradient J'r and the normal matrix J'J
+		std::fill(hessian.begin(), hessian.end(), 0.0);
+		for(int b=0; b < xLength; b++)
+		{
+			for(int p=normal.colstart[b]; p < normal.colstart[b+1]; p++)
+			{
+				position[normal.rows[p]] = p;
+				if(normal.rows[p] == b)
+					diagonal[b] = p;
+			}
+
+			gradient[b] = 0;
+			for(int t=transposestart[b]; t < transposestart[b+1]; t++)
+			{
+				int jb = transposeentries[t];
+				int i = rowof[jb];
+				double value = jacobian[jb];
+				gradient[b] += value * residuals[i];
+				for(int j=jacobianstart[i]; j < jacobianstart[i+1]; j++)
+				{
+					int a = jacobiancolumns[j];
+					if(a <= b)
+						hessian[position[a]] += jacobian[j] * value;
+				}
+			}
+		}
+
+		//Find a damping for which the step reduces the error, the damping is adapted
+		//to the ratio of actual and predicted reduction (Nielsen)
+		bool accepted = false;
+		while(!accepted && lambda < LMMaxDamping)
+		{
+			normal.entries = hessian;
+			for(int b=0; b < xLength; b++)
+				normal.entries[diagonal[b]] += lambda;
+
+			if(!normal.Factorize())
+			{
+				lambda *= lambdaFactor;
+				lambdaFactor *= 2;
+				continue;
+			}
+
+			for(int b=0; b < xLength; b++)
+				step[b] = -gradient[b];
+			normal.Solve(step.data());
+
+			double predicted = 0;
+			for(int b=0; b < xLength; b++)
+			{
+				x[b] = xold[b] + step[b];
+				predicted += step[b] * (lambda * step[b] - gradient[b]);
+			}
+			double fnew = GetResiduals(residuals);
+			if(fnew < f && predicted > 0)
+			{
+				double rho = (f - fnew) / predicted;
+				f = fnew;
+				accepted = true;
+				lambda = std::max(lambda * std::max(1.0/3, 1 - pow(2*rho - 1, 3)), LMMinDamping);
+				lambdaFactor = 2;
+			}
+			else
+			{
+				lambda *= lambdaFactor;
+				lambdaFactor *= 2;
+			}
+		}
+
+		if(!accepted)
+		{
+			for(int b=0; b < xLength; b++)
+				x[b] = xold[b];
+			GetResiduals(residuals);
+			break;
+		}
+
+		stepnorm = 0;
+		for(int b=0; b < xLength; b++)
+		{
+			stepnorm += step[b] * step[b];
+			xold[b] = x[b];
+		}
+		stepnorm = sqrt(stepnorm);
+		statistics.iterations++;
+	}
+
+	statistics.residual = sqrt(f);
+	if(f < validSolution)
+		return succsess;
+
+	//Replace the bad numbers with the last result
+	for(int i=0; i < xLength; i++)
+		x[i] = origSolution[i];
+	return noSolution;
+}
+
+#pragma managed(pop)
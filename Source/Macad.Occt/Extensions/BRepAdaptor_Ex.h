@@ -0,0 +1,7 @@
+#define Include_BRepAdaptor_Curve_h \
+	void D0Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt>^ theP, bool theParallel); \
+	void D1Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt>^ theP, cli::array<Macad::Occt::Vec>^ theV1, bool theParallel);
+
+#define Include_BRepAdaptor_Surface_h \
+	void D0Batch(cli::array<Macad::Occt::Pnt2d>^ theUV, cli::array<Macad::Occt::Pnt>^ theP, bool theParallel); \
+	void D1Batch(cli::array<Macad::Occt::Pnt2d>^ theUV, cli::array<Macad::Occt::Pnt>^ theP, cli::array<Macad::Occt::Vec>^ theD1U, cli::array<Macad::Occt::Vec>^ theD1V, bool theParallel);
@@ -0,0 +1,8 @@
+// The options of BOPAlgo_Options are not reachable through the single inheritance chain of the wrapper
+#define Include_BRepAlgoAPI_BuilderAlgo_h \
+	void SetRunParallel(bool theFlag) { NativeInstance->SetRunParallel(theFlag); }\
+	bool RunParallel() { return NativeInstance->RunParallel(); }\
+	void SetFuzzyValue(double theFuzz) { NativeInstance->SetFuzzyValue(theFuzz); }\
+	double FuzzyValue() { return NativeInstance->FuzzyValue(); }\
+	void SetUseOBB(bool theUseOBB) { NativeInstance->SetUseOBB(theUseOBB); }\
+	bool UseOBB() { return NativeInstance->UseOBB(); }
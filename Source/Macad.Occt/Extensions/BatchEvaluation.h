@@ -0,0 +1,117 @@
+#pragma once
+
+// Batch evaluation of curves and surfaces over parameter arrays, used by the
+// Geom, Geom2d and BRepAdaptor extensions. Evaluation runs through adaptors,
+// which cache the current span of B-spline geometry. Adaptors are not thread
+// safe, so each chunk of a parallel batch works on its own adaptor instance.
+
+#include <algorithm>
+#include <OSD_Parallel.hxx>
+
+#pragma managed(push, off)
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Internal
+		{
+			const int BatchChunkSize = 1024;
+			const int BatchParallelThreshold = 4 * BatchChunkSize;
+
+			template<typename TCreateAdaptor, typename TEvaluate>
+			void EvaluateBatch(int count, bool parallel, const TCreateAdaptor& createAdaptor, const TEvaluate& evaluate)
+			{
+				if (!parallel || count < BatchParallelThreshold)
+				{
+					auto adaptor = createAdaptor();
+					evaluate(*adaptor, 0, count);
+					return;
+				}
+
+				const int chunkCount = (count + BatchChunkSize - 1) / BatchChunkSize;
+				OSD_Parallel::For(0, chunkCount, [&](int chunk)
+				{
+					auto adaptor = createAdaptor();
+					const int begin = chunk * BatchChunkSize;
+					evaluate(*adaptor, begin, std::min(begin + BatchChunkSize, count));
+				});
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			template<typename TCreateAdaptor>
+			void EvaluateCurve(const TCreateAdaptor& createAdaptor, const double* u, int count, ::gp_Pnt* p, ::gp_Vec* v1, bool parallel)
+			{
+				EvaluateBatch(count, parallel, createAdaptor, [&](auto& adaptor, int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+					{
+						if (v1)
+							adaptor.D1(u[i], p[i], v1[i]);
+						else
+							adaptor.D0(u[i], p[i]);
+					}
+				});
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			template<typename TCreateAdaptor>
+			void EvaluateCurve2d(const TCreateAdaptor& createAdaptor, const double* u, int count, ::gp_Pnt2d* p, ::gp_Vec2d* v1, bool parallel)
+			{
+				EvaluateBatch(count, parallel, createAdaptor, [&](auto& adaptor, int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+					{
+						if (v1)
+							adaptor.D1(u[i], p[i], v1[i]);
+						else
+							adaptor.D0(u[i], p[i]);
+					}
+				});
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			template<typename TCreateAdaptor>
+			void EvaluateSurface(const TCreateAdaptor& createAdaptor, const ::gp_Pnt2d* uv, int count, ::gp_Pnt* p, ::gp_Vec* d1u, ::gp_Vec* d1v, bool parallel)
+			{
+				EvaluateBatch(count, parallel, createAdaptor, [&](auto& adaptor, int begin, int end)
+				{
+					for (int i = begin; i < end; i++)
+					{
+						if (d1u)
+							adaptor.D1(uv[i].X(), uv[i].Y(), p[i], d1u[i], d1v[i]);
+						else
+							adaptor.D0(uv[i].X(), uv[i].Y(), p[i]);
+					}
+				});
+			}
+		}
+	}
+}
+
+#pragma managed(pop)
+
+//--------------------------------------------------------------------------------------------------
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Internal
+		{
+			template<typename TInput, typename TOutput>
+			void CheckBatchArrays(cli::array<TInput>^ input, cli::array<TOutput>^ output, System::String^ outputName)
+			{
+				if (input == nullptr)
+					throw gcnew System::ArgumentNullException("input");
+				if (output == nullptr)
+					throw gcnew System::ArgumentNullException(outputName);
+				if (output->Length < input->Length)
+					throw gcnew System::ArgumentException("Result array is smaller than the parameter array.", outputName);
+			}
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#include "OcctPCH.h"
+#include "..\Generated\Geom2d.h"
+#include "BatchEvaluation.h"
+
+#pragma managed(push, off)
+
+static void _EvaluateCurve(const Handle(::Geom2d_Curve)& theCurve, const double* theU, int theCount, ::gp_Pnt2d* theP, ::gp_Vec2d* theV1, bool theParallel)
+{
+	Macad::Occt::Internal::EvaluateCurve2d([&]() { return Handle(::Geom2dAdaptor_Curve)(new ::Geom2dAdaptor_Curve(theCurve)); }, theU, theCount, theP, theV1, theParallel);
+}
+
+#pragma managed(pop)
+
+void Macad::Occt::Geom2d_Curve::D0Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt2d>^ theP, bool theParallel)
+{
+	Internal::CheckBatchArrays(theU, theP, "theP");
+	if (theU->Length == 0)
+		return;
+
+	pin_ptr<double> pp_theU = &theU[0];
+	pin_ptr<Macad::Occt::Pnt2d> pp_theP = &theP[0];
+	_EvaluateCurve(NativeInstance, pp_theU, theU->Length, (::gp_Pnt2d*)pp_theP, nullptr, theParallel);
+}
+
+void Macad::Occt::Geom2d_Curve::D1Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt2d>^ theP, cli::array<Macad::Occt::Vec2d>^ theV1, bool theParallel)
+{
+	Internal::CheckBatchArrays(theU, theP, "theP");
+	Internal::CheckBatchArrays(theU, theV1, "theV1");
+	if (theU->Length == 0)
+		return;
+
+	pin_ptr<double> pp_theU = &theU[0];
+	pin_ptr<Macad::Occt::Pnt2d> pp_theP = &theP[0];
+	pin_ptr<Macad::Occt::Vec2d> pp_theV1 = &theV1[0];
+	_EvaluateCurve(NativeInstance, pp_theU, theU->Length, (::gp_Pnt2d*)pp_theP, (::gp_Vec2d*)pp_theV1, theParallel);
+}
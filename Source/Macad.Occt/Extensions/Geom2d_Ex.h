@@ -0,0 +1,3 @@
+#define Include_Geom2d_Curve_h \
+	void D0Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt2d>^ theP, bool theParallel); \
+	void D1Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt2d>^ theP, cli::array<Macad::Occt::Vec2d>^ theV1, bool theParallel);
@@ -0,0 +1,67 @@
+#include "OcctPCH.h"
+#include "..\Generated\Geom.h"
+#include "BatchEvaluation.h"
+
+#pragma managed(push, off)
+
+static void _EvaluateCurve(const Handle(::Geom_Curve)& theCurve, const double* theU, int theCount, ::gp_Pnt* theP, ::gp_Vec* theV1, bool theParallel)
+{
+	Macad::Occt::Internal::EvaluateCurve([&]() { return Handle(::GeomAdaptor_Curve)(new ::GeomAdaptor_Curve(theCurve)); }, theU, theCount, theP, theV1, theParallel);
+}
+
+static void _EvaluateSurface(const Handle(::Geom_Surface)& theSurface, const ::gp_Pnt2d* theUV, int theCount, ::gp_Pnt* theP, ::gp_Vec* theD1U, ::gp_Vec* theD1V, bool theParallel)
+{
+	Macad::Occt::Internal::EvaluateSurface([&]() { return Handle(::GeomAdaptor_Surface)(new ::GeomAdaptor_Surface(theSurface)); }, theUV, theCount, theP, theD1U, theD1V, theParallel);
+}
+
+#pragma managed(pop)
+
+void Macad::Occt::Geom_Curve::D0Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt>^ theP, bool theParallel)
+{
+	Internal::CheckBatchArrays(theU, theP, "theP");
+	if (theU->Length == 0)
+		return;
+
+	pin_ptr<double> pp_theU = &theU[0];
+	pin_ptr<Macad::Occt::Pnt> pp_theP = &theP[0];
+	_EvaluateCurve(NativeInstance, pp_theU, theU->Length, (::gp_Pnt*)pp_theP, nullptr, theParallel);
+}
+
+void Macad::Occt::Geom_Curve::D1Batch(cli::array<double>^ theU, cli::array<Macad::Occt::Pnt>^ theP, cli::array<Macad::Occt::Vec>^ theV1, bool theParallel)
+{
+	Internal::CheckBatchArrays(theU, theP, "theP");
+	Internal::CheckBatchArrays(theU, theV1, "theV1");
+	if (theU->Length == 0)
+		return;
+
+	pin_ptr<double> pp_theU = &theU[0];
+	pin_ptr<Macad::Occt::Pnt> pp_theP = &theP[0];
+	pin_ptr<Macad::Occt::Vec> pp_theV1 = &theV1[0];
+	_EvaluateCurve(NativeInstance, pp_theU, theU->Length, (::gp_Pnt*)pp_theP, (::gp_Vec*)pp_theV1, theParallel);
+}
+
+void Macad::Occt::Geom_Surface::D0Batch(cli::array<Macad::Occt::Pnt2d>^ theUV, cli::array<Macad::Occt::Pnt>^ theP, bool theParallel)
+{
+	Internal::CheckBatchArrays(theUV, theP, "theP");
+	if (theUV->Length == 0)
+		return;
+
+	pin_ptr<Macad::Occt::Pnt2d> pp_theUV = &theUV[0];
+	pin_ptr<Macad::Occt::Pnt> pp_theP = &theP[0];
+	_EvaluateSurface(NativeInstance, (::gp_Pnt2d*)pp_theUV, theUV->Length, (::gp_Pnt*)pp_theP, nullptr, nullptr, theParallel);
+}
+
+void Macad::Occt::Geom_Surface::D1Batch(cli::array<Macad::Occt::Pnt2d>^ theUV, cli::array<Macad::Occt::Pnt>^ theP, cli::array<Macad::Occt::Vec>^ theD1U, cli::array<Macad::Occt::Vec>^ theD1V, bool theParallel)
+{
+	Internal::CheckBatchArrays(theUV, theP, "theP");
+	Internal::CheckBatchArrays(theUV, theD1U, "theD1U");
+	Internal::CheckBatchArrays(theUV, theD1V, "theD1V");
+	if (theUV->Length == 0)
+		return;
+
+	pin_ptr<Macad::Occt::Pnt2d> pp_theUV = &theUV[0];
+	pin_ptr<Macad::Occt::Pnt> pp_theP = &theP[0];
+	pin_ptr<Macad::Occt::Vec> pp_theD1U = &theD1U[0];
+	pin_ptr<Macad::Occt::Vec> pp_theD1V = &theD1V[0];
+	_EvaluateSurface(NativeInstance, (::gp_Pnt2d*)pp_theUV, theUV->Length, (::gp_Pnt*)pp_theP, (::gp_Vec*)pp_theD1U, (::gp_Vec*)pp_theD1V, theParallel);
+}
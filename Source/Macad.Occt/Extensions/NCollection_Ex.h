@@ -0,0 +1,79 @@
+#pragma once
+
+// Bulk copy between managed arrays and native NCollection_Array1, used by the
+// TColgp/TColStd extensions. The HArray1 classes derive from NCollection_Array1
+// and are handled the same way. The managed value types share the memory layout
+// of their native counterparts, so a range is copied with a single memcpy
+// instead of one interop call per element.
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Internal
+		{
+			template<typename TNative, typename TManaged>
+			void CopyToNative(::NCollection_Array1<TNative>& target, int targetIndex, cli::array<TManaged>^ source, int sourceStart, int count)
+			{
+				if (source == nullptr)
+					throw gcnew System::ArgumentNullException("source");
+				if (sourceStart < 0 || count < 0 || sourceStart > source->Length - count)
+					throw gcnew System::ArgumentOutOfRangeException("count");
+				if (targetIndex < target.Lower() || targetIndex > target.Upper() + 1 - count)
+					throw gcnew System::ArgumentOutOfRangeException("index");
+				if (count == 0)
+					return;
+
+				pin_ptr<TManaged> pinned = &source[sourceStart];
+				memcpy(&target.ChangeValue(targetIndex), pinned, count * sizeof(TNative));
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			template<typename TNative, typename TManaged>
+			void CopyToManaged(const ::NCollection_Array1<TNative>& source, int sourceIndex, cli::array<TManaged>^ target, int targetStart, int count)
+			{
+				if (target == nullptr)
+					throw gcnew System::ArgumentNullException("target");
+				if (targetStart < 0 || count < 0 || targetStart > target->Length - count)
+					throw gcnew System::ArgumentOutOfRangeException("count");
+				if (sourceIndex < source.Lower() || sourceIndex > source.Upper() + 1 - count)
+					throw gcnew System::ArgumentOutOfRangeException("index");
+				if (count == 0)
+					return;
+
+				pin_ptr<TManaged> pinned = &target[targetStart];
+				memcpy(pinned, &source.Value(sourceIndex), count * sizeof(TNative));
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			// An empty range creates an empty array, the bounds constructor does not accept it. The HArray1
+			// classes have no default constructor, but take an Array1 to copy from.
+			template<typename TCollection, typename TManaged>
+			TCollection* CreateNative(cli::array<TManaged>^ source, int sourceStart, int count)
+			{
+				if (source == nullptr)
+					throw gcnew System::ArgumentNullException("source");
+				if (sourceStart < 0 || count < 0 || sourceStart > source->Length - count)
+					throw gcnew System::ArgumentOutOfRangeException("count");
+				if (count == 0)
+					return new TCollection(::NCollection_Array1<typename TCollection::value_type>());
+
+				auto array = new TCollection(1, count);
+				CopyToNative(*array, 1, source, sourceStart, count);
+				return array;
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			template<typename TNative, typename TManaged>
+			cli::array<TManaged>^ CreateManaged(const ::NCollection_Array1<TNative>& source)
+			{
+				auto array = gcnew cli::array<TManaged>(source.Length());
+				CopyToManaged(source, source.Lower(), array, 0, source.Length());
+				return array;
+			}
+		}
+	}
+}
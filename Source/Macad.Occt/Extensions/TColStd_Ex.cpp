@@ -0,0 +1,75 @@
+#include "OcctPCH.h"
+#include "..\Generated\TColStd.h"
+#include "NCollection_Ex.h"
+
+//---------------------------------------------------------------------
+//  Class  TColStd_Array1OfReal
+//---------------------------------------------------------------------
+
+Macad::Occt::TColStd_Array1OfReal::TColStd_Array1OfReal(cli::array<double>^ theValues)
+	: BaseClass<::TColStd_Array1OfReal>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColStd_Array1OfReal>(theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+Macad::Occt::TColStd_Array1OfReal::TColStd_Array1OfReal(cli::array<double>^ theValues, int theStart, int theCount)
+	: BaseClass<::TColStd_Array1OfReal>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColStd_Array1OfReal>(theValues, theStart, theCount);
+}
+
+void Macad::Occt::TColStd_Array1OfReal::SetValues(int theIndex, cli::array<double>^ theValues)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+void Macad::Occt::TColStd_Array1OfReal::SetValues(int theIndex, cli::array<double>^ theValues, int theStart, int theCount)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, theStart, theCount);
+}
+
+cli::array<double>^ Macad::Occt::TColStd_Array1OfReal::ToArray()
+{
+	return Internal::CreateManaged<double, double>(*NativeInstance);
+}
+
+void Macad::Occt::TColStd_Array1OfReal::CopyTo(int theIndex, cli::array<double>^ theTarget, int theStart, int theCount)
+{
+	Internal::CopyToManaged(*NativeInstance, theIndex, theTarget, theStart, theCount);
+}
+
+//---------------------------------------------------------------------
+//  Class  TColStd_Array1OfInteger
+//---------------------------------------------------------------------
+
+Macad::Occt::TColStd_Array1OfInteger::TColStd_Array1OfInteger(cli::array<int>^ theValues)
+	: BaseClass<::TColStd_Array1OfInteger>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColStd_Array1OfInteger>(theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+Macad::Occt::TColStd_Array1OfInteger::TColStd_Array1OfInteger(cli::array<int>^ theValues, int theStart, int theCount)
+	: BaseClass<::TColStd_Array1OfInteger>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColStd_Array1OfInteger>(theValues, theStart, theCount);
+}
+
+void Macad::Occt::TColStd_Array1OfInteger::SetValues(int theIndex, cli::array<int>^ theValues)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+void Macad::Occt::TColStd_Array1OfInteger::SetValues(int theIndex, cli::array<int>^ theValues, int theStart, int theCount)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, theStart, theCount);
+}
+
+cli::array<int>^ Macad::Occt::TColStd_Array1OfInteger::ToArray()
+{
+	return Internal::CreateManaged<int, int>(*NativeInstance);
+}
+
+void Macad::Occt::TColStd_Array1OfInteger::CopyTo(int theIndex, cli::array<int>^ theTarget, int theStart, int theCount)
+{
+	Internal::CopyToManaged(*NativeInstance, theIndex, theTarget, theStart, theCount);
+}
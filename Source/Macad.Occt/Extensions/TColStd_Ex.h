@@ -7,3 +7,19 @@
 			list->Add(it.Value()); \
 		return list; \
 	} \
+
+#define Include_TColStd_Array1OfReal_h \
+	TColStd_Array1OfReal(cli::array<double>^ theValues); \
+	TColStd_Array1OfReal(cli::array<double>^ theValues, int theStart, int theCount); \
+	void SetValues(int theIndex, cli::array<double>^ theValues); \
+	void SetValues(int theIndex, cli::array<double>^ theValues, int theStart, int theCount); \
+	cli::array<double>^ ToArray(); \
+	void CopyTo(int theIndex, cli::array<double>^ theTarget, int theStart, int theCount);
+
+#define Include_TColStd_Array1OfInteger_h \
+	TColStd_Array1OfInteger(cli::array<int>^ theValues); \
+	TColStd_Array1OfInteger(cli::array<int>^ theValues, int theStart, int theCount); \
+	void SetValues(int theIndex, cli::array<int>^ theValues); \
+	void SetValues(int theIndex, cli::array<int>^ theValues, int theStart, int theCount); \
+	cli::array<int>^ ToArray(); \
+	void CopyTo(int theIndex, cli::array<int>^ theTarget, int theStart, int theCount);
@@ -0,0 +1,147 @@
+#include "OcctPCH.h"
+#include "..\Generated\TColgp.h"
+#include "NCollection_Ex.h"
+
+//---------------------------------------------------------------------
+//  Class  TColgp_Array1OfPnt
+//---------------------------------------------------------------------
+
+Macad::Occt::TColgp_Array1OfPnt::TColgp_Array1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues)
+	: BaseClass<::TColgp_Array1OfPnt>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColgp_Array1OfPnt>(theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+Macad::Occt::TColgp_Array1OfPnt::TColgp_Array1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount)
+	: BaseClass<::TColgp_Array1OfPnt>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColgp_Array1OfPnt>(theValues, theStart, theCount);
+}
+
+void Macad::Occt::TColgp_Array1OfPnt::SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+void Macad::Occt::TColgp_Array1OfPnt::SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, theStart, theCount);
+}
+
+cli::array<Macad::Occt::Pnt>^ Macad::Occt::TColgp_Array1OfPnt::ToArray()
+{
+	return Internal::CreateManaged<::gp_Pnt, Macad::Occt::Pnt>(*NativeInstance);
+}
+
+void Macad::Occt::TColgp_Array1OfPnt::CopyTo(int theIndex, cli::array<Macad::Occt::Pnt>^ theTarget, int theStart, int theCount)
+{
+	Internal::CopyToManaged(*NativeInstance, theIndex, theTarget, theStart, theCount);
+}
+
+//---------------------------------------------------------------------
+//  Class  TColgp_Array1OfPnt2d
+//---------------------------------------------------------------------
+
+Macad::Occt::TColgp_Array1OfPnt2d::TColgp_Array1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues)
+	: BaseClass<::TColgp_Array1OfPnt2d>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColgp_Array1OfPnt2d>(theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+Macad::Occt::TColgp_Array1OfPnt2d::TColgp_Array1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount)
+	: BaseClass<::TColgp_Array1OfPnt2d>(BaseClass::InitMode::Uninitialized)
+{
+	_NativeInstance = Internal::CreateNative<::TColgp_Array1OfPnt2d>(theValues, theStart, theCount);
+}
+
+void Macad::Occt::TColgp_Array1OfPnt2d::SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+void Macad::Occt::TColgp_Array1OfPnt2d::SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, theStart, theCount);
+}
+
+cli::array<Macad::Occt::Pnt2d>^ Macad::Occt::TColgp_Array1OfPnt2d::ToArray()
+{
+	return Internal::CreateManaged<::gp_Pnt2d, Macad::Occt::Pnt2d>(*NativeInstance);
+}
+
+void Macad::Occt::TColgp_Array1OfPnt2d::CopyTo(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theTarget, int theStart, int theCount)
+{
+	Internal::CopyToManaged(*NativeInstance, theIndex, theTarget, theStart, theCount);
+}
+
+//---------------------------------------------------------------------
+//  Class  TColgp_HArray1OfPnt
+//---------------------------------------------------------------------
+
+Macad::Occt::TColgp_HArray1OfPnt::TColgp_HArray1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues)
+	: Macad::Occt::Standard_Transient(BaseClass::InitMode::Uninitialized)
+{
+	NativeInstance = Internal::CreateNative<::TColgp_HArray1OfPnt>(theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+Macad::Occt::TColgp_HArray1OfPnt::TColgp_HArray1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount)
+	: Macad::Occt::Standard_Transient(BaseClass::InitMode::Uninitialized)
+{
+	NativeInstance = Internal::CreateNative<::TColgp_HArray1OfPnt>(theValues, theStart, theCount);
+}
+
+void Macad::Occt::TColgp_HArray1OfPnt::SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+void Macad::Occt::TColgp_HArray1OfPnt::SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, theStart, theCount);
+}
+
+cli::array<Macad::Occt::Pnt>^ Macad::Occt::TColgp_HArray1OfPnt::ToArray()
+{
+	return Internal::CreateManaged<::gp_Pnt, Macad::Occt::Pnt>(*NativeInstance);
+}
+
+void Macad::Occt::TColgp_HArray1OfPnt::CopyTo(int theIndex, cli::array<Macad::Occt::Pnt>^ theTarget, int theStart, int theCount)
+{
+	Internal::CopyToManaged(*NativeInstance, theIndex, theTarget, theStart, theCount);
+}
+
+//---------------------------------------------------------------------
+//  Class  TColgp_HArray1OfPnt2d
+//---------------------------------------------------------------------
+
+Macad::Occt::TColgp_HArray1OfPnt2d::TColgp_HArray1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues)
+	: Macad::Occt::Standard_Transient(BaseClass::InitMode::Uninitialized)
+{
+	NativeInstance = Internal::CreateNative<::TColgp_HArray1OfPnt2d>(theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+Macad::Occt::TColgp_HArray1OfPnt2d::TColgp_HArray1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount)
+	: Macad::Occt::Standard_Transient(BaseClass::InitMode::Uninitialized)
+{
+	NativeInstance = Internal::CreateNative<::TColgp_HArray1OfPnt2d>(theValues, theStart, theCount);
+}
+
+void Macad::Occt::TColgp_HArray1OfPnt2d::SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, 0, theValues != nullptr ? theValues->Length : 0);
+}
+
+void Macad::Occt::TColgp_HArray1OfPnt2d::SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount)
+{
+	Internal::CopyToNative(*NativeInstance, theIndex, theValues, theStart, theCount);
+}
+
+cli::array<Macad::Occt::Pnt2d>^ Macad::Occt::TColgp_HArray1OfPnt2d::ToArray()
+{
+	return Internal::CreateManaged<::gp_Pnt2d, Macad::Occt::Pnt2d>(*NativeInstance);
+}
+
+void Macad::Occt::TColgp_HArray1OfPnt2d::CopyTo(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theTarget, int theStart, int theCount)
+{
+	Internal::CopyToManaged(*NativeInstance, theIndex, theTarget, theStart, theCount);
+}
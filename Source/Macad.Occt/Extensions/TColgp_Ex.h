@@ -0,0 +1,31 @@
+#define Include_TColgp_Array1OfPnt_h \
+	TColgp_Array1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues); \
+	TColgp_Array1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount); \
+	cli::array<Macad::Occt::Pnt>^ ToArray(); \
+	void CopyTo(int theIndex, cli::array<Macad::Occt::Pnt>^ theTarget, int theStart, int theCount);
+
+#define Include_TColgp_Array1OfPnt2d_h \
+	TColgp_Array1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues); \
+	TColgp_Array1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount); \
+	cli::array<Macad::Occt::Pnt2d>^ ToArray(); \
+	void CopyTo(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theTarget, int theStart, int theCount);
+
+#define Include_TColgp_HArray1OfPnt_h \
+	TColgp_HArray1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues); \
+	TColgp_HArray1OfPnt(cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt>^ theValues, int theStart, int theCount); \
+	cli::array<Macad::Occt::Pnt>^ ToArray(); \
+	void CopyTo(int theIndex, cli::array<Macad::Occt::Pnt>^ theTarget, int theStart, int theCount);
+
+#define Include_TColgp_HArray1OfPnt2d_h \
+	TColgp_HArray1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues); \
+	TColgp_HArray1OfPnt2d(cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues); \
+	void SetValues(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theValues, int theStart, int theCount); \
+	cli::array<Macad::Occt::Pnt2d>^ ToArray(); \
+	void CopyTo(int theIndex, cli::array<Macad::Occt::Pnt2d>^ theTarget, int theStart, int theCount);
@@ -800,6 +800,13 @@ Macad::Occt::Geom_Surface^ Macad::Occt::BRep_Tool::Surface(Macad::Occt::TopoDS_F
 	 return _result.IsNull() ? nullptr : Macad::Occt::Geom_Surface::CreateDowncasted( _result.get());
 }
 
+Macad::Occt::Geom_Surface^ Macad::Occt::BRep_Tool::SurfaceShared(Macad::Occt::TopoDS_Face^ F, Macad::Occt::TopLoc_Location^ L)
+{
+	Handle(::Geom_Surface) _result;
+	_result = ::BRep_Tool::Surface(*(::TopoDS_Face*)F->NativeInstance, *(::TopLoc_Location*)L->NativeInstance);
+	 return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<Macad::Occt::Geom_Surface>( _result.get());
+}
+
 Macad::Occt::Geom_Surface^ Macad::Occt::BRep_Tool::Surface(Macad::Occt::TopoDS_Face^ F)
 {
 	Handle(::Geom_Surface) _result;
@@ -807,6 +814,13 @@ Macad::Occt::Geom_Surface^ Macad::Occt::BRep_Tool::Surface(Macad::Occt::TopoDS_F
 	 return _result.IsNull() ? nullptr : Macad::Occt::Geom_Surface::CreateDowncasted( _result.get());
 }
 
+Macad::Occt::Geom_Surface^ Macad::Occt::BRep_Tool::SurfaceShared(Macad::Occt::TopoDS_Face^ F)
+{
+	Handle(::Geom_Surface) _result;
+	_result = ::BRep_Tool::Surface(*(::TopoDS_Face*)F->NativeInstance);
+	 return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<Macad::Occt::Geom_Surface>( _result.get());
+}
+
 double Macad::Occt::BRep_Tool::Tolerance(Macad::Occt::TopoDS_Face^ F)
 {
 	return ::BRep_Tool::Tolerance(*(::TopoDS_Face*)F->NativeInstance);
@@ -836,6 +850,15 @@ Macad::Occt::Geom_Curve^ Macad::Occt::BRep_Tool::Curve(Macad::Occt::TopoDS_Edge^
 	 return _result.IsNull() ? nullptr : Macad::Occt::Geom_Curve::CreateDowncasted( _result.get());
 }
 
+Macad::Occt::Geom_Curve^ Macad::Occt::BRep_Tool::CurveShared(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopLoc_Location^ L, double% First, double% Last)
+{
+	pin_ptr<double> pp_First = &First;
+	pin_ptr<double> pp_Last = &Last;
+	Handle(::Geom_Curve) _result;
+	_result = ::BRep_Tool::Curve(*(::TopoDS_Edge*)E->NativeInstance, *(::TopLoc_Location*)L->NativeInstance, *(Standard_Real*)pp_First, *(Standard_Real*)pp_Last);
+	 return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<Macad::Occt::Geom_Curve>( _result.get());
+}
+
 Macad::Occt::Geom_Curve^ Macad::Occt::BRep_Tool::Curve(Macad::Occt::TopoDS_Edge^ E, double% First, double% Last)
 {
 	pin_ptr<double> pp_First = &First;
@@ -845,6 +868,15 @@ Macad::Occt::Geom_Curve^ Macad::Occt::BRep_Tool::Curve(Macad::Occt::TopoDS_Edge^
 	 return _result.IsNull() ? nullptr : Macad::Occt::Geom_Curve::CreateDowncasted( _result.get());
 }
 
+Macad::Occt::Geom_Curve^ Macad::Occt::BRep_Tool::CurveShared(Macad::Occt::TopoDS_Edge^ E, double% First, double% Last)
+{
+	pin_ptr<double> pp_First = &First;
+	pin_ptr<double> pp_Last = &Last;
+	Handle(::Geom_Curve) _result;
+	_result = ::BRep_Tool::Curve(*(::TopoDS_Edge*)E->NativeInstance, *(Standard_Real*)pp_First, *(Standard_Real*)pp_Last);
+	 return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<Macad::Occt::Geom_Curve>( _result.get());
+}
+
 Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last, bool% theIsStored)
 {
 	pin_ptr<double> pp_First = &First;
@@ -855,6 +887,16 @@ Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurface(Macad::Occt::T
 	 return _result.IsNull() ? nullptr : Macad::Occt::Geom2d_Curve::CreateDowncasted( _result.get());
 }
 
+Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurfaceShared(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last, bool% theIsStored)
+{
+	pin_ptr<double> pp_First = &First;
+	pin_ptr<double> pp_Last = &Last;
+	pin_ptr<bool> pp_theIsStored = &theIsStored;
+	Handle(::Geom2d_Curve) _result;
+	_result = ::BRep_Tool::CurveOnSurface(*(::TopoDS_Edge*)E->NativeInstance, *(::TopoDS_Face*)F->NativeInstance, *(Standard_Real*)pp_First, *(Standard_Real*)pp_Last, (Standard_Boolean*)pp_theIsStored);
+	 return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<Macad::Occt::Geom2d_Curve>( _result.get());
+}
+
 Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last)
 {
 	pin_ptr<double> pp_First = &First;
@@ -864,6 +906,15 @@ Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurface(Macad::Occt::T
 	 return _result.IsNull() ? nullptr : Macad::Occt::Geom2d_Curve::CreateDowncasted( _result.get());
 }
 
+Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurfaceShared(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last)
+{
+	pin_ptr<double> pp_First = &First;
+	pin_ptr<double> pp_Last = &Last;
+	Handle(::Geom2d_Curve) _result;
+	_result = ::BRep_Tool::CurveOnSurface(*(::TopoDS_Edge*)E->NativeInstance, *(::TopoDS_Face*)F->NativeInstance, *(Standard_Real*)pp_First, *(Standard_Real*)pp_Last, 0);
+	 return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<Macad::Occt::Geom2d_Curve>( _result.get());
+}
+
 Macad::Occt::Geom2d_Curve^ Macad::Occt::BRep_Tool::CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::Geom_Surface^ S, Macad::Occt::TopLoc_Location^ L, double% First, double% Last, bool% theIsStored)
 {
 	Handle(::Geom_Surface) h_S = S->NativeInstance;
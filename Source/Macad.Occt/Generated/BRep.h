@@ -392,7 +392,9 @@ public:
 	BRep_Tool(Macad::Occt::BRep_Tool^ parameter1);
 	static bool IsClosed(Macad::Occt::TopoDS_Shape^ S);
 	static Macad::Occt::Geom_Surface^ Surface(Macad::Occt::TopoDS_Face^ F, Macad::Occt::TopLoc_Location^ L);
+	static Macad::Occt::Geom_Surface^ SurfaceShared(Macad::Occt::TopoDS_Face^ F, Macad::Occt::TopLoc_Location^ L);
 	static Macad::Occt::Geom_Surface^ Surface(Macad::Occt::TopoDS_Face^ F);
+	static Macad::Occt::Geom_Surface^ SurfaceShared(Macad::Occt::TopoDS_Face^ F);
 	/* Method skipped due to unknown mapping: Poly_Triangulation Triangulation(TopoDS_Face theFace, TopLoc_Location theLocation, unsigned int theMeshPurpose, ) */
 	/* Method skipped due to unknown mapping: Poly_Triangulation Triangulation(TopoDS_Face theFace, TopLoc_Location theLocation, unsigned int theMeshPurpose, ) */
 	/* Method skipped due to unknown mapping: Poly_ListOfTriangulation Triangulations(TopoDS_Face theFace, TopLoc_Location theLocation, ) */
@@ -401,10 +403,14 @@ public:
 	static bool IsGeometric(Macad::Occt::TopoDS_Face^ F);
 	static bool IsGeometric(Macad::Occt::TopoDS_Edge^ E);
 	static Macad::Occt::Geom_Curve^ Curve(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopLoc_Location^ L, double% First, double% Last);
+	static Macad::Occt::Geom_Curve^ CurveShared(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopLoc_Location^ L, double% First, double% Last);
 	static Macad::Occt::Geom_Curve^ Curve(Macad::Occt::TopoDS_Edge^ E, double% First, double% Last);
+	static Macad::Occt::Geom_Curve^ CurveShared(Macad::Occt::TopoDS_Edge^ E, double% First, double% Last);
 	/* Method skipped due to unknown mapping: Poly_Polygon3D Polygon3D(TopoDS_Edge E, TopLoc_Location L, ) */
 	static Macad::Occt::Geom2d_Curve^ CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last, bool% theIsStored);
+	static Macad::Occt::Geom2d_Curve^ CurveOnSurfaceShared(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last, bool% theIsStored);
 	static Macad::Occt::Geom2d_Curve^ CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last);
+	static Macad::Occt::Geom2d_Curve^ CurveOnSurfaceShared(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F, double% First, double% Last);
 	static Macad::Occt::Geom2d_Curve^ CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::Geom_Surface^ S, Macad::Occt::TopLoc_Location^ L, double% First, double% Last, bool% theIsStored);
 	static Macad::Occt::Geom2d_Curve^ CurveOnSurface(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::Geom_Surface^ S, Macad::Occt::TopLoc_Location^ L, double% First, double% Last);
 	static Macad::Occt::Geom2d_Curve^ CurveOnPlane(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::Geom_Surface^ S, Macad::Occt::TopLoc_Location^ L, double% First, double% Last);
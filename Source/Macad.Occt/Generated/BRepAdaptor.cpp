@@ -210,6 +210,12 @@ Macad::Occt::Trsf Macad::Occt::BRepAdaptor_Curve::Trsf()
 	return Macad::Occt::Trsf(((::BRepAdaptor_Curve*)_NativeInstance)->Trsf());
 }
 
+void Macad::Occt::BRepAdaptor_Curve::Trsf([System::Runtime::InteropServices::Out] Macad::Occt::Trsf% theResult)
+{
+	pin_ptr<Macad::Occt::Trsf> pp_theResult = &theResult;
+	*(gp_Trsf*)pp_theResult = ((::BRepAdaptor_Curve*)_NativeInstance)->Trsf();
+}
+
 bool Macad::Occt::BRepAdaptor_Curve::Is3DCurve()
 {
 	return ((::BRepAdaptor_Curve*)_NativeInstance)->Is3DCurve();
@@ -298,6 +304,12 @@ Macad::Occt::Pnt Macad::Occt::BRepAdaptor_Curve::Value(double U)
 	return Macad::Occt::Pnt(((::BRepAdaptor_Curve*)_NativeInstance)->Value(U));
 }
 
+void Macad::Occt::BRepAdaptor_Curve::Value(double U, [System::Runtime::InteropServices::Out] Macad::Occt::Pnt% theResult)
+{
+	pin_ptr<Macad::Occt::Pnt> pp_theResult = &theResult;
+	*(gp_Pnt*)pp_theResult = ((::BRepAdaptor_Curve*)_NativeInstance)->Value(U);
+}
+
 void Macad::Occt::BRepAdaptor_Curve::D0(double U, Macad::Occt::Pnt% P)
 {
 	pin_ptr<Macad::Occt::Pnt> pp_P = &P;
@@ -333,6 +345,12 @@ Macad::Occt::Vec Macad::Occt::BRepAdaptor_Curve::DN(double U, int N)
 	return Macad::Occt::Vec(((::BRepAdaptor_Curve*)_NativeInstance)->DN(U, N));
 }
 
+void Macad::Occt::BRepAdaptor_Curve::DN(double U, int N, [System::Runtime::InteropServices::Out] Macad::Occt::Vec% theResult)
+{
+	pin_ptr<Macad::Occt::Vec> pp_theResult = &theResult;
+	*(gp_Vec*)pp_theResult = ((::BRepAdaptor_Curve*)_NativeInstance)->DN(U, N);
+}
+
 double Macad::Occt::BRepAdaptor_Curve::Resolution(double R3d)
 {
 	return ((::BRepAdaptor_Curve*)_NativeInstance)->Resolution(R3d);
@@ -102,6 +102,7 @@ public:
 	void Initialize(Macad::Occt::TopoDS_Edge^ E);
 	void Initialize(Macad::Occt::TopoDS_Edge^ E, Macad::Occt::TopoDS_Face^ F);
 	Macad::Occt::Trsf Trsf();
+	void Trsf([System::Runtime::InteropServices::Out] Macad::Occt::Trsf% theResult);
 	bool Is3DCurve();
 	bool IsCurveOnSurface();
 	Macad::Occt::GeomAdaptor_Curve^ Curve();
@@ -118,11 +119,13 @@ public:
 	bool IsPeriodic();
 	double Period();
 	Macad::Occt::Pnt Value(double U);
+	void Value(double U, [System::Runtime::InteropServices::Out] Macad::Occt::Pnt% theResult);
 	void D0(double U, Macad::Occt::Pnt% P);
 	void D1(double U, Macad::Occt::Pnt% P, Macad::Occt::Vec% V);
 	void D2(double U, Macad::Occt::Pnt% P, Macad::Occt::Vec% V1, Macad::Occt::Vec% V2);
 	void D3(double U, Macad::Occt::Pnt% P, Macad::Occt::Vec% V1, Macad::Occt::Vec% V2, Macad::Occt::Vec% V3);
 	Macad::Occt::Vec DN(double U, int N);
+	void DN(double U, int N, [System::Runtime::InteropServices::Out] Macad::Occt::Vec% theResult);
 	double Resolution(double R3d);
 	Macad::Occt::GeomAbs_CurveType GetGeomType();
 	Macad::Occt::gp_Lin^ Line();
@@ -67,6 +67,11 @@ Macad::Occt::TopoDS_Shape^ Macad::Occt::TopExp_Explorer::Value()
 	 return _result==nullptr ? nullptr : gcnew Macad::Occt::TopoDS_Shape(_result);
 }
 
+void Macad::Occt::TopExp_Explorer::Value(Macad::Occt::TopoDS_Shape^ theResult)
+{
+	*(::TopoDS_Shape*)theResult->NativeInstance = ((::TopExp_Explorer*)_NativeInstance)->Value();
+}
+
 Macad::Occt::TopoDS_Shape^ Macad::Occt::TopExp_Explorer::Current()
 {
 	::TopoDS_Shape* _result = new ::TopoDS_Shape();
@@ -74,6 +79,11 @@ Macad::Occt::TopoDS_Shape^ Macad::Occt::TopExp_Explorer::Current()
 	 return _result==nullptr ? nullptr : gcnew Macad::Occt::TopoDS_Shape(_result);
 }
 
+void Macad::Occt::TopExp_Explorer::Current(Macad::Occt::TopoDS_Shape^ theResult)
+{
+	*(::TopoDS_Shape*)theResult->NativeInstance = ((::TopExp_Explorer*)_NativeInstance)->Current();
+}
+
 void Macad::Occt::TopExp_Explorer::ReInit()
 {
 	((::TopExp_Explorer*)_NativeInstance)->ReInit();
@@ -86,6 +96,11 @@ Macad::Occt::TopoDS_Shape^ Macad::Occt::TopExp_Explorer::ExploredShape()
 	 return _result==nullptr ? nullptr : gcnew Macad::Occt::TopoDS_Shape(_result);
 }
 
+void Macad::Occt::TopExp_Explorer::ExploredShape(Macad::Occt::TopoDS_Shape^ theResult)
+{
+	*(::TopoDS_Shape*)theResult->NativeInstance = ((::TopExp_Explorer*)_NativeInstance)->ExploredShape();
+}
+
 int Macad::Occt::TopExp_Explorer::Depth()
 {
 	return ((::TopExp_Explorer*)_NativeInstance)->Depth();
@@ -45,9 +45,12 @@ public:
 	bool More();
 	void Next();
 	Macad::Occt::TopoDS_Shape^ Value();
+	void Value(Macad::Occt::TopoDS_Shape^ theResult);
 	Macad::Occt::TopoDS_Shape^ Current();
+	void Current(Macad::Occt::TopoDS_Shape^ theResult);
 	void ReInit();
 	Macad::Occt::TopoDS_Shape^ ExploredShape();
+	void ExploredShape(Macad::Occt::TopoDS_Shape^ theResult);
 	int Depth();
 	void Clear();
 }; // class TopExp_Explorer
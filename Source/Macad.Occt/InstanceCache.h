@@ -0,0 +1,129 @@
+#pragma once
+
+namespace Macad
+{
+namespace Occt
+{
+
+	// Weak map from native transient instances to the wrappers created for them. The 'Shared'
+	// variants generated for classes configured with FastInterop::ReuseHandles return the same
+	// wrapper for the same native handle as long as the wrapper is alive and not disposed,
+	// instead of creating a new finalizable wrapper on every call.
+	public ref class InstanceCache abstract sealed
+	{
+	internal:
+		static Standard_Transient^ Find(::Standard_Transient* instance)
+		{
+			System::Threading::Monitor::Enter(_Cache);
+			try
+			{
+				System::WeakReference^ reference;
+				if (_Cache->TryGetValue(System::IntPtr(instance), reference))
+				{
+					auto wrapper = (Standard_Transient^)reference->Target;
+					// The wrapper may have been disposed or got another native instance assigned
+					if (wrapper != nullptr && wrapper->NativeInstance == instance)
+						return wrapper;
+
+					_Cache->Remove(System::IntPtr(instance));
+				}
+				return nullptr;
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_Cache);
+			}
+		}
+
+		//--------------------------------------------------------------------------------------------------
+
+		static void Add(::Standard_Transient* instance, Standard_Transient^ wrapper)
+		{
+			System::Threading::Monitor::Enter(_Cache);
+			try
+			{
+				_Cache[System::IntPtr(instance)] = gcnew System::WeakReference(wrapper);
+
+				if (++_AddCount % PurgeInterval == 0)
+				{
+					_Purge();
+				}
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_Cache);
+			}
+		}
+
+		//--------------------------------------------------------------------------------------------------
+
+	public:
+		// Number of wrappers currently alive in the cache
+		static property int Count
+		{
+			int get()
+			{
+				System::Threading::Monitor::Enter(_Cache);
+				try
+				{
+					_Purge();
+					return _Cache->Count;
+				}
+				finally
+				{
+					System::Threading::Monitor::Exit(_Cache);
+				}
+			}
+		}
+
+		//--------------------------------------------------------------------------------------------------
+
+	private:
+		static void _Purge()
+		{
+			auto deadKeys = gcnew System::Collections::Generic::List<System::IntPtr>();
+			for each (auto kvp in _Cache)
+			{
+				if (!kvp.Value->IsAlive)
+					deadKeys->Add(kvp.Key);
+			}
+			for each (auto key in deadKeys)
+			{
+				_Cache->Remove(key);
+			}
+		}
+
+		//--------------------------------------------------------------------------------------------------
+
+		literal int PurgeInterval = 1024;
+		static System::Collections::Generic::Dictionary<System::IntPtr, System::WeakReference^>^ _Cache;
+		static int _AddCount;
+
+		static InstanceCache()
+		{
+			_Cache = gcnew System::Collections::Generic::Dictionary<System::IntPtr, System::WeakReference^>();
+			_AddCount = 0;
+		}
+
+	}; // class InstanceCache
+
+	//--------------------------------------------------------------------------------------------------
+
+	namespace Internal
+	{
+		// Returns the cached wrapper of the native instance, or creates and caches a new one
+		template<typename TManaged, typename TNative>
+		TManaged^ GetOrCreateWrapper(TNative* instance)
+		{
+			auto wrapper = dynamic_cast<TManaged^>(InstanceCache::Find(instance));
+			if (wrapper == nullptr)
+			{
+				wrapper = TManaged::CreateDowncasted(instance);
+				InstanceCache::Add(instance, wrapper);
+			}
+			return wrapper;
+		}
+	}
+
+}; // namespace Occt
+}; // namespace Macad
@@ -28,13 +28,19 @@ typedef void* Aspect_FBConfig;
 
 #include "BaseClass.h"
 #include "Standard_Transient.h"
+#include "InstanceCache.h"
 #include "ValueTypes\ValueTypes.h"
 
 #include "Extensions/BOPTools_Ex.h"
 #include "Extensions/BRep_Ex.h"
+#include "Extensions/BRepAdaptor_Ex.h"
+#include "Extensions/BRepAlgoAPI_Ex.h"
 #include "Extensions/Graphic3d_Ex.h"
+#include "Extensions/Geom_Ex.h"
+#include "Extensions/Geom2d_Ex.h"
 #include "Extensions/Geom2dAPI_Ex.h"
 #include "Extensions/ShapeFix_Ex.h"
+#include "Extensions/TColgp_Ex.h"
 #include "Extensions/TColStd_Ex.h"
 #include "Extensions/TopLoc_Ex.h"
 #include "Extensions/TopoDS_Ex.h"
@@ -1,4 +1,5 @@
 #include "OcctPCH.h"
+#include "..\TransformKernels.h"
 
 using namespace System;
 using namespace Macad::Occt;
@@ -197,6 +198,19 @@ Dir2d Dir2d::Transformed(Trsf2d T)
 	return VRes;
 }
 
+void Dir2d::Transform(cli::array<Dir2d>^ Values, Trsf2d T)
+{
+	Transform(Values, Values, T);
+}
+
+void Dir2d::Transform(cli::array<Dir2d>^ Source, cli::array<Dir2d>^ Target, Trsf2d T)
+{
+	STRUCT_PIN(T, Trsf2d, gp_Trsf2d);
+	double matrix[6];
+	Internal::GetDirectionMatrix(*T_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, true);
+}
+
 Dir2d Dir2d::operator * (Dir2d Left, Trsf2d Right)
 {
 	return Left.Transformed(Right);
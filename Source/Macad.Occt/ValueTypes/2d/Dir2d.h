@@ -60,6 +60,8 @@ namespace Macad
 			Dir2d Rotated(double Ang);
 			void Transform(Trsf2d T);
 			Dir2d Transformed(Trsf2d T);
+			static void Transform(cli::array<Dir2d>^ Values, Trsf2d T);
+			static void Transform(cli::array<Dir2d>^ Source, cli::array<Dir2d>^ Target, Trsf2d T);
 
 			//--------------------------------------------------------------------------------------------------
 
@@ -1,4 +1,5 @@
 #include "OcctPCH.h"
+#include "..\TransformKernels.h"
 
 using namespace System;
 using namespace Macad::Occt;
@@ -149,6 +150,19 @@ Pnt2d Pnt2d::Transformed(Trsf2d T)
 	return Pres;
 }
 
+void Pnt2d::Transform(cli::array<Pnt2d>^ Values, Trsf2d T)
+{
+	Transform(Values, Values, T);
+}
+
+void Pnt2d::Transform(cli::array<Pnt2d>^ Source, cli::array<Pnt2d>^ Target, Trsf2d T)
+{
+	STRUCT_PIN(T, Trsf2d, gp_Trsf2d);
+	double matrix[6];
+	Internal::GetPointMatrix(*T_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, true);
+}
+
 void Pnt2d::Translate(Vec2d V)
 {
 	_Coord.Add(V.Coord);
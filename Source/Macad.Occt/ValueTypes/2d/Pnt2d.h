@@ -55,6 +55,8 @@ namespace Macad
 			Pnt2d Scaled(Pnt2d P, double S);
 			void Transform(Trsf2d T);
 			Pnt2d Transformed(Trsf2d T);
+			static void Transform(cli::array<Pnt2d>^ Values, Trsf2d T);
+			static void Transform(cli::array<Pnt2d>^ Source, cli::array<Pnt2d>^ Target, Trsf2d T);
 			void Translate(Vec2d V);
 			Pnt2d Translated(Vec2d V);
 			void Translate(Pnt2d P1, Pnt2d P2);
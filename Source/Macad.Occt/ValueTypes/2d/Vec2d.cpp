@@ -1,4 +1,5 @@
 #include "OcctPCH.h"
+#include "..\TransformKernels.h"
 
 using namespace System;
 using namespace Macad::Occt;
@@ -296,6 +297,19 @@ Vec2d Vec2d::Transformed(Trsf2d T)
 	return VRes;
 }
 
+void Vec2d::Transform(cli::array<Vec2d>^ Values, Trsf2d T)
+{
+	Transform(Values, Values, T);
+}
+
+void Vec2d::Transform(cli::array<Vec2d>^ Source, cli::array<Vec2d>^ Target, Trsf2d T)
+{
+	STRUCT_PIN(T, Trsf2d, gp_Trsf2d);
+	double matrix[6];
+	Internal::GetVectorMatrix(*T_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, true);
+}
+
 Vec2d Vec2d::operator * (Vec2d Left, Trsf2d Right)
 {
 	return Left.Transformed(Right);
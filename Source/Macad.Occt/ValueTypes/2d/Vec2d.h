@@ -78,6 +78,8 @@ namespace Macad
 			Vec2d Scaled(double S);
 			void Transform(Trsf2d T);
 			Vec2d Transformed(Trsf2d T);
+			static void Transform(cli::array<Vec2d>^ Values, Trsf2d T);
+			static void Transform(cli::array<Vec2d>^ Source, cli::array<Vec2d>^ Target, Trsf2d T);
 
 			//--------------------------------------------------------------------------------------------------
 
@@ -1,4 +1,5 @@
 #include "OcctPCH.h"
+#include "..\TransformKernels.h"
 
 using namespace System;
 using namespace Macad::Occt;
@@ -276,6 +277,32 @@ Dir Dir::Transformed(Trsf T)
 	return VRes;
 }
 
+void Dir::Transform(cli::array<Dir>^ Values, Trsf T)
+{
+	Transform(Values, Values, T);
+}
+
+void Dir::Transform(cli::array<Dir>^ Source, cli::array<Dir>^ Target, Trsf T)
+{
+	STRUCT_PIN(T, Trsf, gp_Trsf);
+	double matrix[12];
+	Internal::GetDirectionMatrix(*T_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, false);
+}
+
+void Dir::Transform(cli::array<Dir>^ Values, Quaternion Q)
+{
+	Transform(Values, Values, Q);
+}
+
+void Dir::Transform(cli::array<Dir>^ Source, cli::array<Dir>^ Target, Quaternion Q)
+{
+	STRUCT_PIN(Q, Quaternion, gp_Quaternion);
+	double matrix[12];
+	Internal::GetRotationMatrix(*Q_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, false);
+}
+
 Dir Dir::operator * (Dir Left, Trsf Right)
 {
 	return Left.Transformed(Right);
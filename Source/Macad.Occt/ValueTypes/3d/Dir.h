@@ -10,6 +10,7 @@ namespace Macad
 		value struct Ax1;
 		value struct Ax2;
 		value struct Trsf;
+		value struct Quaternion;
 
 		[System::Runtime::InteropServices::StructLayout(System::Runtime::InteropServices::LayoutKind::Sequential, Pack = 8)]
 		public value struct Dir
@@ -70,6 +71,10 @@ namespace Macad
 			Dir Rotated(Ax1 A1, double Ang);
 			void Transform(Trsf T);
 			Dir Transformed(Trsf T);
+			static void Transform(cli::array<Dir>^ Values, Trsf T);
+			static void Transform(cli::array<Dir>^ Source, cli::array<Dir>^ Target, Trsf T);
+			static void Transform(cli::array<Dir>^ Values, Quaternion Q);
+			static void Transform(cli::array<Dir>^ Source, cli::array<Dir>^ Target, Quaternion Q);
 
 			//--------------------------------------------------------------------------------------------------
 
@@ -1,4 +1,5 @@
 #include "OcctPCH.h"
+#include "..\TransformKernels.h"
 
 using namespace System;
 using namespace Macad::Occt;
@@ -174,6 +175,32 @@ Pnt Pnt::Transformed(Trsf T)
 	return Pres;
 }
 
+void Pnt::Transform(cli::array<Pnt>^ Values, Trsf T)
+{
+	Transform(Values, Values, T);
+}
+
+void Pnt::Transform(cli::array<Pnt>^ Source, cli::array<Pnt>^ Target, Trsf T)
+{
+	STRUCT_PIN(T, Trsf, gp_Trsf);
+	double matrix[12];
+	Internal::GetPointMatrix(*T_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, false);
+}
+
+void Pnt::Transform(cli::array<Pnt>^ Values, Quaternion Q)
+{
+	Transform(Values, Values, Q);
+}
+
+void Pnt::Transform(cli::array<Pnt>^ Source, cli::array<Pnt>^ Target, Quaternion Q)
+{
+	STRUCT_PIN(Q, Quaternion, gp_Quaternion);
+	double matrix[12];
+	Internal::GetRotationMatrix(*Q_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, false);
+}
+
 void Pnt::Translate(Vec V)
 {
 	_Coord.Add(V.Coord);
@@ -11,6 +11,7 @@ namespace Macad
 		value struct Ax1;
 		value struct Ax2;
 		value struct Trsf;
+		value struct Quaternion;
 
 		[System::Runtime::InteropServices::StructLayout(System::Runtime::InteropServices::LayoutKind::Sequential, Pack = 8)]
 		public value struct Pnt
@@ -59,6 +60,10 @@ namespace Macad
 			Pnt Scaled(Pnt P, double S);
 			void Transform(Trsf T);
 			Pnt Transformed(Trsf T);
+			static void Transform(cli::array<Pnt>^ Values, Trsf T);
+			static void Transform(cli::array<Pnt>^ Source, cli::array<Pnt>^ Target, Trsf T);
+			static void Transform(cli::array<Pnt>^ Values, Quaternion Q);
+			static void Transform(cli::array<Pnt>^ Source, cli::array<Pnt>^ Target, Quaternion Q);
 			void Translate(Vec V);
 			Pnt Translated(Vec V);
 			void Translate(Pnt P1, Pnt P2);
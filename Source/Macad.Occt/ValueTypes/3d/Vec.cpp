@@ -1,4 +1,5 @@
 #include "OcctPCH.h"
+#include "..\TransformKernels.h"
 
 using namespace System;
 using namespace Macad::Occt;
@@ -357,6 +358,32 @@ Vec Vec::Transformed(Trsf T)
 	return VRes;
 }
 
+void Vec::Transform(cli::array<Vec>^ Values, Trsf T)
+{
+	Transform(Values, Values, T);
+}
+
+void Vec::Transform(cli::array<Vec>^ Source, cli::array<Vec>^ Target, Trsf T)
+{
+	STRUCT_PIN(T, Trsf, gp_Trsf);
+	double matrix[12];
+	Internal::GetVectorMatrix(*T_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, false);
+}
+
+void Vec::Transform(cli::array<Vec>^ Values, Quaternion Q)
+{
+	Transform(Values, Values, Q);
+}
+
+void Vec::Transform(cli::array<Vec>^ Source, cli::array<Vec>^ Target, Quaternion Q)
+{
+	STRUCT_PIN(Q, Quaternion, gp_Quaternion);
+	double matrix[12];
+	Internal::GetRotationMatrix(*Q_ptr, matrix);
+	Internal::TransformArray(matrix, Source, Target, false);
+}
+
 Vec Vec::operator * (Vec Left, Trsf Right)
 {
 	return Left.Transformed(Right);
@@ -10,6 +10,7 @@ namespace Macad
 		value struct Ax1;
 		value struct Ax2;
 		value struct Trsf;
+		value struct Quaternion;
 
 		[System::Runtime::InteropServices::StructLayout(System::Runtime::InteropServices::LayoutKind::Sequential, Pack = 8)]
 		public value struct Vec
@@ -89,6 +90,10 @@ namespace Macad
 			Vec Scaled(double S);
 			void Transform(Trsf T);
 			Vec Transformed(Trsf T);
+			static void Transform(cli::array<Vec>^ Values, Trsf T);
+			static void Transform(cli::array<Vec>^ Source, cli::array<Vec>^ Target, Trsf T);
+			static void Transform(cli::array<Vec>^ Values, Quaternion Q);
+			static void Transform(cli::array<Vec>^ Source, cli::array<Vec>^ Target, Quaternion Q);
 
 			//--------------------------------------------------------------------------------------------------
 
@@ -0,0 +1,152 @@
+#include <intrin.h>
+#include <immintrin.h>
+
+#pragma managed(push, off)
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Internal
+		{
+			namespace
+			{
+				bool _DetectAvx2()
+				{
+					int info[4];
+					__cpuid(info, 0);
+					if (info[0] < 7)
+						return false;
+
+					// AVX and FMA support, and the OS saves the YMM registers
+					__cpuid(info, 1);
+					const int required = (1 << 12) | (1 << 27) | (1 << 28);
+					if ((info[2] & required) != required)
+						return false;
+					if ((_xgetbv(0) & 0x6) != 0x6)
+						return false;
+
+					__cpuidex(info, 7, 0);
+					return (info[1] & (1 << 5)) != 0;
+				}
+
+				const bool _HasAvx2 = _DetectAvx2();
+
+				//--------------------------------------------------------------------------------------------------
+
+				void _TransformXYZScalar(const double* m, const double* source, double* target, int count)
+				{
+					for (int i = 0; i < count; i++, source += 3, target += 3)
+					{
+						const double x = source[0], y = source[1], z = source[2];
+						target[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+						target[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+						target[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+					}
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void _TransformXYScalar(const double* m, const double* source, double* target, int count)
+				{
+					for (int i = 0; i < count; i++, source += 2, target += 2)
+					{
+						const double x = source[0], y = source[1];
+						target[0] = m[0] * x + m[1] * y + m[2];
+						target[1] = m[3] * x + m[4] * y + m[5];
+					}
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void _TransformXYZAvx2(const double* m, const double* source, double* target, int count)
+				{
+					const __m256d m00 = _mm256_set1_pd(m[0]), m01 = _mm256_set1_pd(m[1]), m02 = _mm256_set1_pd(m[2]), m03 = _mm256_set1_pd(m[3]);
+					const __m256d m10 = _mm256_set1_pd(m[4]), m11 = _mm256_set1_pd(m[5]), m12 = _mm256_set1_pd(m[6]), m13 = _mm256_set1_pd(m[7]);
+					const __m256d m20 = _mm256_set1_pd(m[8]), m21 = _mm256_set1_pd(m[9]), m22 = _mm256_set1_pd(m[10]), m23 = _mm256_set1_pd(m[11]);
+
+					// Four points per iteration, deinterleaved from xyz triples into one register per coordinate
+					int i = 0;
+					for (; i + 4 <= count; i += 4, source += 12, target += 12)
+					{
+						const __m256d v0 = _mm256_loadu_pd(source);     // x0 y0 z0 x1
+						const __m256d v1 = _mm256_loadu_pd(source + 4); // y1 z1 x2 y2
+						const __m256d v2 = _mm256_loadu_pd(source + 8); // z2 x3 y3 z3
+
+						const __m256d a = _mm256_blend_pd(v0, v1, 0b1100);         // x0 y0 x2 y2
+						const __m256d b = _mm256_permute2f128_pd(v0, v2, 0x21);    // z0 x1 z2 x3
+						const __m256d c = _mm256_blend_pd(v1, v2, 0b1100);         // y1 z1 y3 z3
+						const __m256d x = _mm256_blend_pd(a, b, 0b1010);
+						const __m256d y = _mm256_shuffle_pd(a, c, 0b0101);
+						const __m256d z = _mm256_blend_pd(b, c, 0b1010);
+
+						const __m256d tx = _mm256_fmadd_pd(m02, z, _mm256_fmadd_pd(m01, y, _mm256_fmadd_pd(m00, x, m03)));
+						const __m256d ty = _mm256_fmadd_pd(m12, z, _mm256_fmadd_pd(m11, y, _mm256_fmadd_pd(m10, x, m13)));
+						const __m256d tz = _mm256_fmadd_pd(m22, z, _mm256_fmadd_pd(m21, y, _mm256_fmadd_pd(m20, x, m23)));
+
+						const __m256d ta = _mm256_unpacklo_pd(tx, ty);             // x0 y0 x2 y2
+						const __m256d tb = _mm256_blend_pd(tz, tx, 0b1010);        // z0 x1 z2 x3
+						const __m256d tc = _mm256_unpackhi_pd(ty, tz);             // y1 z1 y3 z3
+						_mm256_storeu_pd(target, _mm256_permute2f128_pd(ta, tb, 0x20));
+						_mm256_storeu_pd(target + 4, _mm256_blend_pd(ta, tc, 0b0011));
+						_mm256_storeu_pd(target + 8, _mm256_permute2f128_pd(tb, tc, 0x31));
+					}
+
+					_TransformXYZScalar(m, source, target, count - i);
+				}
+
+				//--------------------------------------------------------------------------------------------------
+
+				void _TransformXYAvx2(const double* m, const double* source, double* target, int count)
+				{
+					// Two points per register, the matrix columns are repeated for each of them
+					const __m256d cx = _mm256_setr_pd(m[0], m[3], m[0], m[3]);
+					const __m256d cy = _mm256_setr_pd(m[1], m[4], m[1], m[4]);
+					const __m256d ct = _mm256_setr_pd(m[2], m[5], m[2], m[5]);
+
+					int i = 0;
+					for (; i + 4 <= count; i += 4, source += 8, target += 8)
+					{
+						const __m256d v0 = _mm256_loadu_pd(source);
+						const __m256d v1 = _mm256_loadu_pd(source + 4);
+						const __m256d r0 = _mm256_fmadd_pd(cy, _mm256_permute_pd(v0, 0xF), _mm256_fmadd_pd(cx, _mm256_movedup_pd(v0), ct));
+						const __m256d r1 = _mm256_fmadd_pd(cy, _mm256_permute_pd(v1, 0xF), _mm256_fmadd_pd(cx, _mm256_movedup_pd(v1), ct));
+						_mm256_storeu_pd(target, r0);
+						_mm256_storeu_pd(target + 4, r1);
+					}
+
+					_TransformXYScalar(m, source, target, count - i);
+				}
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			void TransformXYZ(const double* matrix, const double* source, double* target, int count)
+			{
+				if (_HasAvx2)
+					_TransformXYZAvx2(matrix, source, target, count);
+				else
+					_TransformXYZScalar(matrix, source, target, count);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			void TransformXY(const double* matrix, const double* source, double* target, int count)
+			{
+				if (_HasAvx2)
+					_TransformXYAvx2(matrix, source, target, count);
+				else
+					_TransformXYScalar(matrix, source, target, count);
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			bool IsTransformAccelerated()
+			{
+				return _HasAvx2;
+			}
+		}
+	}
+}
+
+#pragma managed(pop)
@@ -0,0 +1,104 @@
+#pragma once
+
+// Native kernels to transform arrays of value types with one call. The matrix is passed
+// row-major, 3x4 for 3D (linear part and translation) and 2x3 for 2D. Point, vector and
+// direction arrays are transformed by the same kernel, only the matrix differs.
+
+namespace Macad
+{
+	namespace Occt
+	{
+		namespace Internal
+		{
+			void TransformXYZ(const double* matrix, const double* source, double* target, int count);
+			void TransformXY(const double* matrix, const double* source, double* target, int count);
+			bool IsTransformAccelerated();
+
+			//--------------------------------------------------------------------------------------------------
+
+			inline void GetPointMatrix(const ::gp_Trsf& trsf, double* matrix)
+			{
+				for (int row = 0; row < 3; row++)
+					for (int col = 0; col < 4; col++)
+						matrix[row * 4 + col] = trsf.Value(row + 1, col + 1);
+			}
+
+			inline void GetVectorMatrix(const ::gp_Trsf& trsf, double* matrix)
+			{
+				GetPointMatrix(trsf, matrix);
+				matrix[3] = matrix[7] = matrix[11] = 0.0;
+			}
+
+			inline void GetDirectionMatrix(const ::gp_Trsf& trsf, double* matrix)
+			{
+				// Directions are not scaled, only reversed by negative scale factors
+				const ::gp_Mat& mat = trsf.HVectorialPart();
+				const double sign = trsf.ScaleFactor() < 0.0 ? -1.0 : 1.0;
+				for (int row = 0; row < 3; row++)
+				{
+					for (int col = 0; col < 3; col++)
+						matrix[row * 4 + col] = mat.Value(row + 1, col + 1) * sign;
+					matrix[row * 4 + 3] = 0.0;
+				}
+			}
+
+			inline void GetRotationMatrix(const ::gp_Quaternion& quaternion, double* matrix)
+			{
+				const ::gp_Mat mat = quaternion.GetMatrix();
+				for (int row = 0; row < 3; row++)
+				{
+					for (int col = 0; col < 3; col++)
+						matrix[row * 4 + col] = mat.Value(row + 1, col + 1);
+					matrix[row * 4 + 3] = 0.0;
+				}
+			}
+
+			inline void GetPointMatrix(const ::gp_Trsf2d& trsf, double* matrix)
+			{
+				for (int row = 0; row < 2; row++)
+					for (int col = 0; col < 3; col++)
+						matrix[row * 3 + col] = trsf.Value(row + 1, col + 1);
+			}
+
+			inline void GetVectorMatrix(const ::gp_Trsf2d& trsf, double* matrix)
+			{
+				GetPointMatrix(trsf, matrix);
+				matrix[2] = matrix[5] = 0.0;
+			}
+
+			inline void GetDirectionMatrix(const ::gp_Trsf2d& trsf, double* matrix)
+			{
+				const ::gp_Mat2d& mat = trsf.HVectorialPart();
+				const double sign = trsf.ScaleFactor() < 0.0 ? -1.0 : 1.0;
+				for (int row = 0; row < 2; row++)
+				{
+					for (int col = 0; col < 2; col++)
+						matrix[row * 3 + col] = mat.Value(row + 1, col + 1) * sign;
+					matrix[row * 3 + 2] = 0.0;
+				}
+			}
+
+			//--------------------------------------------------------------------------------------------------
+
+			template<typename T>
+			void TransformArray(const double* matrix, cli::array<T>^ source, cli::array<T>^ target, bool is2d)
+			{
+				if (source == nullptr)
+					throw gcnew System::ArgumentNullException("Source");
+				if (target == nullptr)
+					throw gcnew System::ArgumentNullException("Target");
+				if (target->Length < source->Length)
+					throw gcnew System::ArgumentException("Target array is smaller than the source array.", "Target");
+				if (source->Length == 0)
+					return;
+
+				pin_ptr<T> sourcePtr = &source[0];
+				pin_ptr<T> targetPtr = &target[0];
+				if (is2d)
+					TransformXY(matrix, reinterpret_cast<const double*>(sourcePtr), reinterpret_cast<double*>(targetPtr), source->Length);
+				else
+					TransformXYZ(matrix, reinterpret_cast<const double*>(sourcePtr), reinterpret_cast<double*>(targetPtr), source->Length);
+			}
+		}
+	}
+}
@@ -1,4 +1,6 @@
-﻿using System.IO;
+﻿using System;
+using System.IO;
+using System.Linq;
 using Macad.Test.Utils;
 using Macad.Core;
 using Macad.Core.Geom;
@@ -86,5 +88,65 @@ namespace Macad.Test.Unit.Modeling.Geom
 
         //--------------------------------------------------------------------------------------------------
 
+        [Test]
+        public void AllPlanesAtOnce()
+        {
+            var source = TestData.GetBodyFromBRep(Path.Combine(_BasePath, "TwoLayers_Source.brep"));
+            Assume.That(source?.GetBRep() != null);
+
+            var perPlane = new SliceByPlanes(source.GetBRep(), source.GetBRep().Faces()[0], 7)
+            {
+                Method = SliceByPlanes.SliceMethod.PerPlane
+            };
+            Assert.IsTrue(perPlane.CreateSlices(true));
+            var allPlanes = new SliceByPlanes(source.GetBRep(), source.GetBRep().Faces()[0], 7)
+            {
+                Method = SliceByPlanes.SliceMethod.AllPlanes
+            };
+            Assert.IsTrue(allPlanes.CreateSlices(true));
+
+            Assert.AreEqual(perPlane.Slices.Length, allPlanes.Slices.Length);
+            for (int index = 0; index < perPlane.Slices.Length; index++)
+            {
+                var expected = perPlane.Slices[index];
+                var actual = allPlanes.Slices[index];
+                Assert.AreEqual(expected.CutPlane.Location.Distance(actual.CutPlane.Location), 0.0, 1e-10);
+                Assert.AreEqual(expected.BRep.Faces().Count, actual.BRep.Faces().Count);
+                Assert.AreEqual(expected.BRep.Area(), actual.BRep.Area(), 1e-6);
+                Assert.That(expected.BRep.CenterOfMass().IsEqual(actual.BRep.CenterOfMass(), 1e-6));
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [TestCase(SliceByPlanes.SliceMethod.PerPlane)]
+        [TestCase(SliceByPlanes.SliceMethod.AllPlanes)]
+        public void ThreeLayers(SliceByPlanes.SliceMethod method)
+        {
+            // Box of 20x20x5 with a circle of radius sqrt(50) raised by 10
+            var source = TestGeomGenerator.CreateImprint().Body;
+            Assume.That(source?.GetBRep() != null);
+            (source.Shape as Imprint).Depth = 10;
+
+            var slicer = new SliceByPlanes(source.GetBRep(), source.GetBRep().Faces()[4], 3)
+            {
+                Method = method
+            };
+            Assert.IsTrue(slicer.CreateSlices(true));
+            Assert.AreEqual(3, slicer.Slices.Length);
+            Assert.AreEqual(15.0, slicer.SliceThickness, 1e-10);
+
+            var heights = slicer.Slices.Select(slice => slice.CutPlane.Location.Z).OrderBy(z => z).ToArray();
+            Assert.That(heights, Is.EqualTo(new[] { 2.5, 7.5, 12.5 }).Within(1e-10));
+            foreach (var slice in slicer.Slices)
+            {
+                var expectedArea = slice.CutPlane.Location.Z < 5.0 ? 20.0 * 20.0 : 50.0 * Math.PI;
+                Assert.AreEqual(1, slice.BRep.Faces().Count);
+                Assert.AreEqual(expectedArea, slice.BRep.Area(), 1e-6);
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
     }
 }
\ No newline at end of file
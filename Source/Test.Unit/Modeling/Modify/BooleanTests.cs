@@ -1,6 +1,11 @@
-﻿using System.IO;
+﻿using System.Diagnostics;
+using System.IO;
 using Macad.Test.Utils;
+using Macad.Core;
 using Macad.Core.Shapes;
+using Macad.Core.Topology;
+using Macad.Occt;
+using Macad.Occt.Helper;
 using NUnit.Framework;
 
 namespace Macad.Test.Unit.Modeling.Modify
@@ -51,5 +56,136 @@ namespace Macad.Test.Unit.Modeling.Modify
 
         //--------------------------------------------------------------------------------------------------
 
+        [Test]
+        public void FuzzyValue()
+        {
+            // The operand has a gap of 5e-6 to the target
+            var target = Body.Create(new Box { DimensionX = 10, DimensionY = 10, DimensionZ = 10 });
+            var operandBody = Body.Create(new Box { DimensionX = 10, DimensionY = 10, DimensionZ = 10 });
+            operandBody.Position = new Pnt(10.000005, 0, 0);
+
+            var boolOp = BooleanFuse.Create(target, new BodyShapeOperand(operandBody));
+            Assert.IsTrue(boolOp.Make(Shape.MakeFlags.None));
+            Assert.AreEqual(2, boolOp.GetBRep().Solids().Count);
+
+            boolOp.FuzzyValue = 1e-5;
+            Assert.IsTrue(boolOp.Make(Shape.MakeFlags.None));
+            Assert.AreEqual(1, boolOp.GetBRep().Solids().Count);
+
+            // Global setting is used if not set on the modifier
+            boolOp.FuzzyValue = null;
+            var parameters = CoreContext.Current.Parameters.Get<BooleanParameterSet>();
+            parameters.FuzzyValue = 1e-5;
+            try
+            {
+                Assert.IsTrue(boolOp.Make(Shape.MakeFlags.None));
+                Assert.AreEqual(1, boolOp.GetBRep().Solids().Count);
+            }
+            finally
+            {
+                parameters.ResetValue(nameof(BooleanParameterSet.FuzzyValue));
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void NonDestructive()
+        {
+            var box = new Box { DimensionX = 10, DimensionY = 10, DimensionZ = 10 };
+            var target = Body.Create(box);
+            var cylinder = new Cylinder { Radius = 3, Height = 20 };
+            var operandBody = Body.Create(cylinder);
+            operandBody.Position = new Pnt(5, 5, -5);
+
+            var targetBytes = BRepExchange.WriteASCII(box.GetBRep(), false);
+            var operandBytes = BRepExchange.WriteASCII(cylinder.GetBRep(), false);
+
+            var boolOp = BooleanCut.Create(target, new BodyShapeOperand(operandBody));
+            boolOp.NonDestructive = true;
+            Assert.IsTrue(boolOp.Make(Shape.MakeFlags.None));
+            Assert.AreEqual(1, boolOp.GetBRep().Solids().Count);
+
+            // Arguments are left as they were
+            CollectionAssert.AreEqual(targetBytes, BRepExchange.WriteASCII(box.GetBRep(), false));
+            CollectionAssert.AreEqual(operandBytes, BRepExchange.WriteASCII(cylinder.GetBRep(), false));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        [TestCase(BooleanGlueMode.Shift)]
+        [TestCase(BooleanGlueMode.Full)]
+        public void GlueMode(BooleanGlueMode glueMode)
+        {
+            var reference = _FuseAdjacentBoxes(BooleanGlueMode.Off);
+            var glued = _FuseAdjacentBoxes(glueMode);
+
+            Assert.AreEqual(reference.Solids().Count, glued.Solids().Count);
+            Assert.AreEqual(reference.Faces().Count, glued.Faces().Count);
+            Assert.AreEqual(reference.Edges().Count, glued.Edges().Count);
+
+            var referenceProps = new GProp_GProps();
+            var gluedProps = new GProp_GProps();
+            BRepGProp.VolumeProperties(reference, referenceProps);
+            BRepGProp.VolumeProperties(glued, gluedProps);
+            Assert.AreEqual(referenceProps.Mass(), gluedProps.Mass(), 1e-6);
+            Assert.IsTrue(referenceProps.CentreOfMass().IsEqual(gluedProps.CentreOfMass(), 1e-6));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        TopoDS_Shape _FuseAdjacentBoxes(BooleanGlueMode glueMode)
+        {
+            // The operand shares a coincident face with the target
+            var target = Body.Create(new Box { DimensionX = 10, DimensionY = 10, DimensionZ = 10 });
+            var operandBody = Body.Create(new Box { DimensionX = 10, DimensionY = 10, DimensionZ = 10 });
+            operandBody.Position = new Pnt(10, 0, 0);
+
+            var boolOp = BooleanFuse.Create(target, new BodyShapeOperand(operandBody));
+            boolOp.GlueMode = glueMode;
+            Assert.IsTrue(boolOp.Make(Shape.MakeFlags.None));
+            return boolOp.GetBRep();
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        [TestCase(4)]
+        [TestCase(16)]
+        [TestCase(64)]
+        public void OptionsBenchmark(int toolCount)
+        {
+            TestContext.WriteLine($"{"Operation",-10} {"Tools",6} {"Parallel",9} {"OBB",6} {"Time [ms]",10}");
+            foreach (var isCut in new[] { true, false })
+            {
+                foreach (var (runParallel, useOBB) in new[] { (false, false), (true, false), (true, true) })
+                {
+                    // Plate with a grid of pins
+                    var target = Body.Create(new Box { DimensionX = 200, DimensionY = 200, DimensionZ = 5 });
+                    var gridSize = (int)System.Math.Ceiling(System.Math.Sqrt(toolCount));
+                    var operands = new IShapeOperand[toolCount];
+                    for (int i = 0; i < toolCount; i++)
+                    {
+                        var pin = Body.Create(new Cylinder { Radius = 2, Height = 10 });
+                        pin.Position = new Pnt(10 + i % gridSize * 180.0 / gridSize, 10 + i / gridSize * 180.0 / gridSize, -2);
+                        operands[i] = new BodyShapeOperand(pin);
+                    }
+
+                    BooleanBase boolOp = isCut ? BooleanCut.Create(target, operands) : BooleanFuse.Create(target, operands);
+                    boolOp.RunParallel = runParallel;
+                    boolOp.UseOBB = useOBB;
+
+                    var stopwatch = Stopwatch.StartNew();
+                    Assert.IsTrue(boolOp.Make(Shape.MakeFlags.None));
+                    stopwatch.Stop();
+
+                    TestContext.WriteLine($"{(isCut ? "Cut" : "Fuse"),-10} {toolCount,6} {runParallel,9} {useOBB,6} {stopwatch.Elapsed.TotalMilliseconds,10:F1}");
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
     }
 }
\ No newline at end of file
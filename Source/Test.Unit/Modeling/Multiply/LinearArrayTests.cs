@@ -1,4 +1,5 @@
-﻿using System.IO;
+﻿using System.Diagnostics;
+using System.IO;
 using Macad.Test.Utils;
 using Macad.Core;
 using Macad.Core.Shapes;
@@ -419,6 +420,57 @@ namespace Macad.Test.Unit.Modeling.Multiply
 
         //--------------------------------------------------------------------------------------------------
 
+        [Test]
+        public void SolidInstancesShareGeometry()
+        {
+            var solid = TestGeomGenerator.CreateImprint();
+
+            var array = LinearArray.Create(solid.Body);
+            array.Quantity1 = 4;
+            array.Distance1 = 25;
+            array.Quantity2 = 3;
+            array.Distance2 = 30;
+            Assert.IsTrue(array.Make(Shape.MakeFlags.None));
+
+            // All instances are located copies of the source shape
+            var source = solid.GetBRep();
+            var instances = array.GetBRep().Solids();
+            Assert.AreEqual(12, instances.Count);
+            foreach (var instance in instances)
+            {
+                Assert.IsTrue(instance.IsPartner(source.Solids()[0]));
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        public void SolidManyInstancesBenchmark()
+        {
+            var solid = TestGeomGenerator.CreateImprint();
+
+            var array = LinearArray.Create(solid.Body);
+            array.Quantity1 = 100;
+            array.Distance1 = 25;
+            array.Quantity2 = 100;
+            array.Distance2 = 30;
+            Assert.IsTrue(array.Make(Shape.MakeFlags.None));
+
+            var stopwatch = Stopwatch.StartNew();
+            const int iterations = 10;
+            for (int i = 0; i < iterations; i++)
+            {
+                array.Invalidate();
+                Assert.IsTrue(array.Make(Shape.MakeFlags.None));
+            }
+            stopwatch.Stop();
+
+            Assert.AreEqual(10000, array.GetBRep().Solids().Count);
+            TestContext.WriteLine($"Rebuild of 10000 instances: {stopwatch.Elapsed.TotalMilliseconds / iterations:F1} ms");
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         #endregion
 
     }
@@ -0,0 +1,264 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using Macad.Core.Shapes;
+using Macad.Exchange.Dxf;
+using Macad.Occt;
+using Macad.SketchSolve;
+using NUnit.Framework;
+
+namespace Macad.Test.Unit.Modeling.Primitives2D
+{
+    [TestFixture]
+    public class SketchSolverBenchmarkTests
+    {
+        static readonly Algorithm[] _Algorithms = { Algorithm.Bfgs, Algorithm.LevenbergMarquardt, Algorithm.LimitedMemoryBfgs };
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        [TestCase(1)]
+        [TestCase(10)]
+        [TestCase(50)]
+        public void RectangleGrid(int size)
+        {
+            _Run($"Grid {size}x{size}", () => _CreateRectangleGrid(size));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        [TestCase(12)]
+        [TestCase(48)]
+        public void Gear(int teeth)
+        {
+            _Run($"Gear {teeth}", () => _CreateGear(teeth));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        [TestCase(@"Exchange\Dxf\ExportDrawing\Complex_AC1015.dxf")]
+        [TestCase(@"Exchange\Dxf\ImportSketch\ImperialScale_Source.dxf")]
+        public void DxfImport(string fileName)
+        {
+            _Run(Path.GetFileName(fileName), () => _CreateFromDxf(fileName));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        #region Bounds
+
+        // Counters and residual are deterministic for a given corpus, other than the wall time. Iterations are
+        // the maximum over the components, evaluations are summed up. The residual sums the error of every
+        // component, each of which is below the precise limit of 1e-12.
+
+        [Test]
+        [TestCase(1, Algorithm.Bfgs, 50, 500, 100, 1e-6)]
+        [TestCase(1, Algorithm.LevenbergMarquardt, 20, 100, 40, 1e-6)]
+        [TestCase(1, Algorithm.LimitedMemoryBfgs, 100, 1000, 200, 1e-6)]
+        [TestCase(10, Algorithm.Bfgs, 50, 50000, 10000, 1e-5)]
+        [TestCase(10, Algorithm.LevenbergMarquardt, 20, 10000, 4000, 1e-5)]
+        [TestCase(10, Algorithm.LimitedMemoryBfgs, 100, 100000, 20000, 1e-5)]
+        [TestCase(50, Algorithm.Bfgs, 50, 1250000, 250000, 5e-5)]
+        [TestCase(50, Algorithm.LevenbergMarquardt, 20, 250000, 100000, 5e-5)]
+        [TestCase(50, Algorithm.LimitedMemoryBfgs, 100, 2500000, 500000, 5e-5)]
+        public void RectangleGridBounds(int size, Algorithm algorithm, int maxIterations, int maxFunctionEvaluations, int maxGradientEvaluations, double maxResidual)
+        {
+            _AssertBounds(_CreateRectangleGrid(size), algorithm, maxIterations, maxFunctionEvaluations, maxGradientEvaluations, maxResidual);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        [TestCase(12, Algorithm.Bfgs, 2000, 20000, 4000, 2e-6)]
+        [TestCase(12, Algorithm.LevenbergMarquardt, 200, 1000, 400, 2e-6)]
+        [TestCase(12, Algorithm.LimitedMemoryBfgs, 4000, 40000, 8000, 2e-6)]
+        [TestCase(48, Algorithm.Bfgs, 8000, 80000, 16000, 2e-6)]
+        [TestCase(48, Algorithm.LevenbergMarquardt, 400, 2000, 800, 2e-6)]
+        [TestCase(48, Algorithm.LimitedMemoryBfgs, 16000, 160000, 32000, 2e-6)]
+        public void GearBounds(int teeth, Algorithm algorithm, int maxIterations, int maxFunctionEvaluations, int maxGradientEvaluations, double maxResidual)
+        {
+            _AssertBounds(_CreateGear(teeth), algorithm, maxIterations, maxFunctionEvaluations, maxGradientEvaluations, maxResidual);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        [TestCase(@"Exchange\Dxf\ExportDrawing\Complex_AC1015.dxf", Algorithm.Bfgs, 500, 200000, 40000, 2e-5)]
+        [TestCase(@"Exchange\Dxf\ExportDrawing\Complex_AC1015.dxf", Algorithm.LevenbergMarquardt, 100, 20000, 10000, 2e-5)]
+        [TestCase(@"Exchange\Dxf\ExportDrawing\Complex_AC1015.dxf", Algorithm.LimitedMemoryBfgs, 1000, 400000, 80000, 2e-5)]
+        [TestCase(@"Exchange\Dxf\ImportSketch\ImperialScale_Source.dxf", Algorithm.Bfgs, 500, 5000, 1000, 2e-6)]
+        [TestCase(@"Exchange\Dxf\ImportSketch\ImperialScale_Source.dxf", Algorithm.LevenbergMarquardt, 100, 500, 200, 2e-6)]
+        [TestCase(@"Exchange\Dxf\ImportSketch\ImperialScale_Source.dxf", Algorithm.LimitedMemoryBfgs, 1000, 10000, 2000, 2e-6)]
+        public void DxfImportBounds(string fileName, Algorithm algorithm, int maxIterations, int maxFunctionEvaluations, int maxGradientEvaluations, double maxResidual)
+        {
+            _AssertBounds(_CreateFromDxf(fileName), algorithm, maxIterations, maxFunctionEvaluations, maxGradientEvaluations, maxResidual);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _AssertBounds(Sketch sketch, Algorithm algorithm, int maxIterations, int maxFunctionEvaluations, int maxGradientEvaluations, double maxResidual)
+        {
+            Assert.IsTrue(SketchConstraintSolver.Solve(sketch, true, algorithm, out var statistics));
+            Assert.Greater(statistics.ConstraintCount, 0);
+            Assert.LessOrEqual(statistics.Iterations, maxIterations, "Iterations");
+            Assert.LessOrEqual(statistics.FunctionEvaluations, maxFunctionEvaluations, "Function evaluations");
+            Assert.LessOrEqual(statistics.GradientEvaluations, maxGradientEvaluations, "Gradient evaluations");
+            Assert.LessOrEqual(statistics.Residual, maxResidual, "Residual");
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        #endregion
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _Run(string name, Func<Sketch> createSketch)
+        {
+            TestContext.WriteLine($"{"Case",-34} {"Algorithm",-20} {"Vars",6} {"Cons",6} {"Iter",7} {"F-Eval",9} {"G-Eval",9} {"Residual",10} {"Time [ms]",10}");
+            foreach (var algorithm in _Algorithms)
+            {
+                var sketch = createSketch();
+                var success = SketchConstraintSolver.Solve(sketch, true, algorithm, out var statistics);
+                TestContext.WriteLine($"{name,-34} {algorithm,-20} {statistics.VariableCount,6} {statistics.ConstraintCount,6} {statistics.Iterations,7} "
+                                      + $"{statistics.FunctionEvaluations,9} {statistics.GradientEvaluations,9} {statistics.Residual,10:E2} {statistics.Time.TotalMilliseconds,10:F2}"
+                                      + (success ? "" : "  FAILED"));
+
+                Assert.IsTrue(success, $"{name} could not be solved with {algorithm}.");
+                Assert.Greater(statistics.ConstraintCount, 0);
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        #region Corpus
+
+        static Sketch _CreateRectangleGrid(int size)
+        {
+            var sketch = Sketch.Create();
+            for (int row = 0; row < size; row++)
+            {
+                for (int column = 0; column < size; column++)
+                {
+                    var x = column * 30.0;
+                    var y = row * 30.0;
+                    var p1 = sketch.AddPoint(new Pnt2d(x, y));
+                    var p2 = sketch.AddPoint(new Pnt2d(x + 20, y));
+                    var p3 = sketch.AddPoint(new Pnt2d(x + 20, y + 10));
+                    var p4 = sketch.AddPoint(new Pnt2d(x, y + 10));
+                    var s1 = sketch.AddSegment(new SketchSegmentLine(p1, p2));
+                    var s2 = sketch.AddSegment(new SketchSegmentLine(p2, p3));
+                    var s3 = sketch.AddSegment(new SketchSegmentLine(p3, p4));
+                    var s4 = sketch.AddSegment(new SketchSegmentLine(p4, p1));
+                    sketch.AddConstraint(new SketchConstraintHorizontal(s1));
+                    sketch.AddConstraint(new SketchConstraintVertical(s2));
+                    sketch.AddConstraint(new SketchConstraintHorizontal(s3));
+                    sketch.AddConstraint(new SketchConstraintVertical(s4));
+                    sketch.AddConstraint(new SketchConstraintLength(s1, 22.0));
+                    sketch.AddConstraint(new SketchConstraintLength(s2, 12.0));
+                }
+            }
+            _Perturb(sketch, 1.0);
+            return sketch;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        static Sketch _CreateGear(int teeth)
+        {
+            const double rootRadius = 40.0;
+            const double tipRadius = 48.0;
+
+            // Every tooth is made of a root land, a rising flank, a tip land and a falling flank
+            var sketch = Sketch.Create();
+            var points = new List<int>();
+            var pitch = Math.PI * 2 / teeth;
+            for (int tooth = 0; tooth < teeth; tooth++)
+            {
+                var angle = tooth * pitch;
+                points.Add(sketch.AddPoint(new Pnt2d(rootRadius * Math.Cos(angle), rootRadius * Math.Sin(angle))));
+                points.Add(sketch.AddPoint(new Pnt2d(rootRadius * Math.Cos(angle + pitch * 0.3), rootRadius * Math.Sin(angle + pitch * 0.3))));
+                points.Add(sketch.AddPoint(new Pnt2d(tipRadius * Math.Cos(angle + pitch * 0.45), tipRadius * Math.Sin(angle + pitch * 0.45))));
+                points.Add(sketch.AddPoint(new Pnt2d(tipRadius * Math.Cos(angle + pitch * 0.85), tipRadius * Math.Sin(angle + pitch * 0.85))));
+            }
+
+            var segments = new List<int>();
+            for (int i = 0; i < points.Count; i++)
+            {
+                segments.Add(sketch.AddSegment(new SketchSegmentLine(points[i], points[(i + 1) % points.Count])));
+            }
+
+            // The first tooth is dimensioned, all others are equal to it
+            for (int i = 0; i < 4; i++)
+            {
+                var line = (SketchSegmentLine)sketch.Segments[segments[i]];
+                sketch.AddConstraint(new SketchConstraintLength(segments[i], sketch.Points[line.StartPoint].Distance(sketch.Points[line.EndPoint]) * 1.05));
+            }
+            for (int i = 4; i < segments.Count; i++)
+            {
+                sketch.AddConstraint(new SketchConstraintEqual(segments[i % 4], segments[i]));
+            }
+
+            // Bore
+            var center = sketch.AddPoint(new Pnt2d(0, 0));
+            var rim = sketch.AddPoint(new Pnt2d(15, 0));
+            var bore = sketch.AddSegment(new SketchSegmentCircle(center, rim));
+            sketch.AddConstraint(new SketchConstraintRadius(bore, 12.0));
+
+            _Perturb(sketch, 0.5);
+            return sketch;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        static Sketch _CreateFromDxf(string fileName)
+        {
+            var bytes = Macad.Test.Utils.TestData.GetTestData(fileName);
+            Assert.IsTrue(DxfSketchImporter.Import(new MemoryStream(bytes), out var points, out var segments));
+
+            var sketch = Sketch.Create();
+            sketch.AddElements(points, null, segments, null);
+
+            // Imported drawings carry no constraints, derive them from the geometry like a user would do
+            foreach (var segmentKvp in sketch.Segments.ToArray())
+            {
+                if (!(segmentKvp.Value is SketchSegmentLine line))
+                    continue;
+
+                var index = segmentKvp.Key;
+                var start = sketch.Points[line.StartPoint];
+                var end = sketch.Points[line.EndPoint];
+                if (Math.Abs(start.Y - end.Y) < 0.001)
+                {
+                    sketch.AddConstraint(new SketchConstraintHorizontal(index));
+                }
+                else if (Math.Abs(start.X - end.X) < 0.001)
+                {
+                    sketch.AddConstraint(new SketchConstraintVertical(index));
+                }
+                sketch.AddConstraint(new SketchConstraintLength(index, start.Distance(end)));
+            }
+
+            _Perturb(sketch, 0.1);
+            return sketch;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        static void _Perturb(Sketch sketch, double amount)
+        {
+            // Deterministic, so that runs can be compared
+            foreach (var index in sketch.Points.Keys.ToArray())
+            {
+                var point = sketch.Points[index];
+                sketch.Points[index] = new Pnt2d(point.X + amount * Math.Sin(index * 1.7), point.Y + amount * Math.Cos(index * 2.3));
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        #endregion
+    }
+}
@@ -0,0 +1,405 @@
+﻿using System;
+using System.Collections.Generic;
+using Macad.Core.Shapes;
+using Macad.Occt;
+using Macad.SketchSolve;
+using NUnit.Framework;
+using SolverConstraint = Macad.SketchSolve.Constraint;
+
+namespace Macad.Test.Unit.Modeling.Primitives2D
+{
+    [TestFixture]
+    public class SketchSolverTests
+    {
+        const double MaxLengthDelta = 0.0001;
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void IndependentProfiles()
+        {
+            var sketch = Sketch.Create();
+            var p1 = sketch.AddPoint(new Pnt2d(0, 0));
+            var p2 = sketch.AddPoint(new Pnt2d(10, 1));
+            var s1 = sketch.AddSegment(new SketchSegmentLine(p1, p2));
+            var p3 = sketch.AddPoint(new Pnt2d(20, 0));
+            var p4 = sketch.AddPoint(new Pnt2d(25, 8));
+            var s2 = sketch.AddSegment(new SketchSegmentLine(p3, p4));
+            sketch.AddConstraint(new SketchConstraintHorizontal(s1));
+            sketch.AddConstraint(new SketchConstraintLength(s1, 15.0));
+            sketch.AddConstraint(new SketchConstraintVertical(s2));
+            sketch.AddConstraint(new SketchConstraintLength(s2, 5.0));
+
+            Assert.IsTrue(sketch.SolveConstraints(true));
+            Assert.AreEqual(sketch.Points[p1].Y, sketch.Points[p2].Y, MaxLengthDelta);
+            Assert.AreEqual(15.0, sketch.Points[p1].Distance(sketch.Points[p2]), MaxLengthDelta);
+            Assert.AreEqual(sketch.Points[p3].X, sketch.Points[p4].X, MaxLengthDelta);
+            Assert.AreEqual(5.0, sketch.Points[p3].Distance(sketch.Points[p4]), MaxLengthDelta);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void IndependentProfiles_OneConflicting()
+        {
+            var sketch = Sketch.Create();
+            var p1 = sketch.AddPoint(new Pnt2d(0, 0));
+            var p2 = sketch.AddPoint(new Pnt2d(10, 1));
+            var s1 = sketch.AddSegment(new SketchSegmentLine(p1, p2));
+            var p3 = sketch.AddPoint(new Pnt2d(20, 0));
+            var p4 = sketch.AddPoint(new Pnt2d(25, 8));
+            var s2 = sketch.AddSegment(new SketchSegmentLine(p3, p4));
+            sketch.AddConstraint(new SketchConstraintHorizontal(s1));
+            sketch.AddConstraint(new SketchConstraintLength(s2, 5.0));
+            sketch.AddConstraint(new SketchConstraintLength(s2, 10.0));
+
+            // The whole sketch is rejected, also the solvable profile is left untouched
+            Assert.IsFalse(sketch.SolveConstraints(true));
+            Assert.AreEqual(1.0, sketch.Points[p2].Y);
+            Assert.AreEqual(8.0, sketch.Points[p4].Y);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void SessionDragging()
+        {
+            var sketch = Sketch.Create();
+            var p1 = sketch.AddPoint(new Pnt2d(0, 0));
+            var p2 = sketch.AddPoint(new Pnt2d(10, 1));
+            var s1 = sketch.AddSegment(new SketchSegmentLine(p1, p2));
+            var p3 = sketch.AddPoint(new Pnt2d(20, 0));
+            var p4 = sketch.AddPoint(new Pnt2d(25, 8));
+            var s2 = sketch.AddSegment(new SketchSegmentLine(p3, p4));
+            sketch.AddConstraint(new SketchConstraintHorizontal(s1));
+            sketch.AddConstraint(new SketchConstraintLength(s1, 15.0));
+            sketch.AddConstraint(new SketchConstraintVertical(s2));
+
+            var points = new Dictionary<int, Pnt2d>(sketch.Points);
+            using var solver = SketchConstraintSolver.CreateSession(sketch, points);
+            for (int step = 1; step <= 5; step++)
+            {
+                points[p2] = new Pnt2d(10 + step, 1 + step);
+                Assert.IsTrue(solver.SolveSession(points, new[] { p2 }, false));
+                Assert.AreEqual(points[p1].Y, points[p2].Y, MaxLengthDelta);
+                Assert.AreEqual(15.0, points[p1].Distance(points[p2]), MaxLengthDelta);
+            }
+
+            Assert.AreEqual(points[p3].X, points[p4].X, MaxLengthDelta);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        public void EvaluationBenchmark()
+        {
+            var parameters = new List<Parameter>();
+            var constraints = new List<SolverConstraint>();
+            for (int i = 0; i < 1000; i++)
+            {
+                _AddRectangle(parameters, constraints, i * 30.0, 0.0);
+            }
+
+            var rate = Solver.MeasureEvaluations(parameters, constraints, 10000, false);
+            var batchRate = Solver.MeasureEvaluations(parameters, constraints, 10000, true);
+            TestContext.WriteLine($"{constraints.Count} constraints: {rate:F0} evaluations/s, batched {batchRate:F0} evaluations/s");
+            Assert.Greater(rate, 0.0);
+            Assert.Greater(batchRate, 0.0);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void BatchEvaluation()
+        {
+            // Mixes constraint types with and without batch kernels
+            var parameters = new List<Parameter>();
+            var constraints = new List<SolverConstraint>();
+            _AddLinkage(parameters, constraints, 5);
+            for (int i = 0; i < 300; i++)
+            {
+                _AddRectangle(parameters, constraints, i * 30.0, 0.0);
+            }
+
+            var error = Solver.GetError(parameters, constraints, false);
+            Assert.Greater(error, 0.0);
+            Assert.AreEqual(error, Solver.GetError(parameters, constraints, true));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void Statistics()
+        {
+            var parameters = new List<Parameter>();
+            var constraints = new List<SolverConstraint>();
+            for (int i = 0; i < 3; i++)
+            {
+                _AddRectangle(parameters, constraints, i * 30.0, 0.0);
+            }
+
+            foreach (var algorithm in new[] { Algorithm.Bfgs, Algorithm.LevenbergMarquardt, Algorithm.LimitedMemoryBfgs })
+            {
+                var result = Solver.Solve(parameters, constraints, true, algorithm, out var statistics);
+                Assert.AreEqual(Result.Success, result, algorithm.ToString());
+                Assert.AreEqual(3 * 8, statistics.VariableCount, algorithm.ToString());
+                Assert.AreEqual(constraints.Count, statistics.ConstraintCount, algorithm.ToString());
+                Assert.Greater(statistics.FunctionEvaluations, 0, algorithm.ToString());
+                Assert.Less(statistics.Residual, 1e-6, algorithm.ToString());
+                Assert.AreEqual(statistics.Residual * statistics.Residual, statistics.Error, 1e-12, algorithm.ToString());
+                Assert.GreaterOrEqual(statistics.Time, TimeSpan.Zero, algorithm.ToString());
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void PackedConstraintTable()
+        {
+            var parameters = new List<Parameter>();
+            var constraints = new List<SolverConstraint>();
+            _AddLinkage(parameters, constraints, 5);
+            for (int i = 0; i < 3; i++)
+            {
+                _AddRectangle(parameters, constraints, i * 30.0, 0.0);
+            }
+
+            var values = new double[parameters.Count];
+            var usage = new byte[parameters.Count];
+            for (int i = 0; i < parameters.Count; i++)
+            {
+                values[i] = parameters[i].Value;
+                usage[i] = (byte)parameters[i].Usage;
+            }
+            var constraintTable = new int[constraints.Count * SolverConstraint.PackedSize];
+            for (int i = 0; i < constraints.Count; i++)
+            {
+                constraints[i].Pack(constraintTable, i);
+            }
+
+            var packedResult = Solver.Solve(values, usage, constraintTable, true, Algorithm.Bfgs, out var statistics);
+            var result = Solver.Solve(parameters, constraints, true);
+            Assert.AreEqual(Result.Success, result);
+            Assert.AreEqual(Result.Success, packedResult);
+            Assert.AreEqual(constraints.Count, statistics.ConstraintCount);
+            for (int i = 0; i < parameters.Count; i++)
+            {
+                Assert.AreEqual(parameters[i].Value, values[i], 1e-9);
+            }
+
+            constraintTable[1] = values.Length;
+            Assert.Throws<ArgumentOutOfRangeException>(() => Solver.Solve(values, usage, constraintTable, true, Algorithm.Bfgs, out _));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void AnalyzeFreedom()
+        {
+            var sketch = _CreateRectangleSketch(out var segments);
+            var free = sketch.AddPoint(new Pnt2d(30, 30));
+
+            var analysis = SketchConstraintSolver.Analyze(sketch);
+            Assert.AreEqual(3 + 2, analysis.Freedom);
+            Assert.AreEqual(2, analysis.PointFreedom[free]);
+            Assert.IsEmpty(analysis.RedundantConstraints);
+            Assert.IsFalse(analysis.HasConflicts);
+
+            // Fixing one corner leaves only the height
+            sketch.AddConstraint(new SketchConstraintFixed(SketchConstraintFixed.TargetType.Point, ((SketchSegmentLine)sketch.Segments[segments[0]]).StartPoint));
+            analysis = SketchConstraintSolver.Analyze(sketch);
+            Assert.AreEqual(1 + 2, analysis.Freedom);
+            Assert.AreEqual(0, analysis.PointFreedom[((SketchSegmentLine)sketch.Segments[segments[0]]).StartPoint]);
+            Assert.AreEqual(0, analysis.PointFreedom[((SketchSegmentLine)sketch.Segments[segments[0]]).EndPoint]);
+            Assert.AreEqual(1, analysis.PointFreedom[((SketchSegmentLine)sketch.Segments[segments[2]]).StartPoint]);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void AnalyzeRedundant()
+        {
+            var sketch = _CreateRectangleSketch(out var segments);
+            Assert.IsTrue(sketch.SolveConstraints(true));
+
+            var duplicate = new SketchConstraintHorizontal(segments[0]);
+            sketch.AddConstraint(duplicate);
+            var opposite = new SketchConstraintLength(segments[2], 10.0);
+            sketch.AddConstraint(opposite);
+
+            var analysis = SketchConstraintSolver.Analyze(sketch);
+            Assert.AreEqual(3, analysis.Freedom);
+            Assert.That(analysis.RedundantConstraints, Is.EquivalentTo(new SketchConstraint[] { duplicate, opposite }));
+            Assert.IsFalse(analysis.HasConflicts);
+            Assert.IsTrue(sketch.SolveConstraints(true));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void AnalyzeConflicting()
+        {
+            var sketch = _CreateRectangleSketch(out var segments);
+            var conflicting = new SketchConstraintLength(segments[2], 14.0);
+            sketch.AddConstraint(conflicting);
+
+            var analysis = SketchConstraintSolver.Analyze(sketch);
+            Assert.That(analysis.ConflictingConstraints, Is.EquivalentTo(new SketchConstraint[] { conflicting }));
+            Assert.IsEmpty(analysis.RedundantConstraints);
+
+            // A precise solve fails before solving and reports the culprit
+            Assert.IsFalse(sketch.SolveConstraints(true));
+            Assert.IsTrue(sketch.ConstraintSolverFailed);
+            Assert.That(sketch.FailedConstraints, Is.EquivalentTo(new SketchConstraint[] { conflicting }));
+
+            sketch.DeleteConstraint(conflicting);
+            Assert.IsTrue(sketch.SolveConstraints(true));
+            Assert.IsEmpty(sketch.FailedConstraints);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void LevenbergMarquardt()
+        {
+            var parameters = new List<Parameter>();
+            var constraints = new List<SolverConstraint>();
+            _AddLinkage(parameters, constraints, 10);
+
+            var result = Solver.Solve(parameters, constraints, true, Algorithm.LevenbergMarquardt, out var statistics);
+            Assert.AreEqual(Result.Success, result);
+            Assert.Greater(statistics.Iterations, 0);
+            Assert.Less(statistics.Residual, 1e-6);
+            _AssertLineLengths(parameters, constraints, 10.0);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void LimitedMemoryBfgs()
+        {
+            var parameters = new List<Parameter>();
+            var constraints = new List<SolverConstraint>();
+            for (int i = 0; i < 20; i++)
+            {
+                _AddRectangle(parameters, constraints, i * 30.0, 0.0);
+            }
+
+            var result = Solver.Solve(parameters, constraints, true, Algorithm.LimitedMemoryBfgs, 4, out var statistics);
+            Assert.AreEqual(Result.Success, result);
+            Assert.Greater(statistics.Iterations, 0);
+            Assert.Less(statistics.Residual, 1e-6);
+            _AssertLineLengths(parameters, constraints, 10.0);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _AssertLineLengths(List<Parameter> parameters, List<SolverConstraint> constraints, double length)
+        {
+            foreach (var constraint in constraints)
+            {
+                if (constraint.Type != ConstraintType.LineLength)
+                    continue;
+                var p1 = new Pnt2d(parameters[constraint.Line1.P1.X].Value, parameters[constraint.Line1.P1.Y].Value);
+                var p2 = new Pnt2d(parameters[constraint.Line1.P2.X].Value, parameters[constraint.Line1.P2.Y].Value);
+                Assert.AreEqual(length, p1.Distance(p2), MaxLengthDelta);
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _AddLinkage(List<Parameter> parameters, List<SolverConstraint> constraints, int segments)
+        {
+            // Chain of segments with equal length and equal internal angles, starting far from the solution
+            var points = new Point[segments + 1];
+            for (int i = 0; i <= segments; i++)
+            {
+                points[i].X = parameters.Count;
+                parameters.Add(new Parameter { Value = i * 10.0 + Math.Sin(i * 7.3) * 1.5 });
+                points[i].Y = parameters.Count;
+                parameters.Add(new Parameter { Value = Math.Sin(i * 1.9) * 5.0 + Math.Cos(i * 3.1) * 1.5 });
+            }
+
+            var length = parameters.Count;
+            parameters.Add(new Parameter { Value = 10.0, Usage = Usage.Constant });
+            var angle = parameters.Count;
+            parameters.Add(new Parameter { Value = 2.0, Usage = Usage.Constant });
+
+            var horizontal = new SolverConstraint { Type = ConstraintType.Horizontal };
+            horizontal.Line1.P1 = points[0];
+            horizontal.Line1.P2 = points[1];
+            constraints.Add(horizontal);
+
+            for (int i = 0; i < segments; i++)
+            {
+                var constraint = new SolverConstraint { Type = ConstraintType.LineLength, Parameter = length };
+                constraint.Line1.P1 = points[i];
+                constraint.Line1.P2 = points[i + 1];
+                constraints.Add(constraint);
+
+                if (i + 1 < segments)
+                {
+                    constraint = new SolverConstraint { Type = ConstraintType.InternalAngle, Parameter = angle };
+                    constraint.Line1.P1 = points[i];
+                    constraint.Line1.P2 = points[i + 1];
+                    constraint.Line2.P1 = points[i + 1];
+                    constraint.Line2.P2 = points[i + 2];
+                    constraints.Add(constraint);
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        Sketch _CreateRectangleSketch(out int[] segments)
+        {
+            var sketch = Sketch.Create();
+            var p1 = sketch.AddPoint(new Pnt2d(0, 0));
+            var p2 = sketch.AddPoint(new Pnt2d(10.1, -0.2));
+            var p3 = sketch.AddPoint(new Pnt2d(9.8, 5.1));
+            var p4 = sketch.AddPoint(new Pnt2d(-0.1, 4.9));
+            segments = new[]
+            {
+                sketch.AddSegment(new SketchSegmentLine(p1, p2)),
+                sketch.AddSegment(new SketchSegmentLine(p2, p3)),
+                sketch.AddSegment(new SketchSegmentLine(p3, p4)),
+                sketch.AddSegment(new SketchSegmentLine(p4, p1))
+            };
+            sketch.AddConstraint(new SketchConstraintHorizontal(segments[0]));
+            sketch.AddConstraint(new SketchConstraintVertical(segments[1]));
+            sketch.AddConstraint(new SketchConstraintHorizontal(segments[2]));
+            sketch.AddConstraint(new SketchConstraintVertical(segments[3]));
+            sketch.AddConstraint(new SketchConstraintLength(segments[0], 10.0));
+            return sketch;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _AddRectangle(List<Parameter> parameters, List<SolverConstraint> constraints, double x, double y)
+        {
+            var corners = new[] { new Pnt2d(x, y), new Pnt2d(x + 10.1, y - 0.2), new Pnt2d(x + 9.8, y + 5.1), new Pnt2d(x - 0.1, y + 4.9) };
+            var points = new Point[4];
+            for (int i = 0; i < 4; i++)
+            {
+                points[i].X = parameters.Count;
+                parameters.Add(new Parameter { Value = corners[i].X });
+                points[i].Y = parameters.Count;
+                parameters.Add(new Parameter { Value = corners[i].Y });
+            }
+
+            for (int i = 0; i < 4; i++)
+            {
+                var constraint = new SolverConstraint { Type = i % 2 == 0 ? ConstraintType.Horizontal : ConstraintType.Vertical };
+                constraint.Line1.P1 = points[i];
+                constraint.Line1.P2 = points[(i + 1) % 4];
+                constraints.Add(constraint);
+            }
+
+            var length = new SolverConstraint { Type = ConstraintType.LineLength, Parameter = parameters.Count };
+            parameters.Add(new Parameter { Value = 10.0, Usage = Usage.Constant });
+            length.Line1.P1 = points[0];
+            length.Line1.P2 = points[1];
+            constraints.Add(length);
+        }
+    }
+}
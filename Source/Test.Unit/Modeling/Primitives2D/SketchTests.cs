@@ -111,6 +111,108 @@ namespace Macad.Test.Unit.Modeling.Primitives2D
             Assert.AreEqual(1, sketch.GetBRep().Wires().Count);
         }
 
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void ManySegmentsInSeparateWires()
+        {
+            var sketch = Sketch.Create();
+            var sb = new SketchBuilder(sketch);
+            for (int path = 0; path < 10; path++)
+            {
+                sb.StartPath(0, path * 10);
+                for (int i = 1; i <= 500; i++)
+                {
+                    sb.LineTo(i, path * 10 + (i % 2));
+                }
+            }
+            sb.Circle(-50, 0, 5);
+
+            Assert.IsTrue(sketch.Make(Shape.MakeFlags.None));
+            var wires = sketch.GetBRep().Wires();
+            Assert.AreEqual(11, wires.Count);
+            Assert.AreEqual(10, wires.Count(wire => wire.Edges().Count == 500));
+            Assert.AreEqual(5001, sketch.GetBRep().Edges().Count);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void IncrementalRebuild()
+        {
+            var sketch = Sketch.Create();
+            var sb = new SketchBuilder(sketch);
+            for (int path = 0; path < 3; path++)
+            {
+                sb.StartPath(0, path * 10);
+                for (int i = 1; i <= 100; i++)
+                {
+                    sb.LineTo(i, path * 10);
+                }
+            }
+            Assert.IsTrue(sketch.Make(Shape.MakeFlags.None));
+            var oldWires = sketch.GetBRep().Wires();
+            var oldEdges = sketch.GetBRep().Edges();
+            Assert.AreEqual(3, oldWires.Count);
+
+            // Move one point in the middle of the second path
+            var movedPoint = sketch.Segments[150].EndPoint;
+            sketch.SetPoint(movedPoint, sketch.Points[movedPoint] + new Vec2d(0, 1));
+            Assert.IsTrue(sketch.Make(Shape.MakeFlags.None));
+            var newWires = sketch.GetBRep().Wires();
+            var newEdges = sketch.GetBRep().Edges();
+
+            // Only the two adjacent edges and the wire containing them are rebuilt
+            Assert.AreEqual(3, newWires.Count);
+            Assert.AreEqual(300, newEdges.Count);
+            Assert.AreEqual(298, newEdges.Count(edge => oldEdges.Any(oldEdge => oldEdge.IsSame(edge))));
+            Assert.IsTrue(oldWires[0].IsSame(newWires[0]));
+            Assert.IsFalse(oldWires[1].IsSame(newWires[1]));
+            Assert.IsTrue(oldWires[2].IsSame(newWires[2]));
+
+            // Connect the first and second path
+            sketch.MergePoints(sketch.Segments[99].EndPoint, sketch.Segments[100].StartPoint);
+            Assert.IsTrue(sketch.Make(Shape.MakeFlags.None));
+            Assert.AreEqual(2, sketch.GetBRep().Wires().Count);
+            Assert.AreEqual(300, sketch.GetBRep().Edges().Count);
+
+            // Remove one segment from the third path, which then splits into two wires
+            sketch.DeleteSegment(sketch.Segments[250]);
+            Assert.IsTrue(sketch.Make(Shape.MakeFlags.None));
+            Assert.AreEqual(3, sketch.GetBRep().Wires().Count);
+            Assert.AreEqual(299, sketch.GetBRep().Edges().Count);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void PointIndex()
+        {
+            var sketch = Sketch.Create();
+            var sb = new SketchBuilder(sketch);
+            sb.Line(0, 0, 10, 0);
+            sb.Line(10, 0, 10, 10);
+
+            Assert.AreEqual(sketch.Points.Count, sketch.PointIndex.Count);
+            Assert.IsTrue(sketch.PointIndex.FindNearest(new Pnt2d(9, 9), 2.0, out var nearest, out var distance));
+            Assert.AreEqual(new Pnt2d(10, 10), sketch.Points[nearest]);
+            Assert.AreEqual(1.414, distance, 0.001);
+            Assert.IsFalse(sketch.PointIndex.FindNearest(new Pnt2d(5, 5), 2.0, out _, out _));
+
+            // Incremental updates
+            sketch.SetPoint(nearest, new Pnt2d(5, 6));
+            Assert.IsTrue(sketch.PointIndex.FindNearest(new Pnt2d(5, 5), 2.0, out var moved, out _));
+            Assert.AreEqual(nearest, moved);
+
+            var added = sketch.AddPoint(new Pnt2d(5, 4.5));
+            Assert.AreEqual(added, sketch.PointIndex.FindNearest(new Pnt2d(5, 5), 2.0, out var addedFound, out _) ? addedFound : -1);
+            CollectionAssert.AreEquivalent(new[] { added, moved }, sketch.PointIndex.FindInRadius(new Pnt2d(5, 5), 2.0));
+
+            sketch.MergePoints(1, 2);
+            Assert.AreEqual(sketch.Points.Count, sketch.PointIndex.Count);
+            Assert.IsFalse(sketch.PointIndex.FindInRadius(new Pnt2d(10, 0), 0.1).Contains(1));
+        }
+
         //--------------------------------------------------------------------------------------------------
         //--------------------------------------------------------------------------------------------------
 
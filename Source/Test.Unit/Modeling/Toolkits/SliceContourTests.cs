@@ -101,6 +101,27 @@ namespace Macad.Test.Unit.Modeling.Toolkits
 
         //--------------------------------------------------------------------------------------------------
 
+        [Test]
+        public void SliceAllPlanesAtOnce()
+        {
+            var body = TestData.GetBodyFromBRep(Path.Combine(_BasePath, "FindCorrectHeight_Source.brep"));
+
+            var template = new SliceContourComponent
+            {
+                Owner = body,
+                LayerCount = 2,
+                SliceAllPlanesAtOnce = true,
+                ReferenceFace = body.Shape.GetSubshapeReference(SubshapeType.Face, 4)
+            };
+
+            // Same layers as sliced one plane at a time
+            Assert.IsTrue(template.Make());
+            AssertHelper.IsSameModel(template.Layers[0].BRep, Path.Combine(_BasePath, "FindCorrectHeight1"));
+            AssertHelper.IsSameModel(template.Layers[1].BRep, Path.Combine(_BasePath, "FindCorrectHeight2"));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         [Test]
         public void ShapeId()
         {
@@ -1,7 +1,10 @@
-﻿using System.Drawing;
+﻿using System.Collections.Generic;
+using System.Drawing;
 using System.IO;
+using System.Linq;
 using Macad.Test.Utils;
 using Macad.Core;
+using Macad.Core.Shapes;
 using Macad.Occt;
 using NUnit.Framework;
 
@@ -128,5 +131,437 @@ namespace Macad.Test.Unit.Wrapper
             Messages.Report(report);
             Assert.AreEqual(initialCount + 2, Context.Current.MessageHandler.MessageItems.Count);
         }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void DistinctSubshapes()
+        {
+            var shape = new Box
+            {
+                DimensionX = 10,
+                DimensionY = 5,
+                DimensionZ = 2
+            };
+            Assert.IsTrue(shape.Make(Shape.MakeFlags.None));
+            var box = shape.GetBRep();
+
+            Assert.AreEqual(6, box.Faces().Count);
+            Assert.AreEqual(12, box.Edges().Count);
+            Assert.AreEqual(24, box.Edges(false).Count);
+            Assert.AreEqual(8, box.Vertices().Count);
+            Assert.AreEqual(1, box.Shells().Count);
+            Assert.AreEqual(1, box.Solids().Count);
+
+            // Every edge is used forward by one face and reversed by the other
+            var edges = box.Edges();
+            Assert.That(edges.All(edge => edge.Orientation() == TopAbs_Orientation.TopAbs_FORWARD));
+
+            // Explorer order of the first occurrence is kept
+            var firstEdges = new List<TopoDS_Edge>();
+            foreach (var edge in box.Edges(false))
+            {
+                if (!firstEdges.Any(other => other.IsSame(edge)))
+                    firstEdges.Add(edge);
+            }
+            Assert.AreEqual(firstEdges.Count, edges.Count);
+            for (int i = 0; i < edges.Count; i++)
+            {
+                Assert.IsTrue(edges[i].IsSame(firstEdges[i]));
+            }
+
+            // Same shape and location twice is counted once, a moved copy is distinct
+            var builder = new BRep_Builder();
+            var compound = new TopoDS_Compound();
+            builder.MakeCompound(compound);
+            builder.Add(compound, box);
+            builder.Add(compound, box);
+            builder.Add(compound, box.Moved(new TopLoc_Location(new Trsf(new Vec(20, 0, 0)))));
+            Assert.AreEqual(12, compound.Faces().Count);
+            Assert.AreEqual(2, compound.Solids().Count);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void TopologyIndex()
+        {
+            var shape = new Box
+            {
+                DimensionX = 10,
+                DimensionY = 5,
+                DimensionZ = 2
+            };
+            Assert.IsTrue(shape.Make(Shape.MakeFlags.None));
+            var box = shape.GetBRep();
+
+            var index = Macad.Occt.Helper.TopologyIndex.Get(box);
+            Assert.AreSame(index, Macad.Occt.Helper.TopologyIndex.Get(box));
+            Assert.AreSame(index, Macad.Occt.Helper.TopologyIndex.Get(box.Oriented(box.Orientation())));
+            Assert.AreNotSame(index, Macad.Occt.Helper.TopologyIndex.Get(box.Reversed()));
+            Assert.AreSame(index.Face(0), index.Face(0));
+            Assert.AreEqual(6, index.FaceCount);
+            Assert.AreEqual(12, index.EdgeCount);
+            Assert.AreEqual(8, index.VertexCount);
+
+            // Indices are the same as those of the distinct subshape lists
+            var faces = box.Faces();
+            for (int i = 0; i < faces.Count; i++)
+            {
+                Assert.AreEqual(i, index.IndexOfFace(faces[i]));
+                Assert.AreEqual(4, index.FaceEdgeCount(i));
+                Assert.AreEqual(4, index.FaceNeighborCount(i));
+            }
+            for (int i = 0; i < index.EdgeCount; i++)
+            {
+                Assert.AreEqual(2, index.EdgeFaceCount(i));
+            }
+            for (int i = 0; i < index.VertexCount; i++)
+            {
+                Assert.AreEqual(3, index.VertexEdgeCount(i));
+            }
+
+            // Neighbors share the reported edge
+            var neighbor = index.FaceNeighbor(0, 0);
+            var sharedEdge = index.FaceNeighborEdge(0, 0);
+            Assert.That(Enumerable.Range(0, 4).Any(i => index.FaceEdge(neighbor, i) == sharedEdge));
+            Assert.That(Enumerable.Range(0, 4).Any(i => index.FaceEdge(0, i) == sharedEdge));
+
+            // Faces of a moved copy are not part of the shape
+            var moved = box.Moved(new TopLoc_Location(new Trsf(new Vec(20, 0, 0))));
+            Assert.AreEqual(-1, index.IndexOfFace(moved.Faces()[0]));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void TopologyIndexSeamEdge()
+        {
+            var shape = new Cylinder
+            {
+                Radius = 5,
+                Height = 10
+            };
+            Assert.IsTrue(shape.Make(Shape.MakeFlags.None));
+            var cylinder = shape.GetBRep();
+
+            // The seam edge lists the lateral face once per occurrence
+            var index = Macad.Occt.Helper.TopologyIndex.Get(cylinder);
+            var analysis = new ShapeAnalysis_Edge();
+            var lateral = cylinder.Faces().First(face => face.Edges().Count == 3);
+            var seam = lateral.Edges().First(edge => analysis.IsSeam(edge, lateral));
+            var seamIndex = index.IndexOfEdge(seam);
+            Assert.AreEqual(2, index.EdgeFaceCount(seamIndex));
+            Assert.AreEqual(index.EdgeFace(seamIndex, 0), index.EdgeFace(seamIndex, 1));
+
+            var (face1, face2) = Macad.Core.Geom.EdgeAlgo.FindAdjacentFaces(cylinder, seam);
+            Assert.IsNotNull(face2);
+            Assert.IsTrue(face1.IsSame(face2));
+            Assert.IsNull(Macad.Core.Geom.FaceAlgo.FindConnectedFace(cylinder, face1, seam));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void ShapeHistory()
+        {
+            var boxShape = new Box { DimensionX = 10, DimensionY = 10, DimensionZ = 10 };
+            Assert.IsTrue(boxShape.Make(Shape.MakeFlags.None));
+            var cylinderShape = new Cylinder { Radius = 2, Height = 20 };
+            Assert.IsTrue(cylinderShape.Make(Shape.MakeFlags.None));
+            var box = boxShape.GetBRep();
+            var cylinder = cylinderShape.GetBRep().Moved(new TopLoc_Location(new Trsf(new Vec(5, 5, -5))));
+
+            var arguments = new TopTools_ListOfShape();
+            arguments.Append(box);
+            var tools = new TopTools_ListOfShape();
+            tools.Append(cylinder);
+            var cut = new BRepAlgoAPI_Cut();
+            cut.SetArguments(arguments);
+            cut.SetTools(tools);
+            cut.Build();
+            Assert.IsTrue(cut.IsDone());
+
+            using var history = Macad.Occt.Helper.ShapeHistory.Collect(cut, new[] { box, cylinder });
+
+            // Inputs are the distinct faces, edges and vertices of all sources
+            var inputs = new List<TopoDS_Shape>();
+            foreach (var source in new[] { box, cylinder })
+            {
+                inputs.AddRange(source.Faces());
+                inputs.AddRange(source.Edges());
+                inputs.AddRange(source.Vertices());
+            }
+            Assert.AreEqual(inputs.Count, history.InputCount);
+            Assert.AreEqual(inputs.Count + 1, history.ModifiedStart.Length);
+            Assert.AreEqual(inputs.Count + 1, history.GeneratedStart.Length);
+
+            // Same result as querying the builder for every subshape
+            var deleted = new HashSet<int>(history.Deleted);
+            for (int input = 0; input < inputs.Count; input++)
+            {
+                Assert.That(history.Input(input).IsEqual(inputs[input]));
+
+                var modified = cut.Modified(inputs[input]).ToList();
+                Assert.AreEqual(modified.Count, history.ModifiedStart[input + 1] - history.ModifiedStart[input]);
+                for (int i = 0; i < modified.Count; i++)
+                {
+                    var result = history.Result(history.Modified[history.ModifiedStart[input] + i]);
+                    Assert.That(result.IsEqual(modified[i]));
+                }
+
+                if (modified.Count == 0)
+                {
+                    Assert.AreEqual(cut.IsDeleted(inputs[input]), deleted.Contains(input));
+                }
+                else
+                {
+                    Assert.AreEqual(cut.Generated(inputs[input]).Size(), history.GeneratedStart[input + 1] - history.GeneratedStart[input]);
+                }
+            }
+
+            // The top face of the box gets a hole, the caps of the cylinder are outside
+            Assert.That(history.ModifiedStart[inputs.Count] > 0);
+            Assert.That(history.Deleted.Length > 0);
+            Assert.AreSame(history.Result(0), history.Result(0));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void DrawingPaths()
+        {
+            var face = new BRepBuilderAPI_MakeFace(new Pln(Ax3.XOY), 0, 10, 0, 5).Face();
+            using var facePaths = Macad.Occt.Helper.DrawingPaths.Build(face, 0.0001);
+            Assert.AreEqual(1, facePaths.LoopCount);
+            Assert.AreEqual(1, facePaths.ChainCount);
+            Assert.IsTrue(facePaths.ChainIsOrdered[0]);
+            Assert.AreEqual(4, facePaths.CurveCount);
+            Assert.That(facePaths.CurveTypes.All(type => type == Macad.Occt.Helper.DrawingCurveType.Line));
+
+            // The lines are chained end to start
+            var data = facePaths.CurveData;
+            const int stride = Macad.Occt.Helper.DrawingPaths.DataStride;
+            for (int i = 0; i < 4; i++)
+            {
+                int next = (i + 1) % 4;
+                var end = facePaths.CurveReversed[i]
+                              ? new Pnt2d(data[i * stride + 2], data[i * stride + 3])
+                              : new Pnt2d(data[i * stride + 4], data[i * stride + 5]);
+                var start = facePaths.CurveReversed[next]
+                                ? new Pnt2d(data[next * stride + 4], data[next * stride + 5])
+                                : new Pnt2d(data[next * stride + 2], data[next * stride + 3]);
+                Assert.That(end.Distance(start) < 0.0001);
+            }
+
+            // Shapes without faces use the curves of the edges
+            var circleEdge = new BRepBuilderAPI_MakeEdge2d(new Geom2d_Circle(new Ax2d(new Pnt2d(1, 2), Dir2d.DX), 3)).Edge();
+            using var edgePaths = Macad.Occt.Helper.DrawingPaths.Build(circleEdge, 0.0001);
+            Assert.AreEqual(1, edgePaths.CurveCount);
+            Assert.AreEqual(Macad.Occt.Helper.DrawingCurveType.Circle, edgePaths.CurveTypes[0]);
+            Assert.AreEqual(1.0, edgePaths.CurveData[2], 1e-9);
+            Assert.AreEqual(2.0, edgePaths.CurveData[3], 1e-9);
+            Assert.AreEqual(3.0, edgePaths.CurveData[4], 1e-9);
+            Assert.IsInstanceOf<Geom2d_Circle>(edgePaths.Curve(0));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void HlrEdgeOptimizer()
+        {
+            var builder = new BRep_Builder();
+            var compound = new TopoDS_Compound();
+            builder.MakeCompound(compound);
+
+            // Three pieces of one line, one of them reversed, and a duplicate
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(0, 0), new Pnt2d(1, 0)).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(2, 0), new Pnt2d(1, 0)).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(2, 0), new Pnt2d(3, 0)).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(0, 0), new Pnt2d(1, 0)).Edge());
+
+            // Two pieces of one circle
+            var circle = new Geom2d_Circle(new Ax2d(new Pnt2d(10, 0), Dir2d.DX), 5);
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(circle, 0, 1).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(circle, 1, 2).Edge());
+
+            // A separate line
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(0, 20), new Pnt2d(1, 21)).Edge());
+
+            using var optimizer = new Macad.Occt.Helper.HlrEdgeOptimizer(0.0001);
+            var result = optimizer.Optimize(compound);
+            Assert.AreEqual(3, result.Edges().Count);
+            Assert.AreEqual(7, optimizer.InputEdgeCount);
+            Assert.AreEqual(3, optimizer.OutputEdgeCount);
+            Assert.AreEqual(2, optimizer.MergedLineCount);
+            Assert.AreEqual(1, optimizer.MergedArcCount);
+            Assert.AreEqual(1, optimizer.DuplicateCount);
+            Assert.AreEqual(3, optimizer.ChainCount);
+
+            // Merged line spans all pieces
+            var lines = result.Edges().Where(edge => edge.Adaptor().GetGeomType() == GeomAbs_CurveType.GeomAbs_Line).ToArray();
+            Assert.AreEqual(2, lines.Length);
+            var mergedLine = lines.Single(edge => System.Math.Abs(TopExp.FirstVertex(edge).Pnt().Y) < 1e-7);
+            var linePoints = new[] { TopExp.FirstVertex(mergedLine).Pnt(), TopExp.LastVertex(mergedLine).Pnt() }.OrderBy(p => p.X).ToArray();
+            Assert.IsTrue(linePoints[0].IsEqual(new Pnt(0, 0, 0), 1e-7));
+            Assert.IsTrue(linePoints[1].IsEqual(new Pnt(3, 0, 0), 1e-7));
+
+            // Merged arc covers both pieces on the same circle
+            var arc = result.Edges().Single(edge => edge.Adaptor().GetGeomType() == GeomAbs_CurveType.GeomAbs_Circle);
+            var arcAdaptor = arc.Adaptor();
+            Assert.IsTrue(arcAdaptor.Circle().Location().IsEqual(new Pnt(10, 0, 0), 1e-7));
+            Assert.AreEqual(5, arcAdaptor.Circle().Radius(), 1e-7);
+            Assert.AreEqual(0, arcAdaptor.FirstParameter(), 1e-9);
+            Assert.AreEqual(2, arcAdaptor.LastParameter(), 1e-9);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void HlrEdgeOptimizerArcOverPeriod()
+        {
+            var builder = new BRep_Builder();
+            var compound = new TopoDS_Compound();
+            builder.MakeCompound(compound);
+
+            // Two pieces of one circle, meeting at the start of its parameter range
+            var circle = new Geom2d_Circle(new Ax2d(new Pnt2d(10, 0), Dir2d.DX), 5);
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(circle, 5.5, 2 * System.Math.PI).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(circle, 0, 1).Edge());
+
+            using var optimizer = new Macad.Occt.Helper.HlrEdgeOptimizer(0.0001);
+            var result = optimizer.Optimize(compound);
+            Assert.AreEqual(1, optimizer.OutputEdgeCount);
+            Assert.AreEqual(1, optimizer.MergedArcCount);
+            Assert.AreEqual(0, optimizer.DuplicateCount);
+
+            // The merged arc continues past 2*PI
+            var arcAdaptor = result.Edges().Single().Adaptor();
+            Assert.AreEqual(GeomAbs_CurveType.GeomAbs_Circle, arcAdaptor.GetGeomType());
+            Assert.IsTrue(arcAdaptor.Circle().Location().IsEqual(new Pnt(10, 0, 0), 1e-7));
+            Assert.AreEqual(5.5, arcAdaptor.FirstParameter(), 1e-9);
+            Assert.AreEqual(2 * System.Math.PI + 1, arcAdaptor.LastParameter(), 1e-9);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void HlrEdgeOptimizerChainOrientation()
+        {
+            var builder = new BRep_Builder();
+            var compound = new TopoDS_Compound();
+            builder.MakeCompound(compound);
+
+            // Open chain, every second edge points against the others
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(0, 0), new Pnt2d(4, 0)).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(4, 3), new Pnt2d(4, 0)).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(4, 3), new Pnt2d(0, 3)).Edge());
+            builder.Add(compound, new BRepBuilderAPI_MakeEdge2d(new Pnt2d(0, 5), new Pnt2d(0, 3)).Edge());
+
+            using var optimizer = new Macad.Occt.Helper.HlrEdgeOptimizer(0.0001);
+            var result = optimizer.Optimize(compound);
+            Assert.AreEqual(1, optimizer.ChainCount);
+
+            // Each edge starts where the previous one ends
+            var edges = result.Edges(false);
+            Assert.AreEqual(4, edges.Count);
+            for (int i = 1; i < edges.Count; i++)
+            {
+                var previousEnd = TopExp.LastVertex(edges[i - 1], true).Pnt();
+                var start = TopExp.FirstVertex(edges[i], true).Pnt();
+                Assert.IsTrue(previousEnd.IsEqual(start, 1e-7), $"Edge {i} is not oriented along the chain.");
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void PointIndex2d()
+        {
+            var random = new System.Random(42);
+            var points = new Dictionary<int, Pnt2d>();
+            for (int i = 0; i < 10000; i++)
+            {
+                points.Add(i, new Pnt2d(random.NextDouble() * 1000, random.NextDouble() * 1000));
+            }
+            var index = new Occt.Helper.PointIndex2d();
+            index.Build(points);
+
+            for (int i = 0; i < 2000; i++)
+            {
+                // Move, add or remove some points
+                var key = random.Next(12000);
+                if (i % 3 == 0 && points.Remove(key))
+                {
+                    Assert.IsTrue(index.Remove(key));
+                }
+                else
+                {
+                    points[key] = new Pnt2d(random.NextDouble() * 1000, random.NextDouble() * 1000);
+                    index.Set(key, points[key]);
+                }
+                Assert.AreEqual(points.Count, index.Count);
+
+                // Compare with linear search
+                var query = new Pnt2d(random.NextDouble() * 1000, random.NextDouble() * 1000);
+                var expected = points.OrderBy(kvp => kvp.Value.Distance(query)).First();
+                Assert.IsTrue(index.FindNearest(query, double.MaxValue, out var nearest, out var distance));
+                Assert.AreEqual(expected.Key, nearest);
+                Assert.AreEqual(expected.Value.Distance(query), distance, 1e-9);
+
+                if (i % 100 == 0)
+                {
+                    var inRadius = points.Where(kvp => kvp.Value.Distance(query) < 25.0).Select(kvp => kvp.Key);
+                    CollectionAssert.AreEquivalent(inRadius, index.FindInRadius(query, 25.0));
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void SnapIndex()
+        {
+            var box = new BRepPrimAPI_MakeBox(10, 10, 10).Shape();
+            var cylinder = new BRepPrimAPI_MakeCylinder(new Ax2(new Pnt(50, 0, 0), Dir.DZ), 10, 10).Shape();
+            var index = new Occt.Helper.SnapIndex();
+            index.Update(new[] { box, cylinder });
+            Assert.AreEqual(2, index.ShapeCount);
+
+            // Vertex
+            var diagonal = new Dir(1, 2, 3);
+            Assert.IsTrue(index.FindNearest(new Ax1(new Pnt(10.1, 9.9, 10), diagonal), 0.5, Occt.Helper.SnapIndexTargets.All, out var point, out var target));
+            Assert.AreEqual(Occt.Helper.SnapIndexTargets.Vertex, target);
+            Assert.That(point.IsEqual(new Pnt(10, 10, 10), 1e-9));
+
+            // Edge midpoint
+            Assert.IsTrue(index.FindNearest(new Ax1(new Pnt(5.1, -5, 10.05), Dir.DY), 0.5, Occt.Helper.SnapIndexTargets.All, out point, out target));
+            Assert.AreEqual(Occt.Helper.SnapIndexTargets.EdgeMidpoint, target);
+            Assert.AreEqual(5.0, point.X, 1e-9);
+            Assert.AreEqual(10.0, point.Z, 1e-9);
+
+            // Edge, the point must be exactly on the circle, not on its polyline
+            var onCircle = new Pnt(50 + 10 * System.Math.Cos(1.0), 10 * System.Math.Sin(1.0), 0);
+            Assert.IsTrue(index.FindNearest(new Ax1(onCircle.Translated(new Vec(0.05, 0, 0)), Dir.DZ), 0.5, Occt.Helper.SnapIndexTargets.Edge, out point, out target));
+            Assert.AreEqual(Occt.Helper.SnapIndexTargets.Edge, target);
+            Assert.AreEqual(10.0, point.Distance(new Pnt(50, 0, point.Z)), 1e-7);
+            Assert.AreEqual(onCircle.X + 0.05, point.X, 0.05);
+
+            // Nothing within tolerance, or the target is filtered out
+            Assert.IsFalse(index.FindNearest(new Ax1(new Pnt(25, 25, 0), Dir.DZ), 0.5, Occt.Helper.SnapIndexTargets.All, out _, out _));
+            Assert.IsTrue(index.FindNearest(new Ax1(new Pnt(10.1, 9.9, 10), diagonal), 0.5, Occt.Helper.SnapIndexTargets.Edge, out _, out target));
+            Assert.AreEqual(Occt.Helper.SnapIndexTargets.Edge, target);
+
+            // Moved body replaces the old one
+            var movedBox = new BRepBuilderAPI_Transform(box, new Trsf(new Vec(0, 0, 100))).Shape();
+            index.Update(new[] { movedBox, cylinder });
+            Assert.AreEqual(2, index.ShapeCount);
+            Assert.IsFalse(index.FindNearest(new Ax1(new Pnt(10.1, 9.9, 10), diagonal), 0.5, Occt.Helper.SnapIndexTargets.Vertex, out _, out _));
+            Assert.IsTrue(index.FindNearest(new Ax1(new Pnt(10.1, 9.9, 110), diagonal), 0.5, Occt.Helper.SnapIndexTargets.Vertex, out point, out _));
+            Assert.That(point.IsEqual(new Pnt(10, 10, 110), 1e-9));
+
+            index.Update(new TopoDS_Shape[0]);
+            Assert.AreEqual(0, index.ShapeCount);
+        }
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿using System.Linq;
+using Macad.Common;
 using Macad.Test.Utils;
 using Macad.Core;
 using Macad.Core.Geom;
@@ -72,5 +73,212 @@ namespace Macad.Test.Unit.Wrapper
 
         //--------------------------------------------------------------------------------------------------
 
+        [Test]
+        public void ArrayMarshalling()
+        {
+            var points = new[] { new Pnt(1, 2, 3), new Pnt(4, 5, 6), new Pnt(7, 8, 9) };
+            var array = new TColgp_Array1OfPnt(points);
+            Assert.AreEqual(1, array.Lower());
+            Assert.AreEqual(3, array.Upper());
+            Assert.AreEqual(points[1], array.Value(2));
+            Assert.AreEqual(points, array.ToArray());
+
+            // Ranges
+            var partial = new TColgp_Array1OfPnt(points, 1, 2);
+            Assert.AreEqual(2, partial.Length());
+            Assert.AreEqual(points[1], partial.Value(1));
+            partial.SetValues(2, points, 0, 1);
+            Assert.AreEqual(points[0], partial.Value(2));
+            var target = new Pnt[4];
+            array.CopyTo(2, target, 1, 2);
+            Assert.AreEqual(points[1], target[1]);
+            Assert.AreEqual(points[2], target[2]);
+            Assert.Throws<System.ArgumentOutOfRangeException>(() => partial.SetValues(1, points));
+            Assert.Throws<System.ArgumentOutOfRangeException>(() => array.CopyTo(1, target, 3, 2));
+            Assert.Throws<System.ArgumentOutOfRangeException>(() => array.CopyTo(3, target, 0, 2));
+
+            // Empty ranges
+            var empty = new TColStd_Array1OfReal(new double[0]);
+            Assert.AreEqual(0, empty.Length());
+            Assert.IsEmpty(empty.ToArray());
+            Assert.AreEqual(0, new TColgp_HArray1OfPnt(points, 1, 0).Array1().Length());
+
+            var points2d = new[] { new Pnt2d(1, 2), new Pnt2d(3, 4) };
+            Assert.AreEqual(points2d, new TColgp_Array1OfPnt2d(points2d).ToArray());
+            Assert.AreEqual(points2d, new TColgp_HArray1OfPnt2d(points2d).ToArray());
+            Assert.AreEqual(points, new TColgp_HArray1OfPnt(points).Array1().ToArray());
+
+            var reals = new[] { 0.5, 1.5, 2.5 };
+            Assert.AreEqual(reals, new TColStd_Array1OfReal(reals).ToArray());
+            var ints = new[] { 3, 1, 2 };
+            var intArray = new TColStd_Array1OfInteger(1, 3);
+            intArray.SetValues(1, ints);
+            Assert.AreEqual(1, intArray.Value(2));
+            Assert.AreEqual(ints, intArray.ToArray());
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        [TestCase(false)]
+        [TestCase(true)]
+        public void BatchEvaluation(bool parallel)
+        {
+            const int count = 10000;
+            var parameters = Enumerable.Range(0, count).Select(i => i * Maths.DoublePI / count).ToArray();
+            var uvs = parameters.Select(u => new Pnt2d(u, u * 0.1)).ToArray();
+            var points = new Pnt[count];
+            var tangents = new Vec[count];
+            var tangentsV = new Vec[count];
+
+            // Geom curve
+            var curve = new Geom_Circle(Ax2.XOY, 10);
+            curve.D1Batch(parameters, points, tangents, parallel);
+            for (int i = 0; i < count; i += 97)
+            {
+                Pnt p = default;
+                Vec v = default;
+                curve.D1(parameters[i], ref p, ref v);
+                Assert.AreEqual(0, p.Distance(points[i]), 1e-9);
+                Assert.AreEqual(0, (v - tangents[i]).Magnitude(), 1e-9);
+            }
+
+            // Geom surface
+            var surface = new Geom_CylindricalSurface(Ax3.XOY, 5);
+            surface.D1Batch(uvs, points, tangents, tangentsV, parallel);
+            for (int i = 0; i < count; i += 97)
+            {
+                Pnt p = default;
+                Vec du = default, dv = default;
+                surface.D1(uvs[i].X, uvs[i].Y, ref p, ref du, ref dv);
+                Assert.AreEqual(0, p.Distance(points[i]), 1e-9);
+                Assert.AreEqual(0, (du - tangents[i]).Magnitude(), 1e-9);
+                Assert.AreEqual(0, (dv - tangentsV[i]).Magnitude(), 1e-9);
+            }
+
+            // Geom2d curve
+            var curve2d = new Geom2d_Circle(Ax2d.OX, 3);
+            var points2d = new Pnt2d[count];
+            curve2d.D0Batch(parameters, points2d, parallel);
+            for (int i = 0; i < count; i += 97)
+            {
+                Assert.AreEqual(0, curve2d.Value(parameters[i]).Distance(points2d[i]), 1e-9);
+            }
+
+            // BRep adaptors
+            var box = TestGeomGenerator.CreateBox().GetBRep();
+            var edgeAdaptor = new BRepAdaptor_Curve(box.Edges()[0]);
+            var edgeParameters = parameters.Select(u => edgeAdaptor.FirstParameter().Lerp(edgeAdaptor.LastParameter(), u / Maths.DoublePI)).ToArray();
+            edgeAdaptor.D0Batch(edgeParameters, points, parallel);
+            for (int i = 0; i < count; i += 97)
+            {
+                Assert.AreEqual(0, edgeAdaptor.Value(edgeParameters[i]).Distance(points[i]), 1e-9);
+            }
+
+            var faceAdaptor = new BRepAdaptor_Surface(box.Faces()[0], true);
+            faceAdaptor.D0Batch(uvs, points, parallel);
+            for (int i = 0; i < count; i += 97)
+            {
+                Assert.AreEqual(0, faceAdaptor.Value(uvs[i].X, uvs[i].Y).Distance(points[i]), 1e-9);
+            }
+
+            Assert.Catch(() => curve.D0Batch(parameters, new Pnt[count - 1], parallel));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void FastInterop()
+        {
+            var box = TestGeomGenerator.CreateBox().GetBRep();
+
+            // Results assigned to a caller-provided instance
+            var explorer = new TopExp_Explorer(box, TopAbs_ShapeEnum.TopAbs_FACE, TopAbs_ShapeEnum.TopAbs_SHAPE);
+            var current = new TopoDS_Shape();
+            int faceCount = 0;
+            for (; explorer.More(); explorer.Next())
+            {
+                explorer.Current(current);
+                Assert.IsTrue(current.IsSame(explorer.Current()));
+                faceCount++;
+            }
+            Assert.AreEqual(6, faceCount);
+
+            // Value types returned through out parameters
+            var adaptor = new BRepAdaptor_Curve(box.Edges()[0]);
+            var u = (adaptor.FirstParameter() + adaptor.LastParameter()) * 0.5;
+            adaptor.Value(u, out var point);
+            Assert.AreEqual(0, point.Distance(adaptor.Value(u)), 1e-12);
+            adaptor.DN(u, 1, out var derivative);
+            Assert.AreEqual(0, (derivative - adaptor.DN(u, 1)).Magnitude(), 1e-12);
+
+            // Regular methods always return a new wrapper
+            var face = box.Faces()[0];
+            var ownSurface1 = BRep_Tool.Surface(face);
+            var ownSurface2 = BRep_Tool.Surface(face);
+            Assert.AreNotSame(ownSurface1, ownSurface2);
+            ownSurface1.Dispose();
+            Assert.IsNotNull(ownSurface2.Value(0, 0));
+
+            // Wrappers of handles are reused while alive by the shared variants only
+            var surface1 = BRep_Tool.SurfaceShared(face);
+            var surface2 = BRep_Tool.SurfaceShared(face);
+            Assert.AreSame(surface1, surface2);
+            Assert.IsInstanceOf<Geom_Plane>(surface1);
+            Assert.AreNotSame(surface1, BRep_Tool.Surface(face));
+            surface1.Dispose();
+            var surface3 = BRep_Tool.SurfaceShared(face);
+            Assert.AreNotSame(surface1, surface3);
+            Assert.IsNotNull(surface3.Value(0, 0));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test, Explicit("Benchmark")]
+        public void InteropBenchmark()
+        {
+            const int count = 1000000;
+            var box = TestGeomGenerator.CreateBox().GetBRep();
+            var face = box.Faces()[0];
+            var adaptor = new BRepAdaptor_Curve(box.Edges()[0]);
+            var explorer = new TopExp_Explorer(box, TopAbs_ShapeEnum.TopAbs_FACE, TopAbs_ShapeEnum.TopAbs_SHAPE);
+            var current = new TopoDS_Shape();
+
+            _MeasureCalls("TopExp_Explorer.Current()", count, () => explorer.Current());
+            _MeasureCalls("TopExp_Explorer.Current(result)", count, () => explorer.Current(current));
+            _MeasureCalls("BRepAdaptor_Curve.Value(u)", count, () => adaptor.Value(0.5));
+            _MeasureCalls("BRepAdaptor_Curve.Value(u, out)", count, () => adaptor.Value(0.5, out _));
+            _MeasureCalls("BRep_Tool.Surface(face)", count, () => BRep_Tool.Surface(face));
+            _MeasureCalls("BRep_Tool.SurfaceShared(face)", count, () => BRep_Tool.SurfaceShared(face));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void _MeasureCalls(string name, int count, System.Action call)
+        {
+            // Warm up
+            for (int i = 0; i < 1000; i++)
+            {
+                call();
+            }
+            System.GC.Collect();
+            System.GC.WaitForPendingFinalizers();
+
+            var gen0Count = System.GC.CollectionCount(0);
+            var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+            for (int i = 0; i < count; i++)
+            {
+                call();
+            }
+            stopwatch.Stop();
+            gen0Count = System.GC.CollectionCount(0) - gen0Count;
+
+            var rate = count / stopwatch.Elapsed.TotalSeconds;
+            TestContext.WriteLine($"{name,-36} {rate,14:N0} calls/s {gen0Count,6} gen0 collections");
+            Assert.Greater(rate, 0.0);
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
     }
 }
\ No newline at end of file
@@ -128,5 +128,39 @@ namespace Macad.Test.Unit.Wrapper.ValueTypes2D
             p2.Transform(t1);
             Assert.That(new Pnt2d(2,3).IsEqual(p2, 0.0000001));
         }
+
+        //--------------------------------------------------------------------------------------------------
+
+        [Test]
+        public void TransformArray()
+        {
+            var trsf = new Trsf2d();
+            trsf.SetRotation(new Pnt2d(1, 2), 0.3);
+            trsf.SetScaleFactor(1.5);
+
+            // Uneven count to cover the remainder of vectorized loops
+            var points = new Pnt2d[11];
+            var vectors = new Vec2d[11];
+            var dirs = new Dir2d[11];
+            for (int i = 0; i < points.Length; i++)
+            {
+                points[i] = new Pnt2d(i, Math.Sin(i) * 10);
+                vectors[i] = new Vec2d(1, i);
+                dirs[i] = new Dir2d(1, i);
+            }
+
+            var transformedPoints = (Pnt2d[])points.Clone();
+            Pnt2d.Transform(transformedPoints, trsf);
+            var transformedVectors = new Vec2d[vectors.Length];
+            Vec2d.Transform(vectors, transformedVectors, trsf);
+            var transformedDirs = new Dir2d[dirs.Length];
+            Dir2d.Transform(dirs, transformedDirs, trsf);
+            for (int i = 0; i < points.Length; i++)
+            {
+                Assert.That(points[i].Transformed(trsf).IsEqual(transformedPoints[i], 1e-9));
+                Assert.That(vectors[i].Transformed(trsf).IsEqual(transformedVectors[i], 1e-9, 1e-9));
+                Assert.That(dirs[i].Transformed(trsf).IsEqual(transformedDirs[i], 1e-9));
+            }
+        }
     }
 }
\ No newline at end of file
@@ -153,5 +153,52 @@ namespace Macad.Test.Unit.Wrapper.ValueTypes3D
 
         //--------------------------------------------------------------------------------------------------
 
+        [Test]
+        public void TransformArray()
+        {
+            var trsf = new Trsf(new Ax3(new Pnt(1, 2, 3), new Dir(1, 1, 0), new Dir(0, 0, -1)));
+            trsf.SetScaleFactor(-2.5);
+            var rotation = new Quaternion(new Vec(1, 2, 3), 0.7);
+
+            // Uneven count to cover the remainder of vectorized loops
+            var points = new Pnt[13];
+            var vectors = new Vec[13];
+            var dirs = new Dir[13];
+            for (int i = 0; i < points.Length; i++)
+            {
+                points[i] = new Pnt(i, Math.Sin(i) * 10, -i * 0.5);
+                vectors[i] = new Vec(1, i, Math.Cos(i));
+                dirs[i] = new Dir(1, i, Math.Cos(i));
+            }
+
+            var transformedPoints = new Pnt[points.Length];
+            Pnt.Transform(points, transformedPoints, trsf);
+            var transformedVectors = new Vec[vectors.Length];
+            Vec.Transform(vectors, transformedVectors, trsf);
+            var transformedDirs = new Dir[dirs.Length];
+            Dir.Transform(dirs, transformedDirs, trsf);
+            for (int i = 0; i < points.Length; i++)
+            {
+                Assert.That(points[i].Transformed(trsf).IsEqual(transformedPoints[i], 1e-9));
+                Assert.That(vectors[i].Transformed(trsf).IsEqual(transformedVectors[i], 1e-9, 1e-9));
+                Assert.That(dirs[i].Transformed(trsf).IsEqual(transformedDirs[i], 1e-9));
+            }
+
+            // In place
+            var rotatedPoints = (Pnt[])points.Clone();
+            Pnt.Transform(rotatedPoints, rotation);
+            var rotatedVectors = (Vec[])vectors.Clone();
+            Vec.Transform(rotatedVectors, rotation);
+            for (int i = 0; i < points.Length; i++)
+            {
+                Assert.That(rotation.Multiply(points[i].ToVec()).ToPnt().IsEqual(rotatedPoints[i], 1e-9));
+                Assert.That(rotation.Multiply(vectors[i]).IsEqual(rotatedVectors[i], 1e-9, 1e-9));
+            }
+
+            Assert.Throws<ArgumentException>(() => Pnt.Transform(points, new Pnt[points.Length - 1], trsf));
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
     }
 }
\ No newline at end of file
@@ -68,6 +68,7 @@ namespace Macad.Occt.Generator
 
                     w.Write("\t");
                     GenerateFunctionDeclaration(w, fd, i);
+                    GenerateFastFunctionDeclaration(w, fd, i);
                 }
             }
 
@@ -171,6 +172,7 @@ namespace Macad.Occt.Generator
                         break;
 
                     GenerateFunctionSource(w, fd, i);
+                    GenerateFastFunctionSource(w, fd, i);
                 }
             }
             w.WriteLine();
@@ -101,39 +101,149 @@ namespace Macad.Occt.Generator
 
         //--------------------------------------------------------------------------------------------------
 
-        bool GenerateFunctionPreNativeCall(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
+        Configuration.FastInteropMode GetFastInteropMode(Definitions.ClassDefinition cd)
         {
-            // Prepare parameter list
-            int count = 0;
-            foreach (var pd in fd.Parameters)
+            return Configuration.FastInterop.TryGetValue(cd.Name, out var mode) ? mode : Configuration.FastInteropMode.None;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        Configuration.FastInteropMode GetFastFunctionVariant(Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
+            var mode = GetFastInteropMode(fd.Class);
+            if (mode == Configuration.FastInteropMode.None
+                || fd.IsConstructor || fd.IsDestructor || fd.IsOperator || fd.IsTemplate
+                || fd.Type.IsVoid || fd.Type.IsPointer
+                || Configuration.UnknownTypes.Contains(fd.Type.Name))
             {
-                count++;
-                if (count > maxParameterCount)
-                    break;
+                return Configuration.FastInteropMode.None;
+            }
 
-                if (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.Standard_CString)
+            var ft = string.Join(",", fd.Parameters.Select(pd => pd.Type.Name).ToArray());
+            if (Configuration.MissingExports.Contains($"{fd.Class.Name}::{fd.Name}({ft})"))
+                return Configuration.FastInteropMode.None;
+
+            if (fd.Type.IsHandle)
+            {
+                // Separately named variant, references to handles would re-assign the native instance of shared wrappers
+                if (mode.HasFlag(Configuration.FastInteropMode.ReuseHandles)
+                    && !fd.Parameters.Take(maxParameterCount).Any(pd => pd.Type.IsHandle && pd.Type.IsReference)
+                    && !fd.Class.Functions.Any(ffd => ffd.Name == fd.Name + Configuration.SharedHandleSuffix))
                 {
-                    wf.WriteLine($"\tconst char* sz_{pd.Name} = (char*)(void*)Marshal::StringToHGlobalAnsi({pd.Name});");
+                    return Configuration.FastInteropMode.ReuseHandles;
                 }
-                else if (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.Standard_ExtString)
+                return Configuration.FastInteropMode.None;
+            }
+
+            // The additional result parameter must not make the call ambiguous
+            if (fd.Class.Functions.Any(ffd => ffd.Name == fd.Name 
+                                              && ffd.Parameters.Count >= maxParameterCount + 1 
+                                              && ffd.Parameters.Count - ffd.DefaultParameterCount <= maxParameterCount + 1))
+            {
+                return Configuration.FastInteropMode.None;
+            }
+
+            if (fd.Type.IsValueType(fd.Class))
+            {
+                // Wrapped struct, e.g. Pnt or Trsf
+                if (mode.HasFlag(Configuration.FastInteropMode.OutValues)
+                    && fd.Type.IsKnownType && fd.Type.KnownTypeDef.Type == Definitions.KnownTypes.WrappedStruct)
                 {
-                    wf.WriteLine($"\tpin_ptr<const wchar_t> pp_{pd.Name} = PtrToStringChars({pd.Name});");
+                    return Configuration.FastInteropMode.OutValues;
                 }
-                else if (pd.Type.IsValueType(fd.Class)
-                    // For wrapped struct always, for other value types only if they are given as reference
-                    &&(pd.Type.IsReference || pd.Type.IsPointer || (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.WrappedStruct))
-                    &&!pd.Type.IsVoid)
+            }
+            else if (mode.HasFlag(Configuration.FastInteropMode.IntoResults) && !fd.Type.IsKnownType)
+            {
+                // Wrapped class returned by value, e.g. TopoDS_Shape
+                var klass = Definitions.ClassItems.FirstOrDefault(cd => cd.Name.Equals(fd.Type.Name));
+                if (klass != null && !klass.IsTransient && !klass.IsAbstract && !klass.HasAbstractFunctions)
                 {
-                    wf.WriteLine("\tpin_ptr<{0}> pp_{1} = &{1};",
-                        pd.Type.IsKnownType ? pd.Type.KnownTypeDef.Fqn : pd.Type.Fqn(fd.Class), pd.Name);
+                    return Configuration.FastInteropMode.IntoResults;
                 }
-                else if (pd.Type.IsHandle && pd.Type.IsReference)
+            }
+
+            return Configuration.FastInteropMode.None;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void GenerateFastFunctionDeclaration(StringWriter w, Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
+            var variant = GetFastFunctionVariant(fd, maxParameterCount);
+            if (variant == Configuration.FastInteropMode.None)
+                return;
+
+            StringWriter wf = new StringWriter();
+            if (GenerateFunctionDecl(wf, fd, true, maxParameterCount, variant))
+            {
+                w.Write("\t");
+                w.Write(wf.ToString());
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        void GenerateFastFunctionSource(StringWriter w, Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
+            var variant = GetFastFunctionVariant(fd, maxParameterCount);
+            if (variant == Configuration.FastInteropMode.None)
+                return;
+
+            StringWriter wfd = new StringWriter();
+            if (!GenerateFunctionDecl(wfd, fd, false, maxParameterCount, variant))
+                return;
+
+            if (variant == Configuration.FastInteropMode.ReuseHandles)
+            {
+                // Same call as the regular method, but the existing wrapper of the result is returned
+                StringWriter wh = new StringWriter();
+                if (!GenerateFunctionPreNativeCall(wh, fd, maxParameterCount)
+                    || !GenerateFunctionNativeCall(wh, fd, maxParameterCount)
+                    || !GenerateFunctionPostNativeCall(wh, fd, maxParameterCount, true))
                 {
-                    // References to handles may receive another encapsulated object.
-                    wf.WriteLine($"\t{pd.Type.NativeHandle} h_{pd.Name} = {pd.Name}->NativeInstance;");
+                    return;
                 }
+
+                w.Write(wfd.ToString());
+                w.WriteLine("{");
+                w.Write(wh.ToString());
+                w.WriteLine("}");
+                w.WriteLine();
+                return;
             }
 
+            // The result is written directly to the memory of the result parameter,
+            // no native instance and no managed wrapper is created.
+            StringWriter wf = new StringWriter();
+            GenerateFunctionPreNativeCallParameters(wf, fd, maxParameterCount);
+            if (variant == Configuration.FastInteropMode.OutValues)
+            {
+                wf.WriteLine($"\tpin_ptr<{fd.Type.KnownTypeDef.Fqn}> pp_theResult = &theResult;");
+                wf.Write($"\t*({fd.Type.KnownTypeDef.NativeFqn}*)pp_theResult = ");
+            }
+            else
+            {
+                wf.Write($"\t*({fd.Type.Native(fd.Class)}*)theResult->NativeInstance = ");
+            }
+
+            if (!GenerateFunctionNativeCallTarget(wf, fd, maxParameterCount))
+                return;
+            wf.WriteLine(";");
+            GenerateFunctionPostNativeCallParameters(wf, fd, maxParameterCount);
+
+            w.Write(wfd.ToString());
+            w.WriteLine("{");
+            w.Write(wf.ToString());
+            w.WriteLine("}");
+            w.WriteLine();
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool GenerateFunctionPreNativeCall(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
+            GenerateFunctionPreNativeCallParameters(wf, fd, maxParameterCount);
+
             // Prepare temp return class
             if (!fd.IsConstructor && !fd.Type.IsVoid)
             {
@@ -211,6 +321,42 @@ namespace Macad.Occt.Generator
 
         //--------------------------------------------------------------------------------------------------
 
+        void GenerateFunctionPreNativeCallParameters(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
+            // Prepare parameter list
+            int count = 0;
+            foreach (var pd in fd.Parameters)
+            {
+                count++;
+                if (count > maxParameterCount)
+                    break;
+
+                if (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.Standard_CString)
+                {
+                    wf.WriteLine($"\tconst char* sz_{pd.Name} = (char*)(void*)Marshal::StringToHGlobalAnsi({pd.Name});");
+                }
+                else if (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.Standard_ExtString)
+                {
+                    wf.WriteLine($"\tpin_ptr<const wchar_t> pp_{pd.Name} = PtrToStringChars({pd.Name});");
+                }
+                else if (pd.Type.IsValueType(fd.Class)
+                    // For wrapped struct always, for other value types only if they are given as reference
+                    &&(pd.Type.IsReference || pd.Type.IsPointer || (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.WrappedStruct))
+                    &&!pd.Type.IsVoid)
+                {
+                    wf.WriteLine("\tpin_ptr<{0}> pp_{1} = &{1};",
+                        pd.Type.IsKnownType ? pd.Type.KnownTypeDef.Fqn : pd.Type.Fqn(fd.Class), pd.Name);
+                }
+                else if (pd.Type.IsHandle && pd.Type.IsReference)
+                {
+                    // References to handles may receive another encapsulated object.
+                    wf.WriteLine($"\t{pd.Type.NativeHandle} h_{pd.Name} = {pd.Name}->NativeInstance;");
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
         bool GenerateFunctionNativeCall(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
         {
             if (Configuration.UnknownTypes.Contains(fd.Type.Name))
@@ -218,7 +364,7 @@ namespace Macad.Occt.Generator
 
             wf.Write("\t");
 
-            string closing = ")";
+            string closing = "";
 
             // If the return value is a value type: return xxx 
             if (!fd.IsConstructor && (!fd.Type.IsVoid || fd.Type.IsVoidPointer))
@@ -280,6 +426,21 @@ namespace Macad.Occt.Generator
                 }
             }
 
+            if (!GenerateFunctionNativeCallTarget(wf, fd, maxParameterCount))
+                return false;
+
+            // Close statement
+            wf.Write(closing);
+
+            wf.WriteLine(";");
+
+            return true;
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool GenerateFunctionNativeCallTarget(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
             // Call to static method
             if (fd.IsStatic)
             {
@@ -315,11 +476,8 @@ namespace Macad.Occt.Generator
             if (!GenerateFunctionNativeCallParameters(wf, fd, maxParameterCount))
                 return false;
 
-            // Close function parameter list and close statement
-            wf.Write(closing);
-
-            wf.WriteLine(";");
-
+            // Close function parameter list
+            wf.Write(")");
             return true;
         }
 
@@ -467,26 +625,9 @@ namespace Macad.Occt.Generator
 
         //--------------------------------------------------------------------------------------------------
 
-        bool GenerateFunctionPostNativeCall(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
+        bool GenerateFunctionPostNativeCall(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount, bool reuseHandles = false)
         {
-            // Resolve parameter list
-            int count = 0;
-            foreach (var pd in fd.Parameters)
-            {
-                count++;
-                if (count > maxParameterCount)
-                    break;
-
-                if (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.Standard_CString)
-                {
-                    wf.WriteLine($"\tMarshal::FreeHGlobal((System::IntPtr)(void*)sz_{pd.Name});");
-                }
-                else if (pd.Type.IsHandle && pd.Type.IsReference)
-                {
-                    // References to handles may receive another encapsulated object.
-                    wf.WriteLine($"\t{pd.Name}->NativeInstance = h_{pd.Name}.get();");
-                }
-            }
+            GenerateFunctionPostNativeCallParameters(wf, fd, maxParameterCount);
 
             // Return type
             if ((!fd.Type.IsVoid || fd.Type.IsVoidPointer) && !fd.IsConstructor && !fd.Type.IsValueType(fd.Class))
@@ -507,6 +648,11 @@ namespace Macad.Occt.Generator
                             return false;
                     }
                 }
+                else if (fd.Type.IsHandle && reuseHandles)
+                {
+                    // Handle type, reuse existing wrapper
+                    wf.WriteLine($"\t return _result.IsNull() ? nullptr : Macad::Occt::Internal::GetOrCreateWrapper<{fd.Type.Fqn(fd.Class)}>( _result.get());");
+                }
                 else
                 {
                     // Generic class or handle type
@@ -521,7 +667,31 @@ namespace Macad.Occt.Generator
 
         //--------------------------------------------------------------------------------------------------
 
-        bool GenerateFunctionDecl(StringWriter w, Definitions.FunctionDefintion fd, bool isHeader, int maxParameterCount)
+        void GenerateFunctionPostNativeCallParameters(StringWriter wf, Definitions.FunctionDefintion fd, int maxParameterCount)
+        {
+            // Resolve parameter list
+            int count = 0;
+            foreach (var pd in fd.Parameters)
+            {
+                count++;
+                if (count > maxParameterCount)
+                    break;
+
+                if (pd.Type.IsKnownType && pd.Type.KnownTypeDef.Type == Definitions.KnownTypes.Standard_CString)
+                {
+                    wf.WriteLine($"\tMarshal::FreeHGlobal((System::IntPtr)(void*)sz_{pd.Name});");
+                }
+                else if (pd.Type.IsHandle && pd.Type.IsReference)
+                {
+                    // References to handles may receive another encapsulated object.
+                    wf.WriteLine($"\t{pd.Name}->NativeInstance = h_{pd.Name}.get();");
+                }
+            }
+        }
+
+        //--------------------------------------------------------------------------------------------------
+
+        bool GenerateFunctionDecl(StringWriter w, Definitions.FunctionDefintion fd, bool isHeader, int maxParameterCount, Configuration.FastInteropMode fastVariant = Configuration.FastInteropMode.None)
         {
             if (fd.IsTemplate)
             {
@@ -532,7 +702,9 @@ namespace Macad.Occt.Generator
                 w.Write("static ");
 
             // Write return type, if not constructor
-            if ((!fd.IsConstructor) && (!fd.IsDestructor))
+            if (fastVariant is Configuration.FastInteropMode.OutValues or Configuration.FastInteropMode.IntoResults)
+                w.Write("void ");
+            else if ((!fd.IsConstructor) && (!fd.IsDestructor))
                 if (!GenerateTypeDecl(w, fd.Type, fd.Class, true))
                     return false;
 
@@ -546,6 +718,9 @@ namespace Macad.Occt.Generator
             else
                 w.Write(fd.Name);
 
+            if (fastVariant == Configuration.FastInteropMode.ReuseHandles)
+                w.Write(Configuration.SharedHandleSuffix);
+
             w.Write("(");
 
             // Write all parameters
@@ -577,6 +752,23 @@ namespace Macad.Occt.Generator
                 w.Write(pd.Name);
             }
 
+            // Write result parameter of fast variant
+            if (fastVariant is Configuration.FastInteropMode.OutValues or Configuration.FastInteropMode.IntoResults)
+            {
+                if (!isFirst)
+                    w.Write(", ");
+
+                if (fastVariant == Configuration.FastInteropMode.OutValues)
+                    w.Write("[System::Runtime::InteropServices::Out] ");
+
+                StringWriter wt = new StringWriter();
+                if (!GenerateTypeDecl(wt, fd.Type, fd.Class, true))
+                    return false;
+
+                w.Write(wt.ToString().TrimEnd());
+                w.Write(fastVariant == Configuration.FastInteropMode.OutValues ? "% theResult" : " theResult");
+            }
+
             w.Write(")");
 
             if (isHeader)
@@ -538,6 +538,38 @@ namespace Macad.Occt.Generator
 
         #endregion
 
+        #region Fast Interop
+
+        /*
+         * Opt-in generation of low-overhead call variants, additional to the regular methods.
+         * OutValues:    Methods returning a value type get an overload returning it through an out parameter.
+         * IntoResults:  Methods returning a wrapped class by value get an overload assigning the result
+         *               to a caller-provided instance, so no native object and finalizable wrapper is created.
+         * ReuseHandles: Methods returning a handle get a variant with the suffix 'Shared', returning the
+         *               already existing wrapper of the native instance, if there is one. Callers of the
+         *               variant must not dispose or re-assign returned wrappers. The regular methods
+         *               always return a new wrapper.
+         */
+        [System.Flags]
+        public enum FastInteropMode
+        {
+            None         = 0,
+            OutValues    = 1 << 0,
+            IntoResults  = 1 << 1,
+            ReuseHandles = 1 << 2
+        }
+
+        public static Dictionary<string, FastInteropMode> FastInterop = new()
+        {
+            {"BRep_Tool", FastInteropMode.ReuseHandles},
+            {"BRepAdaptor_Curve", FastInteropMode.OutValues},
+            {"TopExp_Explorer", FastInteropMode.IntoResults},
+        };
+
+        public const string SharedHandleSuffix = "Shared";
+
+        #endregion
+
         #region Name Replacements
 
         public static Dictionary<string, string> NameReplacements = new()